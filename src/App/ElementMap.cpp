@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <unordered_map>
 #ifndef FC_DEBUG
 #include <random>
@@ -42,6 +43,27 @@ namespace Data
 static std::unordered_map<const ElementMap*, unsigned> _elementMapToId;
 static std::unordered_map<unsigned, ElementMapPtr> _idToElementMap;
 
+namespace
+{
+
+// FNV-1a of the name. Unlike MappedName::hash() the result doesn't depend on how the
+// name is split into data and postfix, which is ignored by MappedName::operator==().
+std::uint32_t hashMappedName(const MappedName& name)
+{
+    std::uint32_t hash = 2166136261U;
+    auto feed = [&hash](const QByteArray& bytes) {
+        for (char c : bytes) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 16777619U;
+        }
+    };
+    feed(name.dataBytes());
+    feed(name.postfixBytes());
+    return hash;
+}
+
+}  // namespace
+
 
 void ElementMap::init()
 {
@@ -317,6 +339,7 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
         }
 
         auto& indices = this->indexedNames[idx.getType()];
+        const char* type = this->indexedNames.find(idx.getType())->first;
         for (int j = 0; j < outerCount; ++j) {
             int cIndex = 0;
             int offset = 0;
@@ -445,7 +468,10 @@ ElementMapPtr ElementMap::restore(::App::StringHasherRef hasherRef,
                     }
                 }
 
-                this->mappedNames.emplace(ref->name, idx);
+                auto hash = hashMappedName(ref->name);
+                if (findSlot(ref->name, hash) < 0) {
+                    insertSlot(hash, type, j);
+                }
 
                 if (!hasherRef) {
                     if (offset + 1 < (int)tokens.size()) {
@@ -512,25 +538,30 @@ MappedName ElementMap::addName(MappedName& name,
         if (overwrite) {
             erase(idx);
         }
-        auto ret = mappedNames.insert(std::make_pair(name, idx));
-        if (ret.second) {                // element just inserted did not exist yet in the map
-            ret.first->first.compact();  // FIXME see MappedName.cpp
-            mappedRef(idx).append(ret.first->first, sids);
+        auto hash = hashMappedName(name);
+        long pos = findSlot(name, hash);
+        if (pos < 0) {  // element did not exist yet in the map
+            MappedName stored(name);
+            stored.compact();  // FIXME see MappedName.cpp
+            mappedRef(idx).append(stored, sids);
+            insertSlot(hash, this->indexedNames.find(idx.getType())->first, idx.getIndex());
             FC_TRACE(idx << " -> " << name);  // NOLINT
-            return ret.first->first;
+            return stored;
         }
-        if (ret.first->second == idx) {
+        const auto& slot = mappedNames[pos];
+        auto found = IndexedName::fromConst(slot.type, slot.index);
+        if (found == idx) {
             FC_TRACE("duplicate " << idx << " -> " << name);  // NOLINT
-            return ret.first->first;
+            return findSlotRef(slot, name)->name;
         }
         if (!overwrite) {
             if (existing) {
-                *existing = ret.first->second;
+                *existing = found;
             }
             return {};
         }
 
-        erase(ret.first->first);
+        erase(name);
     };
 }
 
@@ -780,16 +811,16 @@ MappedName ElementMap::renameDuplicateElement(int index,
 
 void ElementMap::erase(const MappedName& name)
 {
-    auto it = this->mappedNames.find(name);
-    if (it == this->mappedNames.end()) {
+    long pos = findSlot(name, hashMappedName(name));
+    if (pos < 0) {
         return;
     }
-    MappedNameRef* ref = findMappedRef(it->second);
-    if (!ref) {
-        return;
+    auto idx = IndexedName::fromConst(mappedNames[pos].type, mappedNames[pos].index);
+    eraseSlot(pos);
+    MappedNameRef* ref = findMappedRef(idx);
+    if (ref) {
+        ref->erase(name);
     }
-    ref->erase(name);
-    this->mappedNames.erase(it);
 }
 
 void ElementMap::erase(const IndexedName& idx)
@@ -804,25 +835,31 @@ void ElementMap::erase(const IndexedName& idx)
     }
     auto& ref = indices.names[idx.getIndex()];
     for (auto* nameRef = &ref; nameRef; nameRef = nameRef->next.get()) {
-        this->mappedNames.erase(nameRef->name);
+        if (!nameRef->name) {
+            continue;
+        }
+        long pos = findSlot(nameRef->name, hashMappedName(nameRef->name));
+        if (pos >= 0) {
+            eraseSlot(pos);
+        }
     }
     ref.clear();
 }
 
 unsigned long ElementMap::size() const
 {
-    return mappedNames.size() + childElementSize;
+    return mappedNameCount + childElementSize;
 }
 
 bool ElementMap::empty() const
 {
-    return mappedNames.empty() && childElementSize == 0;
+    return mappedNameCount == 0 && childElementSize == 0;
 }
 
 IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
 {
-    auto nameIter = mappedNames.find(name);
-    if (nameIter == mappedNames.end()) {
+    long pos = findSlot(name, hashMappedName(name));
+    if (pos < 0) {
         if (childElements.isEmpty()) {
             return IndexedName();
         }
@@ -858,21 +895,17 @@ IndexedName ElementMap::find(const MappedName& name, ElementIDRefs* sids) const
         return IndexedName();
     }
 
+    const auto& slot = mappedNames[pos];
     if (sids) {
-        const MappedNameRef* ref = findMappedRef(nameIter->second);
-        for (; ref; ref = ref->next.get()) {
-            if (ref->name == name) {
-                if (sids->empty()) {
-                    *sids = ref->sids;
-                }
-                else {
-                    *sids += ref->sids;
-                }
-                break;
-            }
+        const MappedNameRef* ref = findSlotRef(slot, name);
+        if (sids->empty()) {
+            *sids = ref->sids;
+        }
+        else {
+            *sids += ref->sids;
         }
     }
-    return nameIter->second;
+    return IndexedName::fromConst(slot.type, slot.index);
 }
 
 MappedName ElementMap::find(const IndexedName& idx, ElementIDRefs* sids) const
@@ -1009,6 +1042,129 @@ MappedNameRef& ElementMap::mappedRef(const IndexedName& idx)
     return indices.names[idx.getIndex()];
 }
 
+const MappedNameRef* ElementMap::findSlotRef(const MappedNameSlot& slot,
+                                             const MappedName& name) const
+{
+    auto iter = this->indexedNames.find(slot.type);
+    if (iter == this->indexedNames.end() || slot.index >= (int)iter->second.names.size()) {
+        return nullptr;
+    }
+    for (const MappedNameRef* ref = &iter->second.names[slot.index]; ref; ref = ref->next.get()) {
+        if (ref->name == name) {
+            return ref;
+        }
+    }
+    return nullptr;
+}
+
+long ElementMap::findSlot(const MappedName& name, std::uint32_t hash) const
+{
+    if (this->mappedNames.empty()) {
+        return -1;
+    }
+    // The table always has empty slots, see insertSlot()
+    std::size_t mask = this->mappedNames.size() - 1;
+    for (std::size_t pos = hash & mask;; pos = (pos + 1) & mask) {
+        const auto& slot = this->mappedNames[pos];
+        if (!slot.type) {
+            return -1;
+        }
+        if (slot.hash == hash && findSlotRef(slot, name)) {
+            return static_cast<long>(pos);
+        }
+    }
+}
+
+void ElementMap::rehashSlots(std::size_t size)
+{
+    std::vector<MappedNameSlot> slots(size);
+    slots.swap(this->mappedNames);
+    std::size_t mask = this->mappedNames.size() - 1;
+    for (const auto& slot : slots) {
+        if (slot.type) {
+            std::size_t pos = slot.hash & mask;
+            while (this->mappedNames[pos].type) {
+                pos = (pos + 1) & mask;
+            }
+            this->mappedNames[pos] = slot;
+        }
+    }
+}
+
+void ElementMap::reserve(std::size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    std::size_t size = std::max<std::size_t>(16, this->mappedNames.size());
+    while (count * 4 > size * 3) {
+        size *= 2;
+    }
+    if (size > this->mappedNames.size()) {
+        rehashSlots(size);
+    }
+}
+
+void ElementMap::insertSlot(std::uint32_t hash, const char* type, int index)
+{
+    constexpr std::size_t minSize = 16;
+    // Keep the load factor below 3/4 so that the probe sequences stay short
+    if ((this->mappedNameCount + 1) * 4 > this->mappedNames.size() * 3) {
+        rehashSlots(std::max(minSize, this->mappedNames.size() * 2));
+    }
+    std::size_t mask = this->mappedNames.size() - 1;
+    std::size_t pos = hash & mask;
+    while (this->mappedNames[pos].type) {
+        pos = (pos + 1) & mask;
+    }
+    this->mappedNames[pos] = MappedNameSlot {type, index, hash};
+    ++this->mappedNameCount;
+}
+
+void ElementMap::eraseSlot(std::size_t pos)
+{
+    // Backward shift deletion: move the following entries of the probe sequence
+    // into the hole unless that would put them before their home position.
+    std::size_t mask = this->mappedNames.size() - 1;
+    std::size_t hole = pos;
+    for (std::size_t next = (hole + 1) & mask; this->mappedNames[next].type;
+         next = (next + 1) & mask) {
+        std::size_t home = this->mappedNames[next].hash & mask;
+        bool stays = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+        if (!stays) {
+            this->mappedNames[hole] = this->mappedNames[next];
+            hole = next;
+        }
+    }
+    this->mappedNames[hole] = MappedNameSlot();
+    --this->mappedNameCount;
+}
+
+std::vector<std::pair<const MappedName*, IndexedName>> ElementMap::sortedMappedNames() const
+{
+    std::vector<std::pair<const MappedName*, IndexedName>> res;
+    res.reserve(this->mappedNameCount);
+    for (auto& [type, indices] : this->indexedNames) {
+        for (int i = 0; i < (int)indices.names.size(); ++i) {
+            for (const MappedNameRef* ref = &indices.names[i]; ref; ref = ref->next.get()) {
+                if (!ref->name) {
+                    continue;
+                }
+                // Skip names that are mapped to another element
+                long pos = findSlot(ref->name, hashMappedName(ref->name));
+                if (pos >= 0 && this->mappedNames[pos].type == type
+                    && this->mappedNames[pos].index == i) {
+                    res.emplace_back(&ref->name, IndexedName::fromConst(type, i));
+                }
+            }
+        }
+    }
+    std::sort(res.begin(), res.end(), [](const auto& a, const auto& b) {
+        return *a.first < *b.first;
+    });
+    return res;
+}
+
 bool ElementMap::hasChildElementMap() const
 {
     return !childElements.empty();
@@ -1075,8 +1231,8 @@ void ElementMap::collectChildMaps(std::map<const ElementMap*, int>& childMapSet,
         }
     }
 
-    for (auto& mappedName : this->mappedNames) {
-        addPostfix(mappedName.first.constPostfix(), postfixMap, postfixes);
+    for (auto& mappedName : sortedMappedNames()) {
+        addPostfix(mappedName.first->constPostfix(), postfixMap, postfixes);
     }
 
     childMaps.push_back(this);
@@ -1298,12 +1454,44 @@ std::vector<ElementMap::MappedChildElements> ElementMap::getChildElements() cons
     return res;
 }
 
+ElementMapPtr ElementMap::copy() const
+{
+    auto res = std::make_shared<ElementMap>();
+    res->hasher = this->hasher;
+    for (auto& indexedName : this->indexedNames) {
+        auto& elements = res->indexedNames[indexedName.first];
+        for (const MappedNameRef& mappedName : indexedName.second.names) {
+            // The copy constructor of MappedNameRef leaves out the chained names
+            elements.names.push_back(mappedName);
+            MappedNameRef* last = &elements.names.back();
+            for (const MappedNameRef* ref = mappedName.next.get(); ref; ref = ref->next.get()) {
+                last->next = std::make_unique<MappedNameRef>(*ref);
+                last = last->next.get();
+            }
+        }
+        elements.children = indexedName.second.children;
+    }
+    // The table only refers to the elements by type and index, so it stays valid
+    res->mappedNames = this->mappedNames;
+    res->mappedNameCount = this->mappedNameCount;
+
+    for (auto it = this->childElements.begin(); it != this->childElements.end(); ++it) {
+        ChildMapInfo& info = res->childElements[it.key()];
+        info = it.value();
+        const MappedChildElements& child = *info.childMap;
+        info.childMap = &res->indexedNames[child.indexedName.getType()]
+                             .children[child.indexedName.getIndex() + child.offset + child.count];
+    }
+    res->childElementSize = this->childElementSize;
+    return res;
+}
+
 std::vector<MappedElement> ElementMap::getAll() const
 {
     std::vector<MappedElement> ret;
     ret.reserve(size());
-    for (auto& mappedName : this->mappedNames) {
-        ret.emplace_back(mappedName.first, mappedName.second);
+    for (auto& mappedName : sortedMappedNames()) {
+        ret.emplace_back(*mappedName.first, mappedName.second);
     }
     for (auto& childElement : this->childElements) {
         auto& child = *childElement.childMap;
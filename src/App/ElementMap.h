@@ -32,11 +32,13 @@
 #include "MappedElement.h"
 #include "StringHasher.h"
 
+#include <cstdint>
 #include <cstring>
 #include <deque>
 #include <functional>
 #include <map>
 #include <memory>
+#include <vector>
 
 
 namespace Data
@@ -66,7 +68,8 @@ typedef std::function<bool(const MappedName&, int, long, long)> TraceCallback;
  * `indexedNames` maps a string to both a name queue and children.
  *   each of those children store an IndexedName, offset details, postfix, ids, and
  *   possibly a recursive elementmap
- * `mappedNames` maps a MappedName to a specific IndexedName.
+ * `mappedNames` maps a MappedName to a specific IndexedName. It is a hash table that
+ *   refers to the names stored in `indexedNames` instead of keeping a copy of them.
  */
 class AppExport ElementMap
     : public std::enable_shared_from_this<ElementMap>  // TODO can remove shared_from_this?
@@ -150,6 +153,9 @@ public:
 
     unsigned long size() const;
 
+    /// Make room for \c count mapped names in total, so that adding them doesn't grow the table
+    void reserve(std::size_t count);
+
     bool empty() const;
 
     IndexedName find(const MappedName& name, ElementIDRefs* sids = nullptr) const;
@@ -197,6 +203,12 @@ public:
 
     std::vector<MappedElement> getAll() const;
 
+    /** Return a copy of this map that can be changed independently of it
+     *
+     * The element maps of the children are immutable and shared with the copy.
+     */
+    ElementMapPtr copy() const;
+
     long getElementHistory(const MappedName& name,
                            long masterTag,
                            MappedName* original = nullptr,
@@ -281,6 +293,32 @@ private:
 
     MappedNameRef& mappedRef(const IndexedName& idx);
 
+    /** An entry of the mappedNames hash table
+     *
+     * The name is only stored once in IndexedElements::names. The entry refers to the element
+     * owning the name, which keeps the overhead of the table at 16 bytes per name.
+     */
+    struct MappedNameSlot
+    {
+        const char* type = nullptr;  ///< key of indexedNames, or null for an empty slot
+        int index = 0;
+        std::uint32_t hash = 0;
+    };
+
+    /// Find the position of \c name in mappedNames, returns -1 if not found
+    long findSlot(const MappedName& name, std::uint32_t hash) const;
+    /// Find the reference to \c name in the element that \c slot refers to
+    const MappedNameRef* findSlotRef(const MappedNameSlot& slot, const MappedName& name) const;
+    /// Add a name that isn't in the table yet. The name must already be stored in the element.
+    void insertSlot(std::uint32_t hash, const char* type, int index);
+    /// Move all entries to a new table of \c size slots, size must be a power of two
+    void rehashSlots(std::size_t size);
+    /// Remove the entry at \c pos from the table
+    void eraseSlot(std::size_t pos);
+    /// Return all mapped names ordered by name. The result refers to the names of the map and
+    /// is only valid until the map is changed, so it is meant to be used and dropped right away.
+    std::vector<std::pair<const MappedName*, IndexedName>> sortedMappedNames() const;
+
     void collectChildMaps(std::map<const ElementMap*, int>& childMapSet,
                           std::vector<const ElementMap*>& childMaps,
                           std::map<QByteArray, int>& postfixMap,
@@ -303,7 +341,9 @@ private:
 
     std::map<const char*, IndexedElements, CStringComp> indexedNames;
 
-    std::map<MappedName, IndexedName, std::less<>> mappedNames;
+    /// Open addressing hash table with linear probing, its size is a power of two
+    std::vector<MappedNameSlot> mappedNames;
+    std::size_t mappedNameCount = 0;
 
     struct ChildMapInfo
     {
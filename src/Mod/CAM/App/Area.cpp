@@ -3808,16 +3808,21 @@ static inline void addParameter(bool verbose,
     }
 }
 
-static inline void
-addGCode(bool verbose, Toolpath& path, const gp_Pnt& last, const gp_Pnt& next, const char* name)
+static inline Command
+makeGCode(bool verbose, const gp_Pnt& last, const gp_Pnt& next, const char* name)
 {
     Command cmd;
     cmd.Name = name;
     addParameter(verbose, cmd, "X", last.X(), next.X());
     addParameter(verbose, cmd, "Y", last.Y(), next.Y());
     addParameter(verbose, cmd, "Z", last.Z(), next.Z());
-    path.addCommand(cmd);
-    return;
+    return cmd;
+}
+
+static inline void
+addGCode(bool verbose, Toolpath& path, const gp_Pnt& last, const gp_Pnt& next, const char* name)
+{
+    path.addCommand(makeGCode(verbose, last, next, name));
 }
 
 static inline void addG1(bool verbose,
@@ -3827,13 +3832,12 @@ static inline void addG1(bool verbose,
                          double f,
                          double& last_f)
 {
-    addGCode(verbose, path, last, next, "G1");
+    Command cmd = makeGCode(verbose, last, next, "G1");
     if (f > Precision::Confusion()) {
-        Command* cmd = path.getCommands().back();
-        addParameter(verbose, *cmd, "F", last_f, f);
+        addParameter(verbose, cmd, "F", last_f, f);
         last_f = f;
     }
-    return;
+    path.addCommand(cmd);
 }
 
 static void addG0(bool verbose,
@@ -93,16 +93,43 @@ bool Command::has(const std::string& attr) const
     return Parameters.contains(a);
 }
 
-std::string Command::toGCode(int precision, bool padzero) const
+void Command::writeGCodeValue(std::ostream& str, double value, int precision, bool padzero)
 {
-    std::stringstream str;
-    str.fill('0');
-    str << Name;
     if (precision < 0) {
         precision = 0;
     }
     double scale = std::pow(10.0, precision + 1);
     std::int64_t iscale = static_cast<std::int64_t>(scale) / 10;
+    std::int64_t v = static_cast<std::int64_t>(value * scale);
+    if (v < 0) {
+        v = -v;
+        str << '-';  // shall we allow -0 ?
+    }
+    v += 5;
+    v /= 10;
+    str << (v / iscale);
+    if (!precision) {
+        return;
+    }
+
+    int width = precision;
+    std::int64_t digits = v % iscale;
+    if (!padzero) {
+        if (!digits) {
+            return;
+        }
+        while (digits % 10 == 0) {
+            digits /= 10;
+            --width;
+        }
+    }
+    str << '.' << std::setfill('0') << std::setw(width) << std::right << digits;
+}
+
+std::string Command::toGCode(int precision, bool padzero) const
+{
+    std::stringstream str;
+    str << Name;
     for (std::map<std::string, double>::const_iterator i = Parameters.begin();
          i != Parameters.end();
          ++i) {
@@ -111,31 +138,7 @@ std::string Command::toGCode(int precision, bool padzero) const
         }
 
         str << " " << i->first;
-
-        std::int64_t v = static_cast<std::int64_t>(i->second * scale);
-        if (v < 0) {
-            v = -v;
-            str << '-';  // shall we allow -0 ?
-        }
-        v += 5;
-        v /= 10;
-        str << (v / iscale);
-        if (!precision) {
-            continue;
-        }
-
-        int width = precision;
-        std::int64_t digits = v % iscale;
-        if (!padzero) {
-            if (!digits) {
-                continue;
-            }
-            while (digits % 10 == 0) {
-                digits /= 10;
-                --width;
-            }
-        }
-        str << '.' << std::setw(width) << std::right << digits;
+        writeGCodeValue(str, i->second, precision, padzero);
     }
     return str.str();
 }
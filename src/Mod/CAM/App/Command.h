@@ -26,6 +26,7 @@
 #define PATH_COMMAND_H
 
 #include <map>
+#include <ostream>
 #include <string>
 #include <Base/Persistence.h>
 #include <Base/Placement.h>
@@ -68,6 +69,9 @@ public:
     double getValue(const std::string& name) const;  // returns the value of a given parameter
     void scaleBy(double factor);  // scales the receiver - use for imperial/metric conversions
 
+    // writes a parameter value with the given number of decimals, as used by toGCode()
+    static void writeGCodeValue(std::ostream& str, double value, int precision, bool padzero);
+
     // this assumes the name is upper case
     inline double getParam(const std::string& name, double fallback = 0.0) const
     {
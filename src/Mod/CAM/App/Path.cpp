@@ -22,8 +22,18 @@
  ***************************************************************************/
 
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <sstream>
+#include <string_view>
+
+#include <OSD_Parallel.hxx>
+
 #include <App/Application.h>
 #include <Base/Console.h>
+#include <Base/Exception.h>
 #include <Base/Reader.h>
 #include <Base/Stream.h>
 #include <Base/Writer.h>
@@ -37,54 +47,265 @@ using namespace Base;
 
 TYPESYSTEM_SOURCE(Path::Toolpath, Base::Persistence)
 
-Toolpath::Toolpath()
-{}
+namespace
+{
+
+// the names of the parameters stored in the columns, in the order of CommandView::Column
+const char columnNames[CommandView::ColumnCount + 1] = "XYZABCIJKF";
+// the columns in the alphabetical order of their names
+const CommandView::Column sortedColumns[CommandView::ColumnCount] = {CommandView::A,
+                                                                     CommandView::B,
+                                                                     CommandView::C,
+                                                                     CommandView::F,
+                                                                     CommandView::I,
+                                                                     CommandView::J,
+                                                                     CommandView::K,
+                                                                     CommandView::X,
+                                                                     CommandView::Y,
+                                                                     CommandView::Z};
 
-Toolpath::Toolpath(const Toolpath& otherPath)
-    : vpcCommands(otherPath.vpcCommands.size())
-    , center(otherPath.center)
+enum class MoveKind
 {
-    *this = otherPath;
-    recalculate();
+    None,
+    Rapid,
+    Feed,
+    Arc
+};
+
+MoveKind moveKind(const std::string& name)
+{
+    if ((name == "G0") || (name == "G00")) {
+        return MoveKind::Rapid;
+    }
+    if ((name == "G1") || (name == "G01")) {
+        return MoveKind::Feed;
+    }
+    if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
+        return MoveKind::Arc;
+    }
+    return MoveKind::None;
 }
 
-Toolpath::~Toolpath()
+}  // namespace
+
+// CommandView
+
+const std::string& CommandView::getName() const
 {
-    clear();
+    return path->names[path->opcodes[row]];
+}
+
+bool CommandView::has(Column col) const
+{
+    return (path->masks[row] >> col) & 1;
+}
+
+double CommandView::getParam(Column col, double fallback) const
+{
+    return has(col) ? path->columns[col][row] : fallback;
+}
+
+bool CommandView::has(const std::string& name) const
+{
+    int col = columnOf(name);
+    if (col < ColumnCount) {
+        return has(static_cast<Column>(col));
+    }
+    for (auto i = path->extraOffsets[row]; i < path->extraOffsets[row + 1]; ++i) {
+        if (path->extras[i].first == name) {
+            return true;
+        }
+    }
+    return false;
 }
 
-Toolpath& Toolpath::operator=(const Toolpath& otherPath)
+double CommandView::getParam(const std::string& name, double fallback) const
 {
-    if (this == &otherPath) {
-        return *this;
+    int col = columnOf(name);
+    if (col < ColumnCount) {
+        return getParam(static_cast<Column>(col), fallback);
     }
+    for (auto i = path->extraOffsets[row]; i < path->extraOffsets[row + 1]; ++i) {
+        if (path->extras[i].first == name) {
+            return path->extras[i].second;
+        }
+    }
+    return fallback;
+}
 
-    clear();
-    vpcCommands.resize(otherPath.vpcCommands.size());
-    int i = 0;
-    for (std::vector<Command*>::const_iterator it = otherPath.vpcCommands.begin();
-         it != otherPath.vpcCommands.end();
-         ++it, i++) {
-        vpcCommands[i] = new Command(**it);
-    }
-    center = otherPath.center;
-    recalculate();
-    return *this;
+Base::Placement CommandView::getPlacement(const Base::Vector3d pos) const
+{
+    Vector3d vec(getParam(X, pos.x), getParam(Y, pos.y), getParam(Z, pos.z));
+    Rotation rot;
+    rot.setYawPitchRoll(getParam(A), getParam(B), getParam(C));
+    return Placement(vec, rot);
+}
+
+Base::Vector3d CommandView::getCenter() const
+{
+    return Vector3d(getParam(I), getParam(J), getParam(K));
+}
+
+void CommandView::writeGCode(std::ostream& str, int precision, bool padzero) const
+{
+    // same output as Command::toGCode(), i.e. the parameters sorted by name
+    str << getName();
+    auto it = path->extras.begin() + path->extraOffsets[row];
+    auto end = path->extras.begin() + path->extraOffsets[row + 1];
+    auto writeExtras = [&](std::string_view upTo) {
+        for (; it != end && (upTo.empty() || std::string_view(it->first) < upTo); ++it) {
+            if (it->first == "N") {
+                continue;
+            }
+            str << " " << it->first;
+            Command::writeGCodeValue(str, it->second, precision, padzero);
+        }
+    };
+    for (Column col : sortedColumns) {
+        if (!has(col)) {
+            continue;
+        }
+        std::string_view name(&columnNames[col], 1);
+        writeExtras(name);
+        str << " " << name;
+        Command::writeGCodeValue(str, path->columns[col][row], precision, padzero);
+    }
+    writeExtras(std::string_view());
+}
+
+std::string CommandView::toGCode(int precision, bool padzero) const
+{
+    std::stringstream str;
+    writeGCode(str, precision, padzero);
+    return str.str();
+}
+
+Command CommandView::toCommand() const
+{
+    Command cmd;
+    cmd.Name = getName();
+    for (int col = 0; col < ColumnCount; ++col) {
+        if (has(static_cast<Column>(col))) {
+            cmd.Parameters.emplace(std::string(1, columnNames[col]), path->columns[col][row]);
+        }
+    }
+    for (auto i = path->extraOffsets[row]; i < path->extraOffsets[row + 1]; ++i) {
+        cmd.Parameters.insert(path->extras[i]);
+    }
+    return cmd;
 }
 
+int CommandView::columnOf(const std::string& name)
+{
+    return name.size() == 1 ? columnOf(name[0]) : ColumnCount;
+}
+
+int CommandView::columnOf(char name)
+{
+    switch (name) {
+        case 'X':
+            return X;
+        case 'Y':
+            return Y;
+        case 'Z':
+            return Z;
+        case 'A':
+            return A;
+        case 'B':
+            return B;
+        case 'C':
+            return C;
+        case 'I':
+            return I;
+        case 'J':
+            return J;
+        case 'K':
+            return K;
+        case 'F':
+            return F;
+        default:
+            return ColumnCount;
+    }
+}
+
+// Toolpath
+
+Toolpath::Toolpath()
+    : extraOffsets(1, 0)
+{}
+
+Toolpath::Toolpath(const Toolpath& otherPath) = default;
+
+Toolpath::~Toolpath() = default;
+
+Toolpath& Toolpath::operator=(const Toolpath& otherPath) = default;
+
 void Toolpath::clear()
 {
-    for (std::vector<Command*>::iterator it = vpcCommands.begin(); it != vpcCommands.end(); ++it) {
-        delete (*it);
+    names.clear();
+    nameIndex.clear();
+    opcodes.clear();
+    masks.clear();
+    for (auto& column : columns) {
+        column.clear();
     }
-    vpcCommands.clear();
+    extraOffsets.assign(1, 0);
+    extras.clear();
     recalculate();
 }
 
+void Toolpath::reserve(unsigned int size)
+{
+    opcodes.reserve(size);
+    masks.reserve(size);
+    for (auto& column : columns) {
+        column.reserve(size);
+    }
+    extraOffsets.reserve(size + 1);
+}
+
+std::uint32_t Toolpath::internName(const std::string& name)
+{
+    auto res = nameIndex.emplace(name, static_cast<std::uint32_t>(names.size()));
+    if (res.second) {
+        names.push_back(name);
+    }
+    return res.first->second;
+}
+
+void Toolpath::insertRow(const Command& Cmd, unsigned int pos)
+{
+    std::uint16_t mask = 0;
+    std::array<double, CommandView::ColumnCount> values {};
+    std::uint32_t start = extraOffsets[pos];
+    std::uint32_t count = 0;
+    for (const auto& param : Cmd.Parameters) {
+        int col = CommandView::columnOf(param.first);
+        if (col < CommandView::ColumnCount) {
+            mask |= 1 << col;
+            values[col] = param.second;
+        }
+        else {
+            // Parameters is sorted, so the extras of the command are as well
+            extras.insert(extras.begin() + start + count, param);
+            ++count;
+        }
+    }
+
+    opcodes.insert(opcodes.begin() + pos, internName(Cmd.Name));
+    masks.insert(masks.begin() + pos, mask);
+    for (int col = 0; col < CommandView::ColumnCount; ++col) {
+        columns[col].insert(columns[col].begin() + pos, values[col]);
+    }
+    extraOffsets.insert(extraOffsets.begin() + pos, start);
+    for (auto i = pos + 1; i < extraOffsets.size(); ++i) {
+        extraOffsets[i] += count;
+    }
+}
+
 void Toolpath::addCommand(const Command& Cmd)
 {
-    Command* tmp = new Command(Cmd);
-    vpcCommands.push_back(tmp);
+    insertRow(Cmd, getSize());
     recalculate();
 }
 
@@ -93,9 +314,8 @@ void Toolpath::insertCommand(const Command& Cmd, int pos)
     if (pos == -1) {
         addCommand(Cmd);
     }
-    else if (pos <= static_cast<int>(vpcCommands.size())) {
-        Command* tmp = new Command(Cmd);
-        vpcCommands.insert(vpcCommands.begin() + pos, tmp);
+    else if (pos >= 0 && pos <= static_cast<int>(getSize())) {
+        insertRow(Cmd, pos);
     }
     else {
         throw Base::IndexError("Index not in range");
@@ -106,38 +326,53 @@ void Toolpath::insertCommand(const Command& Cmd, int pos)
 void Toolpath::deleteCommand(int pos)
 {
     if (pos == -1) {
-        // delete(*vpcCommands.rbegin()); // causes crash
-        vpcCommands.pop_back();
-    }
-    else if (pos <= static_cast<int>(vpcCommands.size())) {
-        vpcCommands.erase(vpcCommands.begin() + pos);
+        pos = static_cast<int>(getSize()) - 1;
     }
-    else {
+    if (pos < 0 || pos >= static_cast<int>(getSize())) {
         throw Base::IndexError("Index not in range");
     }
+
+    std::uint32_t start = extraOffsets[pos];
+    std::uint32_t count = extraOffsets[pos + 1] - start;
+    extras.erase(extras.begin() + start, extras.begin() + start + count);
+    extraOffsets.erase(extraOffsets.begin() + pos + 1);
+    for (auto i = static_cast<std::size_t>(pos) + 1; i < extraOffsets.size(); ++i) {
+        extraOffsets[i] -= count;
+    }
+    opcodes.erase(opcodes.begin() + pos);
+    masks.erase(masks.begin() + pos);
+    for (auto& column : columns) {
+        column.erase(column.begin() + pos);
+    }
     recalculate();
 }
 
 double Toolpath::getLength()
 {
-    if (vpcCommands.empty()) {
+    if (opcodes.empty()) {
         return 0;
     }
+    std::vector<MoveKind> kinds;
+    kinds.reserve(names.size());
+    for (const auto& name : names) {
+        kinds.push_back(moveKind(name));
+    }
+
     double l = 0;
     Vector3d last(0, 0, 0);
     Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        std::string name = (*it)->Name;
-        next = (*it)->getPlacement(last).getPosition();
-        if ((name == "G0") || (name == "G00") || (name == "G1") || (name == "G01")) {
+    for (unsigned int i = 0; i < getSize(); ++i) {
+        CommandView cmd(*this, i);
+        MoveKind kind = kinds[opcodes[i]];
+        next = cmd.getPlacement(last).getPosition();
+        if ((kind == MoveKind::Rapid) || (kind == MoveKind::Feed)) {
             // straight line
             l += (next - last).Length();
             last = next;
         }
-        else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
+        else if (kind == MoveKind::Arc) {
             // arc
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = cmd.getCenter();
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -167,30 +402,35 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
         vRapid = vFeed;
     }
 
-    if (vpcCommands.empty()) {
+    if (opcodes.empty()) {
         return 0;
     }
+    std::vector<MoveKind> kinds;
+    kinds.reserve(names.size());
+    for (const auto& name : names) {
+        kinds.push_back(moveKind(name));
+    }
+
     double l = 0;
     double time = 0;
     bool verticalMove = false;
     Vector3d last(0, 0, 0);
     Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        std::string name = (*it)->Name;
-        float feedrate = (*it)->getParam("F");
+    for (unsigned int i = 0; i < getSize(); ++i) {
+        CommandView cmd(*this, i);
+        MoveKind kind = kinds[opcodes[i]];
 
         l = 0;
         verticalMove = false;
-        feedrate = hFeed;
-        next = (*it)->getPlacement(last).getPosition();
+        float feedrate = hFeed;
+        next = cmd.getPlacement(last).getPosition();
 
         if (last.z != next.z) {
             verticalMove = true;
             feedrate = vFeed;
         }
 
-        if ((name == "G0") || (name == "G00")) {
+        if (kind == MoveKind::Rapid) {
             // Rapid Move
             l += (next - last).Length();
             feedrate = hRapid;
@@ -198,13 +438,13 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
                 feedrate = vRapid;
             }
         }
-        else if ((name == "G1") || (name == "G01")) {
+        else if (kind == MoveKind::Feed) {
             // Feed Move
             l += (next - last).Length();
         }
-        else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
+        else if (kind == MoveKind::Arc) {
             // Arc Move
-            Vector3d center = (*it)->getCenter();
+            Vector3d center = cmd.getCenter();
             double radius = (last - center).Length();
             double angle = (next - center).GetAngle(last - center);
             l += angle * radius;
@@ -304,76 +544,370 @@ Base::BoundBox3d Toolpath::getBoundBox() const
     return visitor.bb;
 }
 
-static void
-bulkAddCommand(const std::string& gcodestr, std::vector<Command*>& commands, bool& inches)
+// G-code parsing
+
+namespace
+{
+
+// The parser below gives the same commands as splitting the G-code at every G, M and comment
+// and passing the pieces to Command::setFromGCode(), but works on the input text directly.
+
+bool isCommandStart(char c)
+{
+    return c == '(' || c == 'G' || c == 'g' || c == 'M' || c == 'm';
+}
+
+std::size_t findCommandStart(std::string_view gcode, std::size_t pos)
 {
-    Command* cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
+    for (; pos < gcode.size(); ++pos) {
+        if (isCommandStart(gcode[pos])) {
+            return pos;
+        }
     }
-    else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
+    return std::string_view::npos;
+}
+
+bool isValueChar(char c)
+{
+    return (c >= '0' && c <= '9') || c == '-' || c == '.';
+}
+
+bool isAlpha(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+char toUpper(char c)
+{
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+// the parameters that Command::scaleBy() scales
+bool isLength(char key)
+{
+    return std::strchr("XYZIJRQF", key) != nullptr;
+}
+
+const double inch = 25.4;
+
+// Same result as std::atof(), but without copying the text for the common numbers
+double parseValue(std::string_view text)
+{
+    static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    std::size_t pos = 0;
+    bool negative = false;
+    if (pos < text.size() && text[pos] == '-') {
+        negative = true;
+        ++pos;
     }
-    else {
-        if (inches) {
-            cmd->scaleBy(25.4);
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int decimals = 0;
+    bool point = false;
+    for (; pos < text.size(); ++pos) {
+        char c = text[pos];
+        if (c >= '0' && c <= '9') {
+            mantissa = mantissa * 10 + (c - '0');
+            ++digits;
+            if (point) {
+                ++decimals;
+            }
+        }
+        else if (c == '.' && !point) {
+            point = true;
+        }
+        else {
+            break;
+        }
+        if (digits > 15) {
+            // the mantissa may not be exact in a double anymore
+            return std::atof(std::string(text).c_str());
         }
-        commands.push_back(cmd);
     }
+    if (!digits) {
+        return 0.0;
+    }
+    // both numbers are exact, so the division is correctly rounded
+    double value = static_cast<double>(mantissa) / powers[decimals];
+    return negative ? -value : value;
 }
 
-void Toolpath::setFromGCode(const std::string instr)
+// The text of a value, which is not contiguous if there are ignored characters in between
+class ValueText
 {
-    clear();
+public:
+    void clear()
+    {
+        begin = end = nullptr;
+        joined.clear();
+    }
+    bool empty() const
+    {
+        return begin == end;
+    }
+    void add(const char* c)
+    {
+        if (empty()) {
+            begin = c;
+        }
+        else if (c != end || !joined.empty()) {
+            if (joined.empty()) {
+                joined.assign(begin, end);
+            }
+            joined += *c;
+        }
+        end = c + 1;
+    }
+    std::string_view view() const
+    {
+        return joined.empty() ? std::string_view(begin, end - begin) : std::string_view(joined);
+    }
 
-    // remove comments
-    // boost::regex e("\\(.*?\\)");
-    // std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
+private:
+    const char* begin {nullptr};
+    const char* end {nullptr};
+    std::string joined;
+};
 
-    // split input string by () or G or M commands
-    std::string mode = "command";
-    std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
-    bool inches = false;
-    while (found != std::string::npos) {
-        if (str[found] == '(') {
-            // start of comment
-            if ((last > -1) && (mode == "command")) {
-                // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+// Split a large G-code text at command starts outside of comments for parsing it in parallel
+std::vector<std::string_view> splitGCode(std::string_view gcode)
+{
+    const std::size_t minChunkSize = 1 << 20;
+    std::size_t count = std::min<std::size_t>(gcode.size() / minChunkSize,
+                                              4 * OSD_Parallel::NbLogicalProcessors());
+    if (count <= 1) {
+        return {gcode};
+    }
+
+    std::vector<std::string_view> chunks;
+    std::size_t chunkSize = gcode.size() / count;
+    std::size_t begin = 0;
+    std::size_t pos = 0;
+    while (begin + chunkSize < gcode.size()) {
+        std::size_t target = begin + chunkSize;
+        // skip the comments before the target, pos is always outside of a comment
+        std::size_t open = gcode.find('(', pos);
+        while (open != std::string_view::npos && open < target) {
+            std::size_t close = gcode.find(')', open + 1);
+            if (close == std::string_view::npos) {
+                // the rest is an unterminated comment
+                chunks.push_back(gcode.substr(begin));
+                return chunks;
+            }
+            pos = close + 1;
+            open = gcode.find('(', pos);
+        }
+        std::size_t end = findCommandStart(gcode, std::max(pos, target));
+        if (end == std::string_view::npos) {
+            break;
+        }
+        chunks.push_back(gcode.substr(begin, end - begin));
+        begin = pos = end;
+    }
+    chunks.push_back(gcode.substr(begin));
+    return chunks;
+}
+
+}  // namespace
+
+void Toolpath::parseGCode(std::string_view gcode, int& units, unsigned int& unscaled)
+{
+    std::string name;
+    std::uint16_t mask = 0;
+    std::array<double, CommandView::ColumnCount> values {};
+    std::vector<std::pair<std::string, double>> rowExtras;
+    ValueText value;
+
+    auto setParam = [&](char key) {
+        double val = parseValue(value.view());
+        if (units == 1 && isLength(key)) {
+            val *= inch;
+        }
+        int col = CommandView::columnOf(key);
+        if (col < CommandView::ColumnCount) {
+            mask |= 1 << col;
+            values[col] = val;
+            return;
+        }
+        for (auto& extra : rowExtras) {
+            if (extra.first[0] == key) {
+                extra.second = val;
+                return;
+            }
+        }
+        rowExtras.emplace_back(std::string(1, key), val);
+    };
+
+    auto addRow = [&]() {
+        if (name == "G20" || name == "G21") {
+            units = name == "G20" ? 1 : 0;
+            return;
+        }
+        if (units < 0) {
+            ++unscaled;
+        }
+        std::sort(rowExtras.begin(), rowExtras.end());
+        // moves mostly repeat the command before them
+        if (opcodes.empty() || names[opcodes.back()] != name) {
+            opcodes.push_back(internName(name));
+        }
+        else {
+            opcodes.push_back(opcodes.back());
+        }
+        masks.push_back(mask);
+        for (int col = 0; col < CommandView::ColumnCount; ++col) {
+            columns[col].push_back(values[col]);
+        }
+        extras.insert(extras.end(), rowExtras.begin(), rowExtras.end());
+        extraOffsets.push_back(static_cast<std::uint32_t>(extras.size()));
+    };
+
+    std::size_t pos = findCommandStart(gcode, 0);
+    while (pos != std::string_view::npos) {
+        mask = 0;
+        values.fill(0.0);
+        rowExtras.clear();
+        value.clear();
+
+        if (gcode[pos] == '(') {
+            std::size_t close = gcode.find(')', pos + 1);
+            if (close == std::string_view::npos) {
+                // an unterminated comment is dropped
+                break;
             }
-            mode = "comment";
-            last = found;
-            found = str.find_first_of(')', found + 1);
-        }
-        else if (str[found] == ')') {
-            // end of comment
-            std::string gcodestr = str.substr(last, found - last + 1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
-            found = str.find_first_of("(gGmM", found + 1);
-            mode = "command";
-        }
-        else if (mode == "command") {
-            // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+            // Command::setFromGCode() drops nested opening parentheses
+            name.assign(1, '(');
+            for (std::size_t i = pos + 1; i <= close; ++i) {
+                if (gcode[i] != '(') {
+                    name += gcode[i];
+                }
+            }
+            addRow();
+            pos = findCommandStart(gcode, close + 1);
+            continue;
+        }
+
+        std::size_t next = findCommandStart(gcode, pos + 1);
+        std::size_t end = next == std::string_view::npos ? gcode.size() : next;
+        char key = toUpper(gcode[pos]);
+        bool command = true;
+        for (std::size_t i = pos + 1; i < end; ++i) {
+            const char* c = gcode.data() + i;
+            if (isValueChar(*c)) {
+                value.add(c);
+            }
+            else if (*c == ')') {
+                // like Command::setFromGCode()
+                key = '(';
+                value.add(c);
+            }
+            else if (isAlpha(*c)) {
+                if (value.empty()) {
+                    throw Base::BadFormatError(command ? "Badly formatted GCode command"
+                                                       : "Badly formatted GCode argument");
+                }
+                if (command) {
+                    name.assign(1, key);
+                    name += value.view();
+                    command = false;
+                }
+                else {
+                    setParam(key);
+                }
+                value.clear();
+                key = toUpper(*c);
+            }
+        }
+        if (value.empty()) {
+            throw Base::BadFormatError("Badly formatted GCode argument");
+        }
+        if (command) {
+            name.assign(1, key);
+            name += value.view();
+        }
+        else {
+            setParam(key);
+        }
+        addRow();
+        pos = next;
+    }
+}
+
+void Toolpath::appendRows(const Toolpath& other, unsigned int scaled)
+{
+    std::size_t first = getSize();
+    std::vector<std::uint32_t> opcodeMap;
+    opcodeMap.reserve(other.names.size());
+    for (const auto& name : other.names) {
+        opcodeMap.push_back(internName(name));
+    }
+    for (auto opcode : other.opcodes) {
+        opcodes.push_back(opcodeMap[opcode]);
+    }
+    masks.insert(masks.end(), other.masks.begin(), other.masks.end());
+    for (int col = 0; col < CommandView::ColumnCount; ++col) {
+        columns[col].insert(columns[col].end(), other.columns[col].begin(), other.columns[col].end());
+        if (isLength(columnNames[col])) {
+            for (std::size_t i = first; i < first + scaled; ++i) {
+                columns[col][i] *= inch;
             }
-            last = found;
-            found = str.find_first_of("(gGmM", found + 1);
         }
     }
-    // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last, std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
+
+    std::size_t base = extras.size();
+    extras.insert(extras.end(), other.extras.begin(), other.extras.end());
+    for (std::size_t i = base; i < base + other.extraOffsets[scaled]; ++i) {
+        if (isLength(extras[i].first[0])) {
+            extras[i].second *= inch;
+        }
+    }
+    for (std::size_t i = 1; i < other.extraOffsets.size(); ++i) {
+        extraOffsets.push_back(static_cast<std::uint32_t>(base + other.extraOffsets[i]));
+    }
+}
+
+void Toolpath::setFromGCode(const std::string& instr)
+{
+    clear();
+
+    std::vector<std::string_view> chunks = splitGCode(instr);
+    if (chunks.size() == 1) {
+        int units = 0;
+        unsigned int unscaled = 0;
+        parseGCode(instr, units, unscaled);
+        recalculate();
+        return;
+    }
+
+    // Parse the chunks in parallel. The G20/G21 mode at the start of a chunk is only known after
+    // the chunks before it are parsed, so it is resolved while the chunks are joined.
+    int count = static_cast<int>(chunks.size());
+    std::vector<Toolpath> parts(count);
+    std::vector<int> units(count, -1);
+    std::vector<unsigned int> unscaled(count, 0);
+    std::vector<std::exception_ptr> errors(count);
+    units[0] = 0;
+    OSD_Parallel::For(0, count, [&](int i) {
+        try {
+            parts[i].parseGCode(chunks[i], units[i], unscaled[i]);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+
+    bool inches = false;
+    for (int i = 0; i < count; ++i) {
+        // keep the commands before an error, like parsing them one by one
+        appendRows(parts[i], inches ? unscaled[i] : 0);
+        if (errors[i]) {
+            recalculate();
+            std::rethrow_exception(errors[i]);
+        }
+        if (units[i] >= 0) {
+            inches = units[i] == 1;
         }
     }
     recalculate();
@@ -381,19 +915,18 @@ void Toolpath::setFromGCode(const std::string instr)
 
 std::string Toolpath::toGCode() const
 {
-    std::string result;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        result += (*it)->toGCode();
-        result += "\n";
+    std::stringstream str;
+    for (unsigned int i = 0; i < getSize(); ++i) {
+        CommandView(*this, i).writeGCode(str);
+        str << "\n";
     }
-    return result;
+    return str.str();
 }
 
 void Toolpath::recalculate()  // recalculates the path cache
 {
 
-    if (vpcCommands.empty()) {
+    if (opcodes.empty()) {
         return;
     }
 
@@ -481,7 +1014,7 @@ void Toolpath::Save(Writer& writer) const
         writer.incInd();
         saveCenter(writer, center);
         for (unsigned int i = 0; i < getSize(); i++) {
-            vpcCommands[i]->Save(writer);
+            getCommand(i).Save(writer);
         }
         writer.decInd();
     }
@@ -498,10 +1031,11 @@ void Toolpath::Save(Writer& writer) const
 
 void Toolpath::SaveDocFile(Base::Writer& writer) const
 {
-    if (toGCode().empty()) {
+    std::string gcode = toGCode();
+    if (gcode.empty()) {
         return;
     }
-    writer.Stream() << toGCode();
+    writer.Stream() << gcode;
 }
 
 void Toolpath::Restore(XMLReader& reader)
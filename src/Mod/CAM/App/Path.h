@@ -24,6 +24,14 @@
 #ifndef PATH_Path_H
 #define PATH_Path_H
 
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include <Base/BoundBox.h>
 #include <Base/Persistence.h>
 #include <Base/Vector3D.h>
@@ -34,7 +42,67 @@
 namespace Path
 {
 
-/** The representation of a CNC Toolpath */
+class Toolpath;
+
+/** A read-only view of a command stored in a Toolpath
+ *
+ * The view is only valid as long as the toolpath is not modified. Use Toolpath::getCommand()
+ * to get an independent copy of the command.
+ */
+class PathExport CommandView
+{
+public:
+    /// The parameters that are stored in a column of their own
+    enum Column
+    {
+        X,
+        Y,
+        Z,
+        A,
+        B,
+        C,
+        I,
+        J,
+        K,
+        F,
+        ColumnCount
+    };
+
+    CommandView(const Toolpath& path, unsigned int row)
+        : path(&path)
+        , row(row)
+    {}
+
+    const std::string& getName() const;
+    bool has(Column col) const;
+    double getParam(Column col, double fallback = 0.0) const;
+    // these assume the name is upper case, like Command::getParam()
+    bool has(const std::string& name) const;
+    double getParam(const std::string& name, double fallback = 0.0) const;
+
+    Base::Placement getPlacement(const Base::Vector3d pos = Base::Vector3d()) const;
+    Base::Vector3d getCenter() const;
+    std::string toGCode(int precision = 6, bool padzero = true) const;
+    void writeGCode(std::ostream& str, int precision = 6, bool padzero = true) const;
+    Command toCommand() const;
+
+    /// Returns the column of a parameter name or ColumnCount if it has none
+    static int columnOf(const std::string& name);
+    static int columnOf(char name);
+
+private:
+    const Toolpath* path;
+    unsigned int row;
+};
+
+/** The representation of a CNC Toolpath
+ *
+ * The commands are stored in columns rather than as Command objects: the index of the command
+ * name, a bit mask of the parameters present, one column of doubles for each of the parameters
+ * X, Y, Z, A, B, C, I, J, K and F, and a list of the remaining parameters of each command.
+ * Paths with millions of moves therefore take a fraction of the memory and are cheap to copy.
+ * CommandView gives access to a stored command without converting it back to a Command.
+ */
 
 class PathExport Toolpath: public Base::Persistence
 {
@@ -63,22 +131,23 @@ public:
     double getCycleTime(double, double, double, double);  // return the Cycle Time (s) of the Path
     void recalculate();                                   // recalculates the points
     void
-    setFromGCode(const std::string);  // sets the path from the contents of the given GCode string
+    setFromGCode(const std::string&);  // sets the path from the contents of the given GCode string
     std::string toGCode() const;      // gets a gcode string representation from the Path
     Base::BoundBox3d getBoundBox() const;
+    void reserve(unsigned int size);  // reserves the memory for the given number of commands
 
     // shortcut functions
     unsigned int getSize() const
     {
-        return vpcCommands.size();
+        return opcodes.size();
     }
-    const std::vector<Command*>& getCommands() const
+    CommandView getCommandView(unsigned int pos) const
     {
-        return vpcCommands;
+        return CommandView(*this, pos);
     }
-    const Command& getCommand(unsigned int pos) const
+    Command getCommand(unsigned int pos) const
     {
-        return *vpcCommands[pos];
+        return getCommandView(pos).toCommand();
     }
 
     // support for rotation
@@ -91,10 +160,31 @@ public:
     static const int SchemaVersion = 2;
 
 protected:
-    std::vector<Command*> vpcCommands;
+    std::uint32_t internName(const std::string& name);
+    void insertRow(const Command& Cmd, unsigned int pos);
+    // appends the commands of a piece of G-code that starts at a command, units is the G20/G21
+    // mode at its start or -1 if unknown, the commands before the first G20/G21 are not scaled
+    // then and counted in unscaled
+    void parseGCode(std::string_view gcode, int& units, unsigned int& unscaled);
+    // appends the commands of other, the first scaled of them are converted from inches
+    void appendRows(const Toolpath& other, unsigned int scaled);
+
+    // the distinct command names, a path usually only has a few of them
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::uint32_t> nameIndex;
+    // one entry per command
+    std::vector<std::uint32_t> opcodes;
+    std::vector<std::uint16_t> masks;
+    std::array<std::vector<double>, CommandView::ColumnCount> columns;
+    // the other parameters of command i are extras[extraOffsets[i]] to extras[extraOffsets[i+1]],
+    // sorted by name
+    std::vector<std::uint32_t> extraOffsets;
+    std::vector<std::pair<std::string, double>> extras;
     Base::Vector3d center;
     // KDL::Path_Composite *pcPath;
 
+    friend class CommandView;
+
     /*
     inline  KDL::Frame toFrame(const Base::Placement &To){
         return KDL::Frame(KDL::Rotation::Quaternion(To.getRotation()[0],
@@ -150,34 +150,25 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
     for (unsigned int i = 0; i < tp.getSize(); i++) {
         std::deque<Base::Vector3d> points;
 
-        const Path::Command& cmd = tp.getCommand(i);
-        const std::string& name = cmd.Name;
+        const Path::CommandView cmd = tp.getCommandView(i);
+        const std::string& name = cmd.getName();
         Base::Vector3d next = cmd.getPlacement().getPosition();
-        double a = A;
-        double b = B;
-        double c = C;
+        double a = cmd.getParam(CommandView::A, A);
+        double b = cmd.getParam(CommandView::B, B);
+        double c = cmd.getParam(CommandView::C, C);
 
         if (!absolute) {
             next = last + next;
         }
-        if (!cmd.has("X")) {
+        if (!cmd.has(CommandView::X)) {
             next.x = last.x;
         }
-        if (!cmd.has("Y")) {
+        if (!cmd.has(CommandView::Y)) {
             next.y = last.y;
         }
-        if (!cmd.has("Z")) {
+        if (!cmd.has(CommandView::Z)) {
             next.z = last.z;
         }
-        if (cmd.has("A")) {
-            a = cmd.getValue("A");
-        }
-        if (cmd.has("B")) {
-            b = cmd.getValue("B");
-        }
-        if (cmd.has("C")) {
-            c = cmd.getValue("C");
-        }
 
         Base::Rotation nrot = yawPitchRoll(a, b, c);
 
@@ -319,7 +310,7 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
             // drill,tap,bore
             double r = 0;
             if (cmd.has("R")) {
-                r = cmd.getValue("R");
+                r = cmd.getParam("R");
             }
 
             std::deque<Base::Vector3d> plist;
@@ -357,7 +348,7 @@ void PathSegmentWalker::walk(PathSegmentVisitor& cb, const Base::Vector3d& start
 
             double q;
             if (cmd.has("Q")) {
-                q = cmd.getValue("Q");
+                q = cmd.getParam("Q");
                 if (q > 0) {
                     Base::Vector3d temp(next);
                     for (temp.*pz = r; temp.*pz > next.*pz; temp.*pz -= q) {
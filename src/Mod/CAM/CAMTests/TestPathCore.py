@@ -125,6 +125,101 @@ G0 Z0.500000
         p.setFromGCode(lines)
         self.assertEqual(p.toGCode(), output)
 
+    def test20(self):
+        """Test editing the commands of a Path"""
+
+        c1 = Path.Command("G81", {"X": 1, "Y": 2, "Z": -3, "R": 2, "Q": 0.5})
+        c2 = Path.Command("G1", {"X": 5, "F": 100})
+        c3 = Path.Command("(a comment)")
+        p = Path.Path([c1, c2])
+
+        p = p.insertCommand(c3, 1)
+        self.assertEqual(
+            str(p.Commands),
+            "[Command G81 [ Q:0.5 R:2 X:1 Y:2 Z:-3 ], Command (a comment) [ ], "
+            "Command G1 [ F:100 X:5 ]]",
+        )
+        self.assertEqual(
+            p.toGCode(),
+            "G81 Q0.500000 R2.000000 X1.000000 Y2.000000 Z-3.000000\n"
+            "(a comment)\n"
+            "G1 F100.000000 X5.000000\n",
+        )
+
+        p = p.deleteCommand(0)
+        self.assertEqual(str(p.Commands), "[Command (a comment) [ ], Command G1 [ F:100 X:5 ]]")
+        p = p.deleteCommand()
+        self.assertEqual(str(p.Commands), "[Command (a comment) [ ]]")
+
+        # the commands of a path are copies
+        c = p.Commands[0]
+        c.Name = "G0"
+        self.assertEqual(p.Commands[0].Name, "(a comment)")
+
+    def test30(self):
+        """Test Path from gcode with comments and units"""
+
+        p = Path.Path()
+        p.setFromGCode("G0 Z5 (start (of) cut) G20 g1x1y-0.5 F10 M3 S1000 G21 G1 X1")
+        self.assertEqual(
+            p.toGCode(),
+            "G0 Z5.000000\n"
+            "(start of)\n"
+            "G1 F254.000000 X25.400000 Y-12.700000\n"
+            "M3 S1000.000000\n"
+            "G1 X1.000000\n",
+        )
+
+    def test31(self):
+        """Test Path from a large gcode program that is parsed in chunks"""
+
+        def move(i):
+            x = (i % 997) * 0.125
+            y = (i % 991) * -0.25
+            if i % 3 == 0:
+                return "G0 Z%.3f" % (i % 17)
+            return "g1x%.4fY%.4f F%d" % (x, y, 100 + i % 50)
+
+        pieces = []
+        inches = False
+        for i in range(170000):
+            if i % 1009 == 0:
+                inches = not inches
+                pieces.append("G20" if inches else "G21")
+            pieces.append(move(i))
+        size = sum(len(piece) + 1 for piece in pieces)
+
+        # A program of 3 to 4 MB is split into three chunks of the same size. Put a comment that
+        # contains command letters over each split target, with a G20 right before it, so that
+        # the chunks after it start inside a comment and in inches.
+        comment = "(tool change G1 X5 M6 T2 " + "x" * 3000 + ")"
+        total = size + 2 * (len(comment) + 4 + 1)
+        self.assertGreater(total, 3 << 20)
+        self.assertLess(total, 4 << 20)
+        for n in (2, 1):
+            target = n * total // 3 - len(comment) // 2 - (n - 1) * (len(comment) + 5)
+            pos = 0
+            index = 0
+            while pos < target:
+                pos += len(pieces[index]) + 1
+                index += 1
+            pieces[index:index] = ["G20", comment]
+
+        # the commands after a G20 are scaled, which matches parsing the pieces one by one
+        expected = []
+        inches = False
+        for piece in pieces:
+            if piece in ("G20", "G21"):
+                inches = piece == "G20"
+                continue
+            single = Path.Path()
+            single.setFromGCode(("G20 " if inches else "") + piece)
+            expected.append(single.toGCode())
+
+        p = Path.Path()
+        p.setFromGCode(" ".join(pieces))
+        self.assertEqual(p.toGCode(), "".join(expected))
+
     def test50(self):
         """Test Path.Length calculation"""
         commands = []
@@ -22,7 +22,12 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
+
+#include <QThread>
+#include <QtConcurrentMap>
 
 #include <FCConfig.h>
 
@@ -69,6 +74,96 @@ using MeshCore::MeshFacetIterator;
 using MeshCore::MeshKernel;
 using MeshCore::MeshPointIterator;
 
+namespace
+{
+
+// Calls func for the indices 0 to count-1 in parallel. The sequencer must not be driven from
+// worker threads, so the indices are processed in batches and the progress is reported from
+// the calling thread after each batch.
+template<typename Func>
+void parallelForWithProgress(const char* text, std::size_t count, Func func)
+{
+    Base::SequencerLauncher seq(text, count);
+    std::size_t batchSize = std::max<std::size_t>(1, 4 * QThread::idealThreadCount());
+    std::vector<std::size_t> indices;
+    for (std::size_t start = 0; start < count; start += batchSize) {
+        indices.resize(std::min(batchSize, count - start));
+        std::iota(indices.begin(), indices.end(), start);
+        QtConcurrent::blockingMap(indices, func);
+        seq.setProgress(start + indices.size());
+    }
+}
+
+void logMessages(const std::vector<std::string>& messages)
+{
+    for (const auto& msg : messages) {
+        Base::Console().log("%s", msg.c_str());
+    }
+}
+
+// Projects the point along the normal of the facet and keeps the result if it is closer than
+// the ones found so far
+void projectToFacet(const MeshKernel& MeshK,
+                    MeshCore::FacetIndex index,
+                    const Base::Vector3f& Pnt,
+                    float& MinLength,
+                    Base::Vector3f& Rslt,
+                    MeshCore::FacetIndex& FaceIndex)
+{
+    Base::Vector3f TempResultPoint;
+    MeshGeomFacet facet = MeshK.GetFacet(index);
+    // try to project (with angle) to the face
+    if (facet.Foraminate(Pnt, facet.GetNormal(), TempResultPoint)) {
+        // distance to the projected point
+        float Dist = (Pnt - TempResultPoint).Length();
+        if (Dist < MinLength) {
+            // remember the point with the closest distance
+            MinLength = Dist;
+            Rslt = TempResultPoint;
+            FaceIndex = index;
+        }
+    }
+}
+
+// The projection along the facet normal is the point of the facet closest to Pnt. So a facet
+// can only improve the result if it reaches into the box around Pnt whose half size is the
+// current distance. The box grows until it holds such a facet or contains the whole grid.
+bool findStartPointInGrid(const MeshKernel& MeshK,
+                          const MeshFacetGrid& rGrid,
+                          const Base::Vector3f& Pnt,
+                          Base::Vector3f& Rslt,
+                          MeshCore::FacetIndex& FaceIndex)
+{
+    if (MeshK.CountFacets() == 0) {
+        return false;
+    }
+
+    float fLenX {}, fLenY {}, fLenZ {};
+    rGrid.GetGridLengths(fLenX, fLenY, fLenZ);
+    Base::BoundBox3f clGridBox = rGrid.GetBoundBox();
+    float fRadius = std::max({fLenX, fLenY, fLenZ});
+    if (fRadius <= 0.0F) {
+        fRadius = std::max(clGridBox.CalcDiagonalLength(), 1.0F);
+    }
+
+    float MinLength = std::numeric_limits<float>::max();
+    while (true) {
+        Base::BoundBox3f clBox(Pnt, fRadius);
+        std::set<MeshCore::ElementIndex> facets;
+        rGrid.Inside(clBox, facets);
+        for (MeshCore::ElementIndex index : facets) {
+            projectToFacet(MeshK, index, Pnt, MinLength, Rslt, FaceIndex);
+        }
+        if (MinLength <= fRadius || clBox.IsInBox(clGridBox)) {
+            break;
+        }
+        fRadius *= 2.0F;
+    }
+    return MinLength != std::numeric_limits<float>::max();
+}
+
+}  // namespace
+
 CurveProjector::CurveProjector(const TopoDS_Shape& aShape, const MeshKernel& pMesh)
     : _Shape(aShape)
     , _Mesh(pMesh)
@@ -103,16 +198,55 @@ CurveProjectorShape::CurveProjectorShape(const TopoDS_Shape& aShape, const MeshK
 
 void CurveProjectorShape::Do()
 {
+    std::vector<TopoDS_Edge> edges;
     TopExp_Explorer Ex;
     for (Ex.Init(_Shape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        projectCurve(aEdge, mvEdgeSplitPoints[aEdge]);
+        edges.push_back(TopoDS::Edge(Ex.Current()));
+    }
+
+    if (edges.empty() || _Mesh.CountFacets() == 0) {
+        return;
+    }
+
+    // the start points of all edges are looked up in the same grid
+    MeshAlgorithm clAlg(_Mesh);
+    float fAvgLen = clAlg.GetAverageEdgeLength();
+    MeshFacetGrid cGrid(_Mesh, 5.0f * fAvgLen);
+
+    // the walk of an edge over the mesh doesn't depend on the other edges
+    std::vector<std::vector<FaceSplitEdge>> splitEdges(edges.size());
+    std::vector<std::vector<std::string>> messages(edges.size());
+    parallelForWithProgress("Project curve on mesh", edges.size(), [&](std::size_t index) {
+        projectCurve(edges[index], cGrid, splitEdges[index], messages[index]);
+    });
+
+    for (std::size_t i = 0; i < edges.size(); i++) {
+        logMessages(messages[i]);
+        std::vector<FaceSplitEdge>& vSplitEdges = mvEdgeSplitPoints[edges[i]];
+        vSplitEdges.insert(vSplitEdges.end(), splitEdges[i].begin(), splitEdges[i].end());
     }
 }
 
 
 void CurveProjectorShape::projectCurve(const TopoDS_Edge& aEdge,
                                        std::vector<FaceSplitEdge>& vSplitEdges)
+{
+    if (_Mesh.CountFacets() == 0) {
+        return;
+    }
+
+    MeshAlgorithm clAlg(_Mesh);
+    float fAvgLen = clAlg.GetAverageEdgeLength();
+    MeshFacetGrid cGrid(_Mesh, 5.0f * fAvgLen);
+    std::vector<std::string> messages;
+    projectCurve(aEdge, cGrid, vSplitEdges, messages);
+    logMessages(messages);
+}
+
+void CurveProjectorShape::projectCurve(const TopoDS_Edge& aEdge,
+                                       const MeshFacetGrid& rGrid,
+                                       std::vector<FaceSplitEdge>& vSplitEdges,
+                                       std::vector<std::string>& messages)
 {
     Standard_Real fFirst, fLast;
     Handle(Geom_Curve) hCurve = BRep_Tool::Curve(aEdge, fFirst, fLast);
@@ -129,7 +263,7 @@ void CurveProjectorShape::projectCurve(const TopoDS_Edge& aEdge,
     MeshCore::FacetIndex auNeighboursIdx[3];
     bool GoOn;
 
-    if (!findStartPoint(_Mesh, cStartPoint, cResultPoint, uStartFacetIdx)) {
+    if (!findStartPoint(_Mesh, rGrid, cStartPoint, cResultPoint, uStartFacetIdx)) {
         return;
     }
 
@@ -199,10 +333,11 @@ void CurveProjectorShape::projectCurve(const TopoDS_Edge& aEdge,
                 }
                 else if (Alg.NbPoints() > 1) {
                     PointOnEdge[i] = Base::Vector3f(std::numeric_limits<float>::max(), 0, 0);
-                    Base::Console().log("MeshAlgos::projectCurve(): More then one intersection in "
-                                        "Facet %lu, Edge %d\n",
-                                        uCurFacetIdx,
-                                        i);
+                    messages.push_back(
+                        fmt::sprintf("MeshAlgos::projectCurve(): More then one intersection in "
+                                     "Facet %lu, Edge %d\n",
+                                     uCurFacetIdx,
+                                     i));
                 }
             }
         }
@@ -220,8 +355,9 @@ void CurveProjectorShape::projectCurve(const TopoDS_Edge& aEdge,
             GoOn = true;
         }
         else {
-            Base::Console().log("MeshAlgos::projectCurve(): Possible reentry in Facet %lu\n",
-                                uCurFacetIdx);
+            messages.push_back(
+                fmt::sprintf("MeshAlgos::projectCurve(): Possible reentry in Facet %lu\n",
+                             uCurFacetIdx));
         }
 
         if (uCurFacetIdx == uStartFacetIdx) {
@@ -259,6 +395,15 @@ bool CurveProjectorShape::findStartPoint(const MeshKernel& MeshK,
     return bHit;
 }
 
+bool CurveProjectorShape::findStartPoint(const MeshKernel& MeshK,
+                                         const MeshFacetGrid& rGrid,
+                                         const Base::Vector3f& Pnt,
+                                         Base::Vector3f& Rslt,
+                                         MeshCore::FacetIndex& FaceIndex)
+{
+    return findStartPointInGrid(MeshK, rGrid, Pnt, Rslt, FaceIndex);
+}
+
 
 //**************************************************************************
 //**************************************************************************
@@ -388,6 +533,15 @@ bool CurveProjectorSimple::findStartPoint(const MeshKernel& MeshK,
     return bHit;
 }
 
+bool CurveProjectorSimple::findStartPoint(const MeshKernel& MeshK,
+                                          const MeshFacetGrid& rGrid,
+                                          const Base::Vector3f& Pnt,
+                                          Base::Vector3f& Rslt,
+                                          MeshCore::FacetIndex& FaceIndex)
+{
+    return findStartPointInGrid(MeshK, rGrid, Pnt, Rslt, FaceIndex);
+}
+
 //**************************************************************************
 //**************************************************************************
 // Separator for CurveProjectorSimple classes
@@ -406,79 +560,103 @@ CurveProjectorWithToolMesh::CurveProjectorWithToolMesh(const TopoDS_Shape& aShap
 
 void CurveProjectorWithToolMesh::Do()
 {
-    TopExp_Explorer Ex;
-    std::vector<MeshGeomFacet> cVAry;
+    // sample all edges first and project the points of all edges at once
+    std::vector<LineSeg> lineSegs;
+    std::vector<std::size_t> offsets {0};
 
+    TopExp_Explorer Ex;
     for (Ex.Init(_Shape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
         const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        makeToolMesh(aEdge, cVAry);
+        sampleCurve(aEdge, lineSegs);
+        offsets.push_back(lineSegs.size());
+    }
+
+    projectSamples(lineSegs);
+
+    std::vector<MeshGeomFacet> cVAry;
+    for (std::size_t i = 1; i < offsets.size(); i++) {
+        addToolFacets(lineSegs.begin() + offsets[i - 1], lineSegs.begin() + offsets[i], cVAry);
     }
 
     ToolMesh.AddFacets(cVAry);
 }
 
-// projectToNeighbours(Handle(Geom_Curve) hCurve,float pos
-
 void CurveProjectorWithToolMesh::makeToolMesh(const TopoDS_Edge& aEdge,
                                               std::vector<MeshGeomFacet>& cVAry)
+{
+    std::vector<LineSeg> LineSegs;
+    sampleCurve(aEdge, LineSegs);
+    projectSamples(LineSegs);
+    addToolFacets(LineSegs.begin(), LineSegs.end(), cVAry);
+}
+
+void CurveProjectorWithToolMesh::sampleCurve(const TopoDS_Edge& aEdge,
+                                             std::vector<LineSeg>& LineSegs) const
 {
     Standard_Real fBegin, fEnd;
     Handle(Geom_Curve) hCurve = BRep_Tool::Curve(aEdge, fBegin, fEnd);
     float fLen = float(fEnd - fBegin);
-    Base::Vector3f cResultPoint;
 
-    unsigned long ulNbOfPoints = 15, PointCount = 0 /*,uCurFacetIdx*/;
+    unsigned long ulNbOfPoints = 15;
 
-    std::vector<LineSeg> LineSegs;
+    for (unsigned long i = 0; i < ulNbOfPoints; i++) {
+        gp_Pnt gpPt = hCurve->Value(fBegin + (fLen * float(i)) / float(ulNbOfPoints - 1));
+        LineSeg s;
+        s.p = Base::Vector3f((float)gpPt.X(), (float)gpPt.Y(), (float)gpPt.Z());
+        LineSegs.push_back(s);
+    }
+}
 
-    MeshFacetIterator It(_Mesh);
+void CurveProjectorWithToolMesh::projectSamples(std::vector<LineSeg>& LineSegs) const
+{
+    if (LineSegs.empty() || _Mesh.CountFacets() == 0) {
+        return;
+    }
 
-    Base::SequencerLauncher seq("Building up tool mesh...", ulNbOfPoints + 1);
+    const float fMaxDist = 0.5F;
 
-    std::map<MeshCore::FacetIndex, std::vector<Base::Vector3f>> FaceProjctMap;
+    // only the facets near a curve point can contribute to its normal
+    MeshAlgorithm clAlg(_Mesh);
+    float fAvgLen = clAlg.GetAverageEdgeLength();
+    MeshFacetGrid cGrid(_Mesh, 5.0f * fAvgLen);
 
-    for (unsigned long i = 0; i < ulNbOfPoints; i++) {
-        seq.next();
-        gp_Pnt gpPt = hCurve->Value(fBegin + (fLen * float(i)) / float(ulNbOfPoints - 1));
-        Base::Vector3f LinePoint((float)gpPt.X(), (float)gpPt.Y(), (float)gpPt.Z());
+    parallelForWithProgress("Building up tool mesh...", LineSegs.size(), [&](std::size_t index) {
+        LineSeg& s = LineSegs[index];
+        Base::BoundBox3f cBox(s.p, 2.0F * fMaxDist);
+        std::vector<MeshCore::FacetIndex> facets;
+        cGrid.Inside(cBox, facets);
 
+        Base::Vector3f cResultPoint;
         Base::Vector3f ResultNormal;
-
-        // go through the whole Mesh
-        for (It.Init(); It.More(); It.Next()) {
+        for (MeshCore::FacetIndex index : facets) {
+            MeshGeomFacet cFacet = _Mesh.GetFacet(index);
             // try to project (with angle) to the face
-            if (It->IntersectWithLine(
-                    Base::Vector3f((float)gpPt.X(), (float)gpPt.Y(), (float)gpPt.Z()),
-                    It->GetNormal(),
-                    cResultPoint)) {
-                if (Base::Distance(LinePoint, cResultPoint) < 0.5) {
-                    ResultNormal += It->GetNormal();
+            if (cFacet.IntersectWithLine(s.p, cFacet.GetNormal(), cResultPoint)) {
+                if (Base::Distance(s.p, cResultPoint) < fMaxDist) {
+                    ResultNormal += cFacet.GetNormal();
                 }
             }
         }
-        LineSeg s;
-        s.p = Base::Vector3f((float)gpPt.X(), (float)gpPt.Y(), (float)gpPt.Z());
         s.n = ResultNormal.Normalize();
-        LineSegs.push_back(s);
-    }
-
-    Base::Console().log("Projection map [%d facets with %d points]\n",
-                        FaceProjctMap.size(),
-                        PointCount);
-
+    });
+}
 
+void CurveProjectorWithToolMesh::addToolFacets(std::vector<LineSeg>::const_iterator first,
+                                               std::vector<LineSeg>::const_iterator last,
+                                               std::vector<MeshGeomFacet>& cVAry)
+{
     // build up the new mesh
     Base::Vector3f lp(std::numeric_limits<float>::max(), 0, 0), ln, p1, p2, p3, p4, p5, p6;
     float ToolSize = 0.2f;
 
-    for (const auto& It2 : LineSegs) {
+    for (auto It2 = first; It2 != last; ++It2) {
         if (lp.x != std::numeric_limits<float>::max()) {
             p1 = lp + (ln * (-ToolSize));
             p2 = lp + (ln * ToolSize);
             p3 = lp;
-            p4 = It2.p;
-            p5 = It2.p + (It2.n * (-ToolSize));
-            p6 = It2.p + (It2.n * ToolSize);
+            p4 = It2->p;
+            p5 = It2->p + (It2->n * (-ToolSize));
+            p6 = It2->p + (It2->n * ToolSize);
 
             cVAry.emplace_back(p3, p2, p6);
             cVAry.emplace_back(p3, p6, p4);
@@ -486,8 +664,8 @@ void CurveProjectorWithToolMesh::makeToolMesh(const TopoDS_Edge& aEdge,
             cVAry.emplace_back(p1, p4, p5);
         }
 
-        lp = It2.p;
-        ln = It2.n;
+        lp = It2->p;
+        ln = It2->n;
     }
 }
 
@@ -639,27 +817,29 @@ void MeshProjection::projectToMesh(const TopoDS_Shape& aShape,
     float fAvgLen = clAlg.GetAverageEdgeLength();
     MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
 
+    std::vector<TopoDS_Edge> edges;
     TopExp_Explorer Ex;
-
-    int iCnt = 0;
     for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        iCnt++;
+        edges.push_back(TopoDS::Edge(Ex.Current()));
     }
 
-    Base::SequencerLauncher seq("Project curve on mesh", iCnt);
-
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
+    // the edges are projected independently of each other against the shared grid
+    std::vector<PolyLine> polylines(edges.size());
+    std::vector<std::vector<std::string>> messages(edges.size());
+    parallelForWithProgress("Project curve on mesh", edges.size(), [&](std::size_t index) {
         std::vector<SplitEdge> rSplitEdges;
-        projectEdgeToEdge(aEdge, fMaxDist, cGrid, rSplitEdges);
-        PolyLine polyline;
+        projectEdgeToEdge(edges[index], fMaxDist, cGrid, rSplitEdges, messages[index]);
+        PolyLine& polyline = polylines[index];
         polyline.points.reserve(rSplitEdges.size());
-        for (auto it : rSplitEdges) {
+        for (const auto& it : rSplitEdges) {
             polyline.points.push_back(it.cPt);
         }
-        rPolyLines.push_back(polyline);
-        seq.next();
+    });
+
+    for (const auto& it : messages) {
+        logMessages(it);
     }
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
 }
 
 void MeshProjection::projectOnMesh(const std::vector<Base::Vector3f>& pointsIn,
@@ -747,60 +927,17 @@ void MeshProjection::projectParallelToMesh(const TopoDS_Shape& aShape,
                                            const Base::Vector3f& dir,
                                            std::vector<PolyLine>& rPolyLines) const
 {
-    // calculate the average edge length and create a grid
-    MeshAlgorithm clAlg(_rcMesh);
-    float fAvgLen = clAlg.GetAverageEdgeLength();
-    MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
+    // sample all edges up front and project them in one batch
+    std::vector<PolyLine> aEdges;
     TopExp_Explorer Ex;
-
-    int iCnt = 0;
-    for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
-        iCnt++;
-    }
-
-    Base::SequencerLauncher seq("Project curve on mesh", iCnt);
-
     for (Ex.Init(aShape, TopAbs_EDGE); Ex.More(); Ex.Next()) {
         const TopoDS_Edge& aEdge = TopoDS::Edge(Ex.Current());
-        std::vector<Base::Vector3f> points;
-        discretize(aEdge, points, 5);
-
-        using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
-        std::vector<HitPoint> hitPoints;
-        using HitPoints = std::pair<HitPoint, HitPoint>;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size() - 2];
-                    HitPoint p2 = hitPoints[hitPoints.size() - 1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
-        }
-
-        MeshCore::MeshProjection meshProjection(_rcMesh);
         PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid,
-                                                 it.first.first,
-                                                 it.first.second,
-                                                 it.second.first,
-                                                 it.second.second,
-                                                 dir,
-                                                 points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
-            }
-        }
-        rPolyLines.push_back(polyline);
-
-        seq.next();
+        discretize(aEdge, polyline.points, 5);
+        aEdges.push_back(std::move(polyline));
     }
+
+    projectParallelToMesh(aEdges, dir, rPolyLines);
 }
 
 void MeshProjection::projectParallelToMesh(const std::vector<PolyLine>& aEdges,
@@ -812,53 +949,81 @@ void MeshProjection::projectParallelToMesh(const std::vector<PolyLine>& aEdges,
     float fAvgLen = clAlg.GetAverageEdgeLength();
     MeshFacetGrid cGrid(_rcMesh, 5.0f * fAvgLen);
 
-    Base::SequencerLauncher seq("Project curve on mesh", aEdges.size());
-
-    for (const auto& it : aEdges) {
-        std::vector<Base::Vector3f> points = it.points;
-
-        using HitPoint = std::pair<Base::Vector3f, MeshCore::FacetIndex>;
-        std::vector<HitPoint> hitPoints;
-        using HitPoints = std::pair<HitPoint, HitPoint>;
-        std::vector<HitPoints> hitPointPairs;
-        for (auto it : points) {
-            Base::Vector3f result;
-            MeshCore::FacetIndex index;
-            if (clAlg.NearestFacetOnRay(it, dir, cGrid, result, index)) {
-                hitPoints.emplace_back(result, index);
-
-                if (hitPoints.size() > 1) {
-                    HitPoint p1 = hitPoints[hitPoints.size() - 2];
-                    HitPoint p2 = hitPoints[hitPoints.size() - 1];
-                    hitPointPairs.emplace_back(p1, p2);
-                }
-            }
+    // shoot the rays of the points of all polylines in parallel
+    struct HitPoint
+    {
+        Base::Vector3f point;
+        MeshCore::FacetIndex index;
+        bool hit;
+        std::size_t edge;
+    };
+
+    std::vector<HitPoint> hitPoints;
+    for (std::size_t i = 0; i < aEdges.size(); i++) {
+        for (const auto& it : aEdges[i].points) {
+            hitPoints.push_back({it, MeshCore::FACET_INDEX_MAX, false, i});
+        }
+    }
+
+    QtConcurrent::blockingMap(hitPoints, [&](HitPoint& hp) {
+        Base::Vector3f result;
+        MeshCore::FacetIndex index;
+        hp.hit = clAlg.NearestFacetOnRay(hp.point, dir, cGrid, result, index);
+        if (hp.hit) {
+            hp.point = result;
+            hp.index = index;
         }
+    });
 
+    // consecutive hits of the same polyline define the segments to project
+    struct HitSegment
+    {
+        const HitPoint* p1;
+        const HitPoint* p2;
+        std::vector<Base::Vector3f> points;
+    };
+
+    std::vector<HitSegment> segments;
+    const HitPoint* last = nullptr;
+    for (const auto& it : hitPoints) {
+        if (!it.hit) {
+            continue;
+        }
+        if (last && last->edge == it.edge) {
+            segments.push_back({last, &it, {}});
+        }
+        last = &it;
+    }
+
+    parallelForWithProgress("Project curve on mesh", segments.size(), [&](std::size_t index) {
+        HitSegment& seg = segments[index];
         MeshCore::MeshProjection meshProjection(_rcMesh);
-        PolyLine polyline;
-        for (auto it : hitPointPairs) {
-            points.clear();
-            if (meshProjection.projectLineOnMesh(cGrid,
-                                                 it.first.first,
-                                                 it.first.second,
-                                                 it.second.first,
-                                                 it.second.second,
-                                                 dir,
-                                                 points)) {
-                polyline.points.insert(polyline.points.end(), points.begin(), points.end());
-            }
+        if (!meshProjection.projectLineOnMesh(cGrid,
+                                              seg.p1->point,
+                                              seg.p1->index,
+                                              seg.p2->point,
+                                              seg.p2->index,
+                                              dir,
+                                              seg.points)) {
+            seg.points.clear();
         }
-        rPolyLines.push_back(polyline);
+    });
 
-        seq.next();
+    // stitch the projected segments to one polyline per input polyline
+    std::vector<PolyLine> polylines(aEdges.size());
+    for (const auto& it : segments) {
+        std::vector<Base::Vector3f>& points = polylines[it.p1->edge].points;
+        points.insert(points.end(), it.points.begin(), it.points.end());
     }
+
+    rPolyLines.insert(rPolyLines.end(), polylines.begin(), polylines.end());
 }
 
 void MeshProjection::projectEdgeToEdge(const TopoDS_Edge& aEdge,
                                        float fMaxDist,
                                        const MeshFacetGrid& rGrid,
-                                       std::vector<SplitEdge>& rSplitEdges) const
+                                       std::vector<SplitEdge>& rSplitEdges,
+                                       std::vector<std::string>& messages) const
 {
     std::vector<MeshCore::FacetIndex> auFInds;
     std::map<std::pair<MeshCore::PointIndex, MeshCore::PointIndex>, std::list<MeshCore::FacetIndex>>
@@ -898,12 +1063,9 @@ void MeshProjection::projectEdgeToEdge(const TopoDS_Edge& aEdge,
     MeshPointIterator cPI(_rcMesh);
     MeshFacetIterator cFI(_rcMesh);
 
-    Base::SequencerLauncher seq("Project curve on mesh", pEdgeToFace.size());
     std::map<std::pair<MeshCore::PointIndex, MeshCore::PointIndex>,
              std::list<MeshCore::FacetIndex>>::iterator it;
     for (it = pEdgeToFace.begin(); it != pEdgeToFace.end(); ++it) {
-        seq.next();
-
         // edge points
         MeshCore::PointIndex uE0 = it->first.first;
         cPI.Set(uE0);
@@ -991,7 +1153,7 @@ void MeshProjection::projectEdgeToEdge(const TopoDS_Edge& aEdge,
                     rParamSplitEdges[fSol] = splitEdge;
                 }
                 else if (nCntSol > 1) {
-                    Base::Console().log("More than one possible intersection points\n");
+                    messages.emplace_back("More than one possible intersection points\n");
                 }
             }
         }
@@ -26,6 +26,8 @@
 #define _CurveProjector_h_
 
 #include <limits>
+#include <string>
+#include <vector>
 
 #include <TopoDS_Edge.hxx>
 
@@ -108,10 +110,21 @@ public:
                         const Base::Vector3f& Pnt,
                         Base::Vector3f& Rslt,
                         MeshCore::FacetIndex& FaceIndex);
+    /// Same as above but only tests the facets near \a Pnt that are looked up in \a rGrid
+    bool findStartPoint(const MeshKernel& MeshK,
+                        const MeshCore::MeshFacetGrid& rGrid,
+                        const Base::Vector3f& Pnt,
+                        Base::Vector3f& Rslt,
+                        MeshCore::FacetIndex& FaceIndex);
 
 
 protected:
     void Do() override;
+    /// Can run for several edges at once, the log messages are added to \a messages
+    void projectCurve(const TopoDS_Edge& aEdge,
+                      const MeshCore::MeshFacetGrid& rGrid,
+                      std::vector<FaceSplitEdge>& vSplitEdges,
+                      std::vector<std::string>& messages);
 };
 
 
@@ -137,6 +150,12 @@ public:
                         const Base::Vector3f& Pnt,
                         Base::Vector3f& Rslt,
                         MeshCore::FacetIndex& FaceIndex);
+    /// Same as above but only tests the facets near \a Pnt that are looked up in \a rGrid
+    bool findStartPoint(const MeshKernel& MeshK,
+                        const MeshCore::MeshFacetGrid& rGrid,
+                        const Base::Vector3f& Pnt,
+                        Base::Vector3f& Rslt,
+                        MeshCore::FacetIndex& FaceIndex);
 
 
 protected:
@@ -167,6 +186,12 @@ public:
 
 protected:
     void Do() override;
+    void sampleCurve(const TopoDS_Edge& aEdge, std::vector<LineSeg>& LineSegs) const;
+    /// Computes the mesh normals at the curve points in parallel
+    void projectSamples(std::vector<LineSeg>& LineSegs) const;
+    static void addToolFacets(std::vector<LineSeg>::const_iterator first,
+                              std::vector<LineSeg>::const_iterator last,
+                              std::vector<MeshGeomFacet>& cVAry);
 };
 
 /**
@@ -252,7 +277,8 @@ protected:
     void projectEdgeToEdge(const TopoDS_Edge& aCurve,
                            float fMaxDist,
                            const MeshCore::MeshFacetGrid& rGrid,
-                           std::vector<SplitEdge>& rSplitEdges) const;
+                           std::vector<SplitEdge>& rSplitEdges,
+                           std::vector<std::string>& messages) const;
     bool findIntersection(const Edge&,
                           const Edge&,
                           const Base::Vector3f& dir,
@@ -23,17 +23,33 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <unordered_map>
+#include <boost/functional/hash.hpp>
 
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <BRepBndLib.hxx>
 #include <BRepMesh_IncrementalMesh.hxx>
 #include <BRepTools.hxx>
+#include <BRep_Tool.hxx>
+#include <Bnd_Box.hxx>
+#include <Poly_Triangulation.hxx>
+#include <Precision.hxx>
 #include <Standard_Version.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
+#include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
 
 #include <Base/Console.h>
 #include <Base/Tools.h>
 #include <Mod/Mesh/App/Mesh.h>
-#include <Mod/Part/App/BRepMesh.h>
 #include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "Mesher.h"
 
@@ -120,6 +136,279 @@ int MeshingOutput::sync()
 
 // ----------------------------------------------------------------------------
 
+namespace
+{
+
+using Domain = Part::TopoShape::Domain;
+
+// Minimum number of elements handled by one thread
+constexpr std::size_t minBlockSize = 4096;
+
+std::vector<std::size_t> makeIndices(std::size_t count)
+{
+    std::vector<std::size_t> indices(count);
+    std::iota(indices.begin(), indices.end(), 0);
+    return indices;
+}
+
+/*!
+ * \brief parallelSort
+ * Sorts blocks of the range concurrently and merges neighboured blocks pairwise
+ * until only one is left.
+ */
+template<typename RandomIt, typename Compare>
+void parallelSort(RandomIt first, RandomIt last, Compare comp)
+{
+    using Block = std::pair<RandomIt, RandomIt>;
+    const auto count = static_cast<std::size_t>(last - first);
+    const auto numThreads = static_cast<std::size_t>(std::max(QThread::idealThreadCount(), 1));
+    const std::size_t blockSize = std::max(minBlockSize, count / numThreads + 1);
+
+    std::vector<Block> blocks;
+    for (std::size_t pos = 0; pos < count; pos += blockSize) {
+        blocks.emplace_back(first + pos, first + std::min(pos + blockSize, count));
+    }
+
+    QtConcurrent::blockingMap(blocks, [&comp](Block& block) {
+        std::sort(block.first, block.second, comp);
+    });
+
+    while (blocks.size() > 1) {
+        std::vector<std::size_t> pairs = makeIndices(blocks.size() / 2);
+        QtConcurrent::blockingMap(pairs, [&blocks, &comp](std::size_t index) {
+            const Block& left = blocks[2 * index];
+            const Block& right = blocks[2 * index + 1];
+            std::inplace_merge(left.first, left.second, right.second, comp);
+        });
+
+        std::vector<Block> merged;
+        for (std::size_t index : pairs) {
+            merged.emplace_back(blocks[2 * index].first, blocks[2 * index + 1].second);
+        }
+        if (blocks.size() % 2 != 0) {
+            merged.push_back(blocks.back());
+        }
+        blocks.swap(merged);
+    }
+}
+
+/*!
+ * \brief getDomains
+ * Converts the triangulations of all faces of the shape concurrently. For a face without
+ * a triangulation an empty domain is added so that the domains match the faces.
+ */
+std::vector<Domain> getDomains(const TopoDS_Shape& shape)
+{
+    std::vector<TopoDS_Face> faces;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        faces.push_back(TopoDS::Face(xp.Current()));
+    }
+
+    std::vector<Domain> domains(faces.size());
+    std::vector<std::size_t> indices = makeIndices(faces.size());
+    QtConcurrent::blockingMap(indices, [&faces, &domains](std::size_t index) {
+        std::vector<gp_Pnt> points;
+        std::vector<Poly_Triangle> facets;
+        if (!Part::Tools::getTriangulation(faces[index], points, facets)) {
+            return;
+        }
+
+        Domain& domain = domains[index];
+        domain.points.reserve(points.size());
+        for (const auto& it : points) {
+            domain.points.emplace_back(it.X(), it.Y(), it.Z());
+        }
+
+        domain.facets.reserve(facets.size());
+        for (const auto& it : facets) {
+            Standard_Integer N1, N2, N3;
+            it.Get(N1, N2, N3);
+
+            Data::ComplexGeoData::Facet tria;
+            tria.I1 = N1;
+            tria.I2 = N2;
+            tria.I3 = N3;
+            domain.facets.push_back(tria);
+        }
+    });
+
+    return domains;
+}
+
+/*!
+ * \brief weldDomains
+ * Joins the domains to one mesh. Points of different domains closer than \a tolerance
+ * are merged and degenerated facets are removed. The number of facets taken from each
+ * domain is returned in \a domainSizes.
+ */
+void weldDomains(const std::vector<Domain>& domains,
+                 double tolerance,
+                 MeshCore::MeshPointArray& verts,
+                 MeshCore::MeshFacetArray& faces,
+                 std::vector<std::size_t>& domainSizes)
+{
+    std::vector<std::size_t> pointOffsets(domains.size() + 1, 0);
+    for (std::size_t i = 0; i < domains.size(); i++) {
+        pointOffsets[i + 1] = pointOffsets[i] + domains[i].points.size();
+    }
+
+    std::vector<std::size_t> domainIndices = makeIndices(domains.size());
+    std::vector<Base::Vector3d> points(pointOffsets.back());
+    QtConcurrent::blockingMap(domainIndices, [&](std::size_t index) {
+        std::copy(domains[index].points.begin(),
+                  domains[index].points.end(),
+                  points.begin() + static_cast<std::ptrdiff_t>(pointOffsets[index]));
+    });
+
+    // Sort the points by the cell of a grid with the tolerance as spacing. Coincident
+    // points end up in the same or in adjacent cells.
+    using Cell = std::array<std::int64_t, 3>;
+    std::vector<Cell> cells(points.size());
+    std::vector<std::size_t> pointIndices = makeIndices(points.size());
+    QtConcurrent::blockingMap(pointIndices, [&](std::size_t index) {
+        const Base::Vector3d& pnt = points[index];
+        cells[index] = {static_cast<std::int64_t>(std::floor(pnt.x / tolerance)),
+                        static_cast<std::int64_t>(std::floor(pnt.y / tolerance)),
+                        static_cast<std::int64_t>(std::floor(pnt.z / tolerance))};
+    });
+
+    std::vector<std::size_t> order = pointIndices;
+    parallelSort(order.begin(), order.end(), [&cells](std::size_t i1, std::size_t i2) {
+        if (cells[i1] != cells[i2]) {
+            return cells[i1] < cells[i2];
+        }
+        return i1 < i2;
+    });
+
+    struct CellHash
+    {
+        std::size_t operator()(const Cell& cell) const
+        {
+            std::size_t seed = 0;
+            for (std::int64_t it : cell) {
+                boost::hash_combine(seed, it);
+            }
+            return seed;
+        }
+    };
+
+    // the points of a cell are order[range.first] to order[range.second - 1]
+    std::unordered_map<Cell, std::pair<std::size_t, std::size_t>, CellHash> cellRanges;
+    cellRanges.reserve(order.size());
+    for (std::size_t i = 0; i < order.size();) {
+        std::size_t j = i + 1;
+        while (j < order.size() && cells[order[j]] == cells[order[i]]) {
+            j++;
+        }
+        cellRanges.emplace(cells[order[i]], std::make_pair(i, j));
+        i = j;
+    }
+
+    // Collect for each point the points with a lower index within the tolerance, which may
+    // lie in one of the 26 neighbouring cells if the points are close to a cell boundary.
+    // This is the expensive part of the search and independent for each point.
+    std::vector<std::vector<std::size_t>> candidates(points.size());
+    QtConcurrent::blockingMap(pointIndices, [&](std::size_t index) {
+        const Cell& cell = cells[index];
+        auto& found = candidates[index];
+        for (std::int64_t dx = -1; dx <= 1; dx++) {
+            for (std::int64_t dy = -1; dy <= 1; dy++) {
+                for (std::int64_t dz = -1; dz <= 1; dz++) {
+                    auto range = cellRanges.find({cell[0] + dx, cell[1] + dy, cell[2] + dz});
+                    if (range == cellRanges.end()) {
+                        continue;
+                    }
+                    // the points of a cell are sorted by their index
+                    for (std::size_t i = range->second.first; i < range->second.second; i++) {
+                        std::size_t other = order[i];
+                        if (other >= index) {
+                            break;
+                        }
+                        if (Base::DistanceP2(points[other], points[index])
+                            <= tolerance * tolerance) {
+                            found.push_back(other);
+                        }
+                    }
+                }
+            }
+        }
+        std::sort(found.begin(), found.end());
+    });
+
+    // Map each point to the first candidate that is not mapped itself. This depends on the
+    // points with a lower index but only touches the few points that have candidates.
+    std::vector<std::size_t> mapPoint(points.size());
+    for (std::size_t index = 0; index < points.size(); index++) {
+        mapPoint[index] = index;
+        for (std::size_t other : candidates[index]) {
+            if (mapPoint[other] == other) {
+                mapPoint[index] = other;
+                break;
+            }
+        }
+    }
+
+    // redirect the facets to the welded points and skip degenerated ones
+    std::vector<std::vector<std::array<std::size_t, 3>>> domainFacets(domains.size());
+    QtConcurrent::blockingMap(domainIndices, [&](std::size_t index) {
+        const std::size_t offset = pointOffsets[index];
+        auto& facets = domainFacets[index];
+        facets.reserve(domains[index].facets.size());
+        for (const auto& it : domains[index].facets) {
+            std::array<std::size_t, 3> face {mapPoint[offset + it.I1],
+                                             mapPoint[offset + it.I2],
+                                             mapPoint[offset + it.I3]};
+            if (face[0] != face[1] && face[1] != face[2] && face[2] != face[0]) {
+                facets.push_back(face);
+            }
+        }
+    });
+
+    // remove unreferenced points
+    std::vector<MeshCore::PointIndex> pointIndex(points.size(), MeshCore::POINT_INDEX_MAX);
+    for (const auto& facets : domainFacets) {
+        for (const auto& face : facets) {
+            for (std::size_t it : face) {
+                pointIndex[it] = 0;
+            }
+        }
+    }
+
+    MeshCore::PointIndex numPoints = 0;
+    for (auto& it : pointIndex) {
+        if (it != MeshCore::POINT_INDEX_MAX) {
+            it = numPoints++;
+        }
+    }
+
+    verts.resize(numPoints);
+    QtConcurrent::blockingMap(pointIndices, [&](std::size_t index) {
+        if (pointIndex[index] != MeshCore::POINT_INDEX_MAX) {
+            const Base::Vector3d& pnt = points[index];
+            verts[pointIndex[index]].Set(float(pnt.x), float(pnt.y), float(pnt.z));
+        }
+    });
+
+    std::vector<std::size_t> facetOffsets(domains.size() + 1, 0);
+    domainSizes.resize(domains.size());
+    for (std::size_t i = 0; i < domains.size(); i++) {
+        domainSizes[i] = domainFacets[i].size();
+        facetOffsets[i + 1] = facetOffsets[i] + domainSizes[i];
+    }
+
+    faces.resize(facetOffsets.back());
+    QtConcurrent::blockingMap(domainIndices, [&](std::size_t index) {
+        std::size_t pos = facetOffsets[index];
+        for (const auto& it : domainFacets[index]) {
+            faces[pos++] = MeshCore::MeshFacet(pointIndex[it[0]],
+                                               pointIndex[it[1]],
+                                               pointIndex[it[2]]);
+        }
+    });
+}
+
+}  // namespace
+
 namespace MeshPart
 {
 
@@ -136,25 +425,10 @@ public:
 
     Mesh::MeshObject* create(const std::vector<Part::TopoShape::Domain>& domains) const
     {
-        std::vector<Base::Vector3d> points;
-        std::vector<Part::TopoShape::Facet> facets;
-        Part::BRepMesh mesh;
-        mesh.getFacesFromDomains(domains, points, facets);
-
-        MeshCore::MeshFacetArray faces;
-        faces.reserve(facets.size());
-        std::transform(facets.cbegin(),
-                       facets.cend(),
-                       std::back_inserter(faces),
-                       [](const Part::TopoShape::Facet& face) {
-                           return MeshCore::MeshFacet(face.I1, face.I2, face.I3);
-                       });
-
         MeshCore::MeshPointArray verts;
-        verts.reserve(points.size());
-        for (const auto& it : points) {
-            verts.emplace_back(float(it.x), float(it.y), float(it.z));
-        }
+        MeshCore::MeshFacetArray faces;
+        std::vector<std::size_t> domainSizes;
+        weldDomains(domains, Precision::Confusion(), verts, faces, domainSizes);
 
         MeshCore::MeshKernel kernel;
         kernel.Adopt(verts, faces, true);
@@ -171,16 +445,14 @@ public:
 
         // add a segment for the face
         if (createSegm || this->segments) {
-            auto segments = mesh.createSegments();
-            meshSegments.reserve(segments.size());
-            std::transform(segments.cbegin(),
-                           segments.cend(),
-                           std::back_inserter(meshSegments),
-                           [](const Part::BRepMesh::Segment& segm) {
-                               std::vector<MeshCore::FacetIndex> faces;
-                               faces.insert(faces.end(), segm.cbegin(), segm.cend());
-                               return faces;
-                           });
+            meshSegments.reserve(domainSizes.size());
+            MeshCore::FacetIndex numMeshFaces = 0;
+            for (std::size_t numDomainFaces : domainSizes) {
+                std::vector<MeshCore::FacetIndex> segment(numDomainFaces);
+                std::iota(segment.begin(), segment.end(), numMeshFaces);
+                numMeshFaces += numDomainFaces;
+                meshSegments.push_back(segment);
+            }
         }
 
         Mesh::MeshObject* meshdata = new Mesh::MeshObject();
@@ -220,15 +492,53 @@ Mesher::Mesher(const TopoDS_Shape& s)
 
 Mesher::~Mesher() = default;
 
+bool Mesher::cleanCoarseTriangulations() const
+{
+    bool needsMeshing = false;
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        const TopoDS_Face& face = TopoDS::Face(xp.Current());
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) hTria = BRep_Tool::Triangulation(face, loc);
+        if (hTria.IsNull()) {
+            needsMeshing = true;
+            continue;
+        }
+
+        // the deflection of a relative mesh depends on the size of the face
+        double faceDeflection = deflection;
+        if (relative) {
+            Bnd_Box bounds;
+            BRepBndLib::Add(face, bounds, Standard_False);
+            if (!bounds.IsVoid()) {
+                Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+                bounds.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+                faceDeflection *= std::max({xMax - xMin, yMax - yMin, zMax - zMin});
+            }
+        }
+
+        if (hTria->Deflection() > faceDeflection) {
+            BRepTools::Clean(face);
+            needsMeshing = true;
+        }
+    }
+
+    return needsMeshing;
+}
+
 Mesh::MeshObject* Mesher::createStandard() const
 {
     if (!shape.IsNull()) {
-        BRepTools::Clean(shape);
-        BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+        if (!reuseTriangulation) {
+            BRepTools::Clean(shape);
+            BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+        }
+        else if (cleanCoarseTriangulations()) {
+            // faces with a fine enough triangulation are kept by the mesher
+            BRepMesh_IncrementalMesh aMesh(shape, deflection, relative, angularDeflection);
+        }
     }
 
-    std::vector<Part::TopoShape::Domain> domains;
-    Part::TopoShape(shape).getDomains(domains);
+    std::vector<Part::TopoShape::Domain> domains = getDomains(shape);
 
     BrepMesh brepmesh(this->segments, this->colors);
     return brepmesh.create(domains);
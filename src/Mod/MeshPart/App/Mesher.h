@@ -151,6 +151,21 @@ public:
     }
     //@}
 
+    /** @name Standard settings */
+    //@{
+    /** Keep the existing triangulation of a face if its deflection is not higher
+     * than the requested deflection. Only the other faces are meshed again.
+     */
+    void setReuseTriangulation(bool s)
+    {
+        reuseTriangulation = s;
+    }
+    bool isReuseTriangulation() const
+    {
+        return reuseTriangulation;
+    }
+    //@}
+
 #if defined(HAVE_NETGEN)
     /** @name Netgen settings */
     //@{
@@ -217,6 +232,7 @@ public:
 
 private:
     Mesh::MeshObject* createStandard() const;
+    bool cleanCoarseTriangulations() const;
     Mesh::MeshObject* createFrom(SMESH_Mesh*) const;
 
 private:
@@ -231,6 +247,7 @@ private:
     bool relative {false};
     bool regular {false};
     bool segments {false};
+    bool reuseTriangulation {false};
 #if defined(HAVE_NETGEN)
     int fineness {5};
     double growthRate {0};
@@ -0,0 +1,385 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <exception>
+#include <map>
+#include <numeric>
+
+#include <BOPAlgo_ArgumentAnalyzer.hxx>
+#include <BOPAlgo_CheckResult.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
+#include <Bnd_BoundSortBox.hxx>
+#include <Bnd_HArray1OfBox.hxx>
+#include <OSD_Parallel.hxx>
+#include <Precision.hxx>
+#include <TopExp.hxx>
+#include <TColStd_ListOfInteger.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Iterator.hxx>
+#include <TopTools_DataMapOfShapeInteger.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+#include "BOPCheck.h"
+
+using namespace Part;
+
+namespace
+{
+
+void setupAnalyzer(BOPAlgo_ArgumentAnalyzer& analyzer, const BOPCheck::Settings& settings)
+{
+    // all settings are false by default. so only turn on what we want.
+    analyzer.ArgumentTypeMode() = settings.argumentTypeMode;
+    analyzer.SelfInterMode() = settings.selfInterMode;
+    analyzer.SmallEdgeMode() = settings.smallEdgeMode;
+    analyzer.RebuildFaceMode() = settings.rebuildFaceMode;
+    analyzer.ContinuityMode() = settings.continuityMode;
+    analyzer.TangentMode() = settings.tangentMode;
+    analyzer.MergeVertexMode() = settings.mergeVertexMode;
+    analyzer.MergeEdgeMode() = settings.mergeEdgeMode;
+    analyzer.CurveOnSurfaceMode() = settings.curveOnSurfaceMode;
+    analyzer.SetParallelMode(settings.runParallel);
+    analyzer.SetRunParallel(settings.runParallel);
+}
+
+// Collect the non-compound shapes of the compound structure in order
+void collectLeaves(const TopoDS_Shape& shape, std::vector<TopoDS_Shape>& leaves)
+{
+    if (shape.ShapeType() != TopAbs_COMPOUND) {
+        leaves.push_back(shape);
+        return;
+    }
+    for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+        collectLeaves(it.Value(), leaves);
+    }
+}
+
+// Rebuild the compound structure of shape with the given leaves, see collectLeaves()
+TopoDS_Shape replaceLeaves(const TopoDS_Shape& shape,
+                           const std::vector<TopoDS_Shape>& leaves,
+                           std::size_t& next)
+{
+    if (shape.ShapeType() != TopAbs_COMPOUND) {
+        return leaves[next++];
+    }
+    // The iterator passes the location of the compound on to its children
+    BRep_Builder builder;
+    TopoDS_Compound comp;
+    builder.MakeCompound(comp);
+    for (TopoDS_Iterator it(shape); it.More(); it.Next()) {
+        builder.Add(comp, replaceLeaves(it.Value(), leaves, next));
+    }
+    return comp;
+}
+
+// Run func(i) for i in [0, count) in parallel and rethrow the first exception in index order
+template<typename Func>
+void parallelFor(int count, bool parallel, Func&& func)
+{
+    std::vector<std::exception_ptr> errors(count);
+    OSD_Parallel::For(
+        0,
+        count,
+        [&func, &errors](int i) {
+            try {
+                func(i);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        },
+        !parallel);
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace
+
+BOPCheck::BOPCheck(const TopoDS_Shape& shape, const Settings& settings)
+    : settings(settings)
+{
+    // BOPAlgo_ArgumentAnalyzer may not work on the original shape, so always check a copy
+    if (!shape.IsNull()) {
+        makeComponents(shape);
+    }
+}
+
+void BOPCheck::makeComponents(const TopoDS_Shape& shape)
+{
+    std::vector<TopoDS_Shape> leaves;
+    collectLeaves(shape, leaves);
+
+    // Join the leaves that share a sub-shape. Instances of a shape at different locations
+    // are separate components.
+    std::vector<int> parent(leaves.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto root = [&parent](int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    TopTools_DataMapOfShapeInteger owners;
+    auto join = [&](const TopoDS_Shape& subShape, int i) {
+        if (const Standard_Integer* owner = owners.Seek(subShape)) {
+            parent[root(*owner)] = root(i);
+        }
+        else {
+            owners.Bind(subShape, i);
+        }
+    };
+
+    for (int i = 0; i < static_cast<int>(leaves.size()); ++i) {
+        join(leaves[i], i);
+        for (TopExp_Explorer xp(leaves[i], TopAbs_VERTEX); xp.More(); xp.Next()) {
+            join(xp.Current(), i);
+        }
+    }
+
+    std::map<int, std::size_t> index;
+    std::vector<std::vector<int>> groups;
+    for (int i = 0; i < static_cast<int>(leaves.size()); ++i) {
+        auto res = index.emplace(root(i), groups.size());
+        if (res.second) {
+            groups.emplace_back();
+        }
+        groups[res.first->second].push_back(i);
+    }
+
+    // The components are checked concurrently and therefore must not share any data. Copy
+    // them one by one, so that the instances of a shape get their own TShapes.
+    comps.reserve(groups.size());
+    std::vector<TopoDS_Shape> copiedLeaves(leaves.size());
+    BRep_Builder builder;
+    for (const auto& group : groups) {
+        if (group.size() == 1) {
+            comps.push_back(BRepBuilderAPI_Copy(leaves[group.front()]).Shape());
+            copiedLeaves[group.front()] = comps.back();
+            continue;
+        }
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (int i : group) {
+            builder.Add(comp, leaves[i]);
+        }
+        comps.push_back(BRepBuilderAPI_Copy(comp).Shape());
+        auto it = group.begin();
+        for (TopoDS_Iterator jt(comps.back()); jt.More(); jt.Next(), ++it) {
+            copiedLeaves[*it] = jt.Value();
+        }
+    }
+
+    std::size_t next = 0;
+    copy = replaceLeaves(shape, copiedLeaves, next);
+}
+
+bool BOPCheck::perform(const Callback& callback)
+{
+    checkResults.Clear();
+    if (copy.IsNull()) {
+        return true;
+    }
+
+    int count = static_cast<int>(comps.size());
+    if (count <= 1) {
+        BOPAlgo_ListOfCheckResult result;
+        BOPAlgo_ArgumentAnalyzer analyzer;
+        analyzer.SetShape1(copy);
+        setupAnalyzer(analyzer, settings);
+        analyzer.Perform();
+        result.Assign(analyzer.GetCheckResult());
+        return addResults(result, callback);
+    }
+
+    int blockSize = std::max(1, 2 * OSD_Parallel::NbLogicalProcessors());
+    boxes.assign(comps.size(), Bnd_Box());
+    for (int begin = 0; begin < count; begin += blockSize) {
+        int end = std::min(count, begin + blockSize);
+        std::vector<BOPAlgo_ListOfCheckResult> blockResults(end - begin);
+        parallelFor(end - begin, settings.runParallel, [&](int i) {
+            checkComponent(begin + i, blockResults[i]);
+        });
+
+        BOPAlgo_ListOfCheckResult result;
+        for (auto& res : blockResults) {
+            result.Append(res);
+        }
+        if (!addResults(result, callback)) {
+            return false;
+        }
+    }
+
+    // The components are self-interference free now, except for the reported results, but
+    // they may still interfere with each other. Check each pair of components whose bounding
+    // boxes overlap. The self-interference check doesn't modify the shapes, so a component
+    // may be part of several pairs that are checked at the same time.
+    if (!settings.selfInterMode) {
+        return true;
+    }
+
+    auto pairs = overlappingPairs();
+    count = static_cast<int>(pairs.size());
+    for (int begin = 0; begin < count; begin += blockSize) {
+        int end = std::min(count, begin + blockSize);
+        // Adding a shape to a compound changes the flags of the shape, so don't do it
+        // concurrently
+        std::vector<TopoDS_Compound> pairShapes(end - begin);
+        BRep_Builder builder;
+        for (int i = begin; i < end; ++i) {
+            auto& pair = pairShapes[i - begin];
+            builder.MakeCompound(pair);
+            builder.Add(pair, comps[pairs[i].first]);
+            builder.Add(pair, comps[pairs[i].second]);
+        }
+
+        std::vector<BOPAlgo_ListOfCheckResult> blockResults(end - begin);
+        parallelFor(end - begin, settings.runParallel, [&](int i) {
+            checkPair(pairShapes[i], pairs[begin + i].first, blockResults[i]);
+        });
+
+        BOPAlgo_ListOfCheckResult result;
+        for (auto& res : blockResults) {
+            result.Append(res);
+        }
+        if (!addResults(result, callback)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void BOPCheck::checkComponent(int index, BOPAlgo_ListOfCheckResult& result)
+{
+    const TopoDS_Shape& comp = comps[index];
+    if (settings.selfInterMode) {
+        BRepBndLib::Add(comp, boxes[index], Standard_False);
+        if (!boxes[index].IsVoid()) {
+            boxes[index].Enlarge(Precision::Confusion());
+        }
+    }
+
+    BOPAlgo_ArgumentAnalyzer analyzer;
+    analyzer.SetShape1(comp);
+    setupAnalyzer(analyzer, settings);
+    analyzer.Perform();
+
+    for (BOPAlgo_ListIteratorOfListOfCheckResult it(analyzer.GetCheckResult()); it.More();
+         it.Next()) {
+        BOPAlgo_CheckResult res = it.Value();
+        res.SetShape1(copy);
+        result.Append(res);
+    }
+}
+
+void BOPCheck::checkPair(const TopoDS_Shape& pair,
+                         int first,
+                         BOPAlgo_ListOfCheckResult& result) const
+{
+    BOPAlgo_ArgumentAnalyzer analyzer;
+    analyzer.SetShape1(pair);
+    analyzer.SelfInterMode() = true;
+    analyzer.SetRunParallel(settings.runParallel);
+    analyzer.Perform();
+    if (!analyzer.HasFaulty()) {
+        return;
+    }
+
+    // The interferences inside of a single component are already reported, only keep those
+    // between shapes of both components
+    TopTools_IndexedMapOfShape firstShapes;
+    TopExp::MapShapes(comps[first], firstShapes);
+    for (BOPAlgo_ListIteratorOfListOfCheckResult it(analyzer.GetCheckResult()); it.More();
+         it.Next()) {
+        bool inFirst = false;
+        bool inSecond = false;
+        for (TopTools_ListIteratorOfListOfShape jt(it.Value().GetFaultyShapes1()); jt.More();
+             jt.Next()) {
+            if (firstShapes.Contains(jt.Value())) {
+                inFirst = true;
+            }
+            else {
+                inSecond = true;
+            }
+        }
+        if (inFirst == inSecond) {
+            BOPAlgo_CheckResult res = it.Value();
+            res.SetShape1(copy);
+            result.Append(res);
+        }
+    }
+}
+
+std::vector<std::pair<int, int>> BOPCheck::overlappingPairs() const
+{
+    std::vector<int> indices;
+    for (int i = 0; i < static_cast<int>(boxes.size()); ++i) {
+        if (!boxes[i].IsVoid()) {
+            indices.push_back(i);
+        }
+    }
+    if (indices.size() < 2) {
+        return {};
+    }
+
+    // Bnd_BoundSortBox sorts the boxes into a grid, so that each box is only compared with
+    // the boxes in the same cells
+    const int count = static_cast<int>(indices.size());
+    Handle(Bnd_HArray1OfBox) sortedBoxes = new Bnd_HArray1OfBox(1, count);
+    Bnd_Box enclosing;
+    for (int i = 0; i < count; ++i) {
+        sortedBoxes->SetValue(i + 1, boxes[indices[i]]);
+        enclosing.Add(boxes[indices[i]]);
+    }
+    Bnd_BoundSortBox sorter;
+    sorter.Initialize(enclosing, sortedBoxes);
+
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < count; ++i) {
+        const TColStd_ListOfInteger& found = sorter.Compare(boxes[indices[i]]);
+        for (TColStd_ListOfInteger::Iterator it(found); it.More(); it.Next()) {
+            int j = it.Value() - 1;
+            if (j > i) {
+                pairs.emplace_back(indices[i], indices[j]);
+            }
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+bool BOPCheck::addResults(BOPAlgo_ListOfCheckResult& result, const Callback& callback)
+{
+    bool proceed = !callback || callback(result);
+    checkResults.Append(result);
+    return proceed;
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PART_BOPCHECK_H
+#define PART_BOPCHECK_H
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <BOPAlgo_ListOfCheckResult.hxx>
+#include <Bnd_Box.hxx>
+#include <TopoDS_Shape.hxx>
+
+#include <Mod/Part/PartGlobal.h>
+
+namespace Part
+{
+
+/** Parallel version of the check done by BOPAlgo_ArgumentAnalyzer
+ *
+ * BOPAlgo_ArgumentAnalyzer checks the whole shape at once and its parallel mode only helps a
+ * few of its tests, so a shape with many independent solids or shells, as found in imported
+ * assemblies, is mostly checked on a single core.
+ *
+ * BOPCheck splits the shape into components, i.e. groups of the non-compound shapes of the
+ * compound structure that share sub-shapes, and analyzes the components in parallel. The
+ * instances of a shape at different locations are separate components. Afterwards the
+ * self-interference test is run in parallel for the pairs of components whose bounding boxes
+ * overlap, which finds the interferences between different components.
+ *
+ * The components are copied before the check, so that they don't share any TShape, and the
+ * faulty shapes of the results are sub-shapes of the copy. The results are reported block by
+ * block so that a caller can output them while the check is still running.
+ */
+class PartExport BOPCheck
+{
+public:
+    /// The tests to run, see BOPAlgo_ArgumentAnalyzer
+    struct Settings
+    {
+        bool argumentTypeMode {true};
+        bool selfInterMode {true};
+        bool smallEdgeMode {true};
+        bool rebuildFaceMode {true};
+        bool continuityMode {true};
+        bool tangentMode {true};
+        bool mergeVertexMode {true};
+        bool mergeEdgeMode {true};
+        bool curveOnSurfaceMode {true};
+        bool runParallel {true};
+    };
+
+    /** Called in the calling thread with the results of each finished block of checks
+     * @return false to stop the check
+     */
+    using Callback = std::function<bool(const BOPAlgo_ListOfCheckResult&)>;
+
+    explicit BOPCheck(const TopoDS_Shape& shape, const Settings& settings = Settings());
+
+    /** Run the check
+     * @param callback: optional function to report the intermediate results
+     * @return false if the check was stopped by the callback
+     */
+    bool perform(const Callback& callback = Callback());
+
+    bool hasFaulty() const
+    {
+        return !checkResults.IsEmpty();
+    }
+    const BOPAlgo_ListOfCheckResult& results() const
+    {
+        return checkResults;
+    }
+    /// The copy of the input shape that is checked
+    const TopoDS_Shape& shape() const
+    {
+        return copy;
+    }
+    /// The components that are analyzed independently of each other
+    const std::vector<TopoDS_Shape>& components() const
+    {
+        return comps;
+    }
+
+private:
+    void makeComponents(const TopoDS_Shape& shape);
+    void checkComponent(int index, BOPAlgo_ListOfCheckResult& result);
+    void checkPair(const TopoDS_Shape& pair, int first, BOPAlgo_ListOfCheckResult& result) const;
+    std::vector<std::pair<int, int>> overlappingPairs() const;
+    bool addResults(BOPAlgo_ListOfCheckResult& result, const Callback& callback);
+
+private:
+    TopoDS_Shape copy;
+    Settings settings;
+    std::vector<TopoDS_Shape> comps;
+    std::vector<Bnd_Box> boxes;
+    BOPAlgo_ListOfCheckResult checkResults;
+};
+
+}  // namespace Part
+
+#endif  // PART_BOPCHECK_H
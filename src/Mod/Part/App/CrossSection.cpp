@@ -21,7 +21,14 @@
  ***************************************************************************/
 
 # include <algorithm>
+# include <cmath>
+# include <exception>
+# include <limits>
+# include <memory>
+# include <Bnd_Box.hxx>
+# include <BRep_Builder.hxx>
 # include <BRepAdaptor_Surface.hxx>
+# include <BRepBndLib.hxx>
 # include <Mod/Part/App/FCBRepAlgoAPI_Common.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Cut.h>
 # include <Mod/Part/App/FCBRepAlgoAPI_Section.h>
@@ -29,6 +36,7 @@
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <BRepPrimAPI_MakeHalfSpace.hxx>
 # include <gp_Pln.hxx>
+# include <OSD_Parallel.hxx>
 # include <Precision.hxx>
 # include <ShapeAnalysis_FreeBounds.hxx>
 # include <ShapeFix_Wire.hxx>
@@ -37,16 +45,74 @@
 # include <TopTools_HSequenceOfShape.hxx>
 # include <TopTools_IndexedMapOfShape.hxx>
 # include <TopoDS.hxx>
+# include <TopoDS_Compound.hxx>
 # include <TopoDS_Edge.hxx>
 # include <TopoDS_Wire.hxx>
 
 
 #include "CrossSection.h"
+#include "FuzzyHelper.h"
 #include "TopoShapeOpCode.h"
 
 
 using namespace Part;
 
+namespace
+{
+
+// The range of the distance of all planes a*x + b*y + c*z = d that may intersect a shape
+struct SliceRange
+{
+    double min = -std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::max();
+
+    SliceRange(double a, double b, double c, const TopoDS_Shape& shape)
+    {
+        Bnd_Box box;
+        BRepBndLib::Add(shape, box, Standard_False);
+        if (box.IsVoid()) {
+            return;
+        }
+        // Also consider the fuzzy value of the boolean operations
+        box.Enlarge(Precision::Confusion()
+                    + FuzzyHelper::getBooleanFuzzy() * std::sqrt(box.SquareExtent())
+                        * Precision::Confusion());
+        double xMin {}, yMin {}, zMin {}, xMax {}, yMax {}, zMax {};
+        box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+        min = std::min(a * xMin, a * xMax) + std::min(b * yMin, b * yMax)
+            + std::min(c * zMin, c * zMax);
+        max = std::max(a * xMin, a * xMax) + std::max(b * yMin, b * yMax)
+            + std::max(c * zMin, c * zMax);
+    }
+
+    bool contains(double d) const
+    {
+        return d >= min && d <= max;
+    }
+};
+
+// Run func(i) for i in [0, count) in parallel and rethrow the first exception in index order
+template<typename Func>
+void parallelFor(int count, Func&& func)
+{
+    std::vector<std::exception_ptr> errors(count);
+    OSD_Parallel::For(0, count, [&func, &errors](int i) {
+        try {
+            func(i);
+        }
+        catch (...) {
+            errors[i] = std::current_exception();
+        }
+    });
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace
+
 CrossSection::CrossSection(double a, double b, double c, const TopoDS_Shape& s)
   : a(a), b(b), c(c), s(s)
 {
@@ -71,6 +137,69 @@ std::list<TopoDS_Wire> CrossSection::slice(double d) const
     return removeDuplicates(wires);
 }
 
+std::vector<std::list<TopoDS_Wire>> CrossSection::slices(const std::vector<double>& d) const
+{
+    // Compute the bounds of the sub-shapes once. Of a shell only the faces that span the
+    // distance are sliced.
+    std::vector<std::pair<TopoDS_Shape, SliceRange>> solids;
+    std::vector<std::vector<std::pair<TopoDS_Shape, SliceRange>>> shells;
+    std::vector<std::pair<TopoDS_Shape, SliceRange>> faces;
+    TopExp_Explorer xp;
+    for (xp.Init(s, TopAbs_SOLID); xp.More(); xp.Next()) {
+        solids.emplace_back(xp.Current(), SliceRange(a, b, c, xp.Current()));
+    }
+    for (xp.Init(s, TopAbs_SHELL, TopAbs_SOLID); xp.More(); xp.Next()) {
+        shells.emplace_back();
+        shells.back().emplace_back(xp.Current(), SliceRange(a, b, c, xp.Current()));
+        for (TopExp_Explorer xpFace(xp.Current(), TopAbs_FACE); xpFace.More(); xpFace.Next()) {
+            shells.back().emplace_back(xpFace.Current(), SliceRange(a, b, c, xpFace.Current()));
+        }
+    }
+    for (xp.Init(s, TopAbs_FACE, TopAbs_SHELL); xp.More(); xp.Next()) {
+        faces.emplace_back(xp.Current(), SliceRange(a, b, c, xp.Current()));
+    }
+
+    std::vector<std::list<TopoDS_Wire>> result(d.size());
+    parallelFor(static_cast<int>(d.size()), [&](int i) {
+        double dist = d[i];
+        std::list<TopoDS_Wire> wires;
+        for (const auto& solid : solids) {
+            if (solid.second.contains(dist)) {
+                sliceSolid(dist, solid.first, wires);
+            }
+        }
+        for (const auto& shell : shells) {
+            if (!shell.front().second.contains(dist)) {
+                continue;
+            }
+            TopoDS_Compound comp;
+            BRep_Builder builder;
+            builder.MakeCompound(comp);
+            std::size_t count = 0;
+            for (auto it = shell.begin() + 1; it != shell.end(); ++it) {
+                if (it->second.contains(dist)) {
+                    builder.Add(comp, it->first);
+                    ++count;
+                }
+            }
+            if (count + 1 == shell.size()) {
+                sliceNonSolid(dist, shell.front().first, wires);
+            }
+            else if (count > 0) {
+                sliceNonSolid(dist, comp, wires);
+            }
+        }
+        for (const auto& face : faces) {
+            if (face.second.contains(dist)) {
+                sliceNonSolid(dist, face.first, wires);
+            }
+        }
+        result[i] = removeDuplicates(wires);
+    });
+
+    return result;
+}
+
 std::list<TopoDS_Wire> CrossSection::removeDuplicates(const std::list<TopoDS_Wire>& wires) const
 {
     std::list<TopoDS_Wire> wires_reduce;
@@ -255,12 +384,98 @@ TopoShape TopoCrossSection::slice(int idx, double d) const
         TopoShape::SingleShapeCompoundCreationPolicy::returnShape);
 }
 
+void TopoCrossSection::slices(const std::vector<double>& d, std::vector<TopoShape>& wires) const
+{
+    // Same choice of sub-shapes as in slice()
+    bool solid = true;
+    std::vector<TopoShape> shapes = shape.getSubTopoShapes(TopAbs_SOLID);
+    if (shapes.empty()) {
+        solid = false;
+        shapes = shape.getSubTopoShapes(TopAbs_SHELL);
+        if (shapes.empty()) {
+            shapes = shape.getSubTopoShapes(TopAbs_FACE);
+        }
+    }
+    std::vector<SliceRange> ranges;
+    ranges.reserve(shapes.size());
+    for (const auto& s : shapes) {
+        ranges.emplace_back(a, b, c, s.getShape());
+    }
+
+    // One boolean operation of a slice. The operations are run in parallel, while the element
+    // maps are created afterwards in order because the string hasher isn't thread safe.
+    struct SliceOp
+    {
+        int idx;
+        double d;
+        const TopoShape* shape;
+        TopoShape halfSpace;
+        std::unique_ptr<FCBRepAlgoAPI_Section> section;
+        std::unique_ptr<FCBRepAlgoAPI_Cut> cut;
+    };
+
+    // Limit the number of pending operations as each of them keeps its intermediate data
+    const std::size_t blockSize = 2 * std::max(1, OSD_Parallel::NbLogicalProcessors());
+    std::vector<SliceOp> ops;
+    std::size_t level = 0;
+    while (level < d.size()) {
+        ops.clear();
+        for (; level < d.size() && ops.size() < blockSize; ++level) {
+            int idx = static_cast<int>(level) + 1;
+            for (std::size_t i = 0; i < shapes.size(); ++i) {
+                if (!ranges[i].contains(d[level])) {
+                    continue;
+                }
+                ops.push_back({idx, d[level], &shapes[i], TopoShape(), nullptr, nullptr});
+                if (solid) {
+                    ops.back().halfSpace = makeHalfSpace(idx, d[level]);
+                }
+            }
+        }
+
+        parallelFor(static_cast<int>(ops.size()), [&](int i) {
+            auto& sliceOp = ops[i];
+            if (solid) {
+                sliceOp.cut = std::make_unique<FCBRepAlgoAPI_Cut>(sliceOp.shape->getShape(),
+                                                                  sliceOp.halfSpace.getShape());
+            }
+            else {
+                sliceOp.section = std::make_unique<FCBRepAlgoAPI_Section>(
+                    sliceOp.shape->getShape(),
+                    gp_Pln(a, b, c, -sliceOp.d));
+            }
+        });
+
+        for (auto& sliceOp : ops) {
+            if (solid) {
+                makeSolidWires(sliceOp.idx,
+                               sliceOp.d,
+                               *sliceOp.cut,
+                               *sliceOp.shape,
+                               sliceOp.halfSpace,
+                               wires);
+            }
+            else {
+                makeSectionWires(sliceOp.idx, *sliceOp.section, *sliceOp.shape, wires);
+            }
+        }
+    }
+}
+
 void TopoCrossSection::sliceNonSolid(int idx,
                                      double d,
                                      const TopoShape& shape,
                                      std::vector<TopoShape>& wires) const
 {
     FCBRepAlgoAPI_Section cs(shape.getShape(), gp_Pln(a, b, c, -d));
+    makeSectionWires(idx, cs, shape, wires);
+}
+
+void TopoCrossSection::makeSectionWires(int idx,
+                                        FCBRepAlgoAPI_Section& cs,
+                                        const TopoShape& shape,
+                                        std::vector<TopoShape>& wires) const
+{
     if (cs.IsDone()) {
         std::string prefix(op);
         prefix += Data::indexSuffix(idx);
@@ -276,6 +491,13 @@ void TopoCrossSection::sliceSolid(int idx,
                                   double d,
                                   const TopoShape& shape,
                                   std::vector<TopoShape>& wires) const
+{
+    TopoShape solid = makeHalfSpace(idx, d);
+    FCBRepAlgoAPI_Cut mkCut(shape.getShape(), solid.getShape());
+    makeSolidWires(idx, d, mkCut, shape, solid, wires);
+}
+
+TopoShape TopoCrossSection::makeHalfSpace(int idx, double d) const
 {
     gp_Pln slicePlane(a, b, c, -d);
     BRepBuilderAPI_MakeFace mkFace(slicePlane);
@@ -294,7 +516,19 @@ void TopoCrossSection::sliceSolid(int idx,
     std::string prefix(op);
     prefix += Data::indexSuffix(idx);
     solid.makeElementShape(mkSolid, face, prefix.c_str());
-    FCBRepAlgoAPI_Cut mkCut(shape.getShape(), solid.getShape());
+    return solid;
+}
+
+void TopoCrossSection::makeSolidWires(int idx,
+                                      double d,
+                                      FCBRepAlgoAPI_Cut& mkCut,
+                                      const TopoShape& shape,
+                                      const TopoShape& solid,
+                                      std::vector<TopoShape>& wires) const
+{
+    gp_Pln slicePlane(a, b, c, -d);
+    std::string prefix(op);
+    prefix += Data::indexSuffix(idx);
 
     if (mkCut.IsDone()) {
         TopoShape res(shape.Tag, shape.Hasher);
@@ -24,6 +24,7 @@
 #define PART_CROSSSECTION_H
 
 #include <list>
+#include <vector>
 #include <TopTools_IndexedMapOfShape.hxx>
 #include <Mod/Part/PartGlobal.h>
 #include "TopoShape.h"
@@ -31,6 +32,8 @@
 
 class TopoDS_Shape;
 class TopoDS_Wire;
+class FCBRepAlgoAPI_Cut;
+class FCBRepAlgoAPI_Section;
 
 namespace Part {
 
@@ -39,6 +42,12 @@ class PartExport CrossSection
 public:
     CrossSection(double a, double b, double c, const TopoDS_Shape& s);
     std::list<TopoDS_Wire> slice(double d) const;
+    /** Slice the shape at several distances. The bounds of the sub-shapes are computed once so
+     * that each slice only handles the sub-shapes it may intersect, and the slices are computed
+     * in parallel.
+     * @return the wires of each distance
+     */
+    std::vector<std::list<TopoDS_Wire>> slices(const std::vector<double>& d) const;
 
 private:
     void sliceNonSolid(double d, const TopoDS_Shape&, std::list<TopoDS_Wire>& wires) const;
@@ -59,10 +68,25 @@ public:
     TopoCrossSection(double a, double b, double c, const TopoShape& s, const char* op = 0);
     void slice(int idx, double d, std::vector<TopoShape>& wires) const;
     TopoShape slice(int idx, double d) const;
+    /** Slice the shape at several distances like calling slice() with the index of each
+     * distance starting at 1. The boolean operations of the slices run in parallel.
+     */
+    void slices(const std::vector<double>& d, std::vector<TopoShape>& wires) const;
 
 private:
     void sliceNonSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
     void sliceSolid(int idx, double d, const TopoShape&, std::vector<TopoShape>& wires) const;
+    void makeSectionWires(int idx,
+                          FCBRepAlgoAPI_Section& cs,
+                          const TopoShape& shape,
+                          std::vector<TopoShape>& wires) const;
+    TopoShape makeHalfSpace(int idx, double d) const;
+    void makeSolidWires(int idx,
+                        double d,
+                        FCBRepAlgoAPI_Cut& mkCut,
+                        const TopoShape& shape,
+                        const TopoShape& solid,
+                        std::vector<TopoShape>& wires) const;
 
 private:
     double a, b, c;
@@ -67,6 +67,7 @@ BRepAlgoAPI_Section(Sh,Pl,false)
     }
     setAutoFuzzy();
     SetRunParallel(Standard_True);
+    SetNonDestructive(Standard_True);
     if (PerformNow) Build();
 }
 
@@ -22,7 +22,6 @@
 
 #include <FCConfig.h>
 
-# include <BRepFilletAPI_MakeFillet.hxx>
 # include <Precision.hxx>
 # include <TopExp.hxx>
 # include <TopExp_Explorer.hxx>
@@ -56,9 +55,8 @@ App::DocumentObjectExecReturn *Fillet::execute()
 #endif
     TopoShape baseTopoShape = Feature::getTopoShape(link, ShapeOption::ResolveLink | ShapeOption::Transform);
         auto baseShape = baseTopoShape.getShape();
-        BRepFilletAPI_MakeFillet mkFillet(baseShape);
-        TopTools_IndexedMapOfShape mapOfShape;
-        TopExp::MapShapes(baseShape, TopAbs_EDGE, mapOfShape);
+        std::vector<TopoShape> filletEdges;
+        std::vector<std::pair<double, double>> radii;
         TopTools_IndexedMapOfShape mapOfEdges;
         TopExp::MapShapes(baseShape, TopAbs_EDGE, mapOfEdges);
         std::vector<Part::FilletElement> edges = Edges.getValues();
@@ -97,9 +95,8 @@ App::DocumentObjectExecReturn *Fillet::execute()
             if(edge.IsNull())
                 return new App::DocumentObjectExecReturn("Invalid edge link");                
 
-            double radius1 = info.radius1;
-            double radius2 = info.radius2;
-            mkFillet.Add(radius1, radius2, TopoDS::Edge(edge));
+            filletEdges.emplace_back(edge);
+            radii.emplace_back(info.radius1, info.radius2);
         }
 
         if (!fullErrMsg.empty()) {
@@ -107,17 +104,20 @@ App::DocumentObjectExecReturn *Fillet::execute()
         }
         Edges.setValues(edges);
 
-        TopoDS_Shape shape = mkFillet.Shape();
-        if (shape.IsNull())
+        TopoShape res(0);
+        res.makeElementFillet(baseTopoShape, filletEdges, radii, Part::OpCodes::Fillet);
+        if (res.isNull())
             return new App::DocumentObjectExecReturn("Resulting shape is null");
 
-        TopoShape res(0);
-        this->Shape.setValue(res.makeElementShape(mkFillet, baseTopoShape, Part::OpCodes::Fillet));
+        this->Shape.setValue(res);
         return Part::FilletBase::execute();
     }
     catch (Standard_Failure& e) {
         return new App::DocumentObjectExecReturn(e.GetMessageString());
     }
+    catch (Base::Exception& e) {
+        return new App::DocumentObjectExecReturn(e.what());
+    }
     catch (...) {
         return new App::DocumentObjectExecReturn("A fatal error occurred when making fillets");
     }
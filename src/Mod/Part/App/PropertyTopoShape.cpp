@@ -463,11 +463,21 @@ void PropertyPartShape::afterRestore()
     PropertyComplexGeoData::afterRestore();
 }
 
+// Returns true if the triangulation of the shape should be saved, too. When the document is
+// loaded again the view providers can display the stored triangulation directly instead of
+// meshing the shape.
+static bool saveTriangulation()
+{
+    return App::GetApplication().GetParameterGroupByPath
+        ("User parameter:BaseApp/Preferences/Mod/Part/General")->GetBool("SaveTriangulation", false);
+}
+
 // The following function is copied from OCCT BRepTools.cxx and modified
-// to disable saving of triangulation
+// to make saving of triangulation optional
 //
 
-static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File)
+static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_CString File,
+                                         Standard_Boolean withTriangles)
 {
   std::ofstream os;
   OSD_OpenStream(os, File, std::ios::out);
@@ -486,7 +496,7 @@ static Standard_Boolean  BRepTools_Write(const TopoDS_Shape& Sh, const Standard_
       VERSION_3 = 3
   };
 
-  BRepTools_ShapeSet SS(Standard_False);
+  BRepTools_ShapeSet SS(withTriangles);
   SS.SetFormatNb(VERSION_1);
   // SS.SetProgress(PR);
   SS.Add(Sh);
@@ -514,7 +524,8 @@ void PropertyPartShape::saveToFile(Base::Writer &writer) const
     static Base::FileInfo fi(App::Application::getTempFileName());
 
     TopoDS_Shape myShape = _Shape.getShape();
-    if (!BRepTools_Write(myShape,static_cast<Standard_CString>(fi.filePath().c_str()))) {
+    if (!BRepTools_Write(myShape,static_cast<Standard_CString>(fi.filePath().c_str()),
+                         saveTriangulation())) {
         // Note: Do NOT throw an exception here because if the tmp. file could
         // not be created we should not abort.
         // We only print an error message but continue writing the next files to the
@@ -613,7 +624,7 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
     if (writer.getMode("BinaryBrep")) {
         TopoShape shape;
         shape.setShape(myShape);
-        shape.exportBinary(writer.Stream());
+        shape.exportBinary(writer.Stream(), saveTriangulation());
     }
     else {
         bool direct = App::GetApplication().GetParameterGroupByPath
@@ -624,7 +635,7 @@ void PropertyPartShape::SaveDocFile (Base::Writer &writer) const
         else {
             TopoShape shape;
             shape.setShape(myShape);
-            shape.exportBrep(writer.Stream());
+            shape.exportBrep(writer.Stream(), saveTriangulation());
         }
     }
 }
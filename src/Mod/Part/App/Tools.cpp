@@ -29,7 +29,9 @@
 # include <BRepBuilderAPI_MakeFace.hxx>
 # include <BRepIntCurveSurface_Inter.hxx>
 # include <BRepLProp_SLProps.hxx>
+# include <BRepMesh_Deflection.hxx>
 # include <BRepMesh_IncrementalMesh.hxx>
+# include <BRepTools.hxx>
 # include <CSLib.hxx>
 # include <Geom_BSplineSurface.hxx>
 # include <Geom_Line.hxx>
@@ -839,3 +841,21 @@ Standard_Real Part::Tools::getDeflection(const TopoDS_Shape& shape, double devia
 {
     return getDeflection(getBounds(shape), deviation);
 }
+
+bool Part::Tools::hasTriangulation(const TopoDS_Shape& shape, double deflection, bool allowQualityDecrease)
+{
+    // checks that all faces and edges are triangulated
+    if (!BRepTools::Triangulation(shape, Precision::Infinite())) {
+        return false;
+    }
+
+    for (TopExp_Explorer xp(shape, TopAbs_FACE); xp.More(); xp.Next()) {
+        TopLoc_Location loc;
+        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(xp.Current()), loc);
+        if (!BRepMesh_Deflection::IsConsistent(mesh->Deflection(), deflection, allowQualityDecrease)) {
+            return false;
+        }
+    }
+
+    return true;
+}
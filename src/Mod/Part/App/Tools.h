@@ -300,6 +300,22 @@ public:
      * \return The computed deflection value.
      */
     static Standard_Real getDeflection(const TopoDS_Shape& shape, double deviation);
+
+    /**
+     * \brief Checks if the triangulation stored in a shape fits a deflection.
+     *
+     * Every face must have a triangulation and every edge a polygon on it. The deflection
+     * of the triangulations must not be coarser than \a deflection. With
+     * \a allowQualityDecrease it must not be much finer either, because BRepMesh would
+     * replace it by a coarser one in this case.
+     *
+     * \param[in] shape The shape whose triangulation is checked.
+     * \param[in] deflection The requested linear deflection.
+     * \param[in] allowQualityDecrease Whether a much finer triangulation is rejected.
+     *
+     * \return True if the stored triangulation can be used as it is.
+     */
+    static bool hasTriangulation(const TopoDS_Shape& shape, double deflection, bool allowQualityDecrease);
 };
 
 } //namespace Part
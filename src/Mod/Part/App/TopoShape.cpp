@@ -145,7 +145,6 @@
 # include <XSControl_WorkSession.hxx>
 
 
-# include <BOPAlgo_ArgumentAnalyzer.hxx>
 # include <BOPAlgo_ListOfCheckResult.hxx>
 
 # include <BRepAlgoAPI_Defeaturing.hxx>
@@ -170,6 +169,7 @@
 #include <Base/Writer.h>
 
 #include "TopoShape.h"
+#include "BOPCheck.h"
 #include "BRepMesh.h"
 #include "BRepOffsetAPI_MakeOffsetFix.h"
 #include "CrossSection.h"
@@ -780,7 +780,13 @@ void TopoShape::importBrep(std::istream& str, int indicator)
 
 void TopoShape::importBinary(std::istream& str)
 {
+    // Restore the triangulation, too, if it has been saved
+#if OCC_VERSION_HEX >= 0x070600
     BinTools_ShapeSet theShapeSet;
+    theShapeSet.SetWithTriangles(Standard_True);
+#else
+    BinTools_ShapeSet theShapeSet(Standard_True);
+#endif
     theShapeSet.Read(str);
     Standard_Integer shapeId=0, locId=0, orient=0;
     BinTools::GetInteger(str, shapeId);
@@ -889,7 +895,7 @@ void TopoShape::exportBrep(const char *filename) const
 #endif
 }
 
-void TopoShape::exportBrep(std::ostream& out) const
+void TopoShape::exportBrep(std::ostream& out, bool withTriangles) const
 {
     // See TopTools_FormatVersion of OCCT 7.6
     enum {
@@ -897,14 +903,14 @@ void TopoShape::exportBrep(std::ostream& out) const
         VERSION_2 = 2,
         VERSION_3 = 3
     };
-    BRepTools_ShapeSet SS(Standard_False);
+    BRepTools_ShapeSet SS(withTriangles ? Standard_True : Standard_False);
     SS.SetFormatNb(VERSION_1);
     SS.Add(this->_Shape);
     SS.Write(out);
     SS.Write(this->_Shape, out);
 }
 
-void TopoShape::exportBinary(std::ostream& out) const
+void TopoShape::exportBinary(std::ostream& out, bool withTriangles) const
 {
     // See BinTools_FormatVersion of OCCT 7.6
     enum {
@@ -915,7 +921,12 @@ void TopoShape::exportBinary(std::ostream& out) const
     };
 
     // An example how to use BinTools_ShapeSet can be found in BinMNaming_NamedShapeDriver.cxx
+#if OCC_VERSION_HEX >= 0x070600
     BinTools_ShapeSet theShapeSet;
+    theShapeSet.SetWithTriangles(withTriangles);
+#else
+    BinTools_ShapeSet theShapeSet(withTriangles);
+#endif
     theShapeSet.SetFormatNb(VERSION_3);
     if (this->_Shape.IsNull()) {
         theShapeSet.Add(this->_Shape);
@@ -1402,7 +1413,12 @@ std::vector<std::string> buildBOPCheckResultVector()
 bool TopoShape::analyze(bool runBopCheck, std::ostream& str) const
 {
     if (!this->_Shape.IsNull()) {
+#if OCC_VERSION_HEX >= 0x070600
+        // check the sub-shapes in parallel
+        BRepCheck_Analyzer aChecker(this->_Shape, Standard_True, Standard_True);
+#else
         BRepCheck_Analyzer aChecker(this->_Shape);
+#endif
         if (!aChecker.IsValid()) {
             std::vector<TopoDS_Shape> shapes;
 
@@ -1573,43 +1589,29 @@ bool TopoShape::analyze(bool runBopCheck, std::ostream& str) const
             return false; // errors detected
         }
         else if (runBopCheck) {
-
-            TopoDS_Shape BOPCopy = BRepBuilderAPI_Copy(this->_Shape).Shape();
-            BOPAlgo_ArgumentAnalyzer BOPCheck;
-            BOPCheck.SetShape1(BOPCopy);
-            //all settings are false by default. so only turn on what we want.
-            BOPCheck.ArgumentTypeMode() = true;
-            BOPCheck.SelfInterMode() = true;
-            BOPCheck.SmallEdgeMode() = true;
-            BOPCheck.RebuildFaceMode() = true;
-            BOPCheck.ContinuityMode() = true;
-            BOPCheck.SetParallelMode(true); //this doesn't help for speed right now(occt 6.9.1).
-            BOPCheck.SetRunParallel(true); //performance boost, use all available cores
-            BOPCheck.TangentMode() = true; //these 4 new tests add about 5% processing time.
-            BOPCheck.MergeVertexMode() = true;
-            BOPCheck.CurveOnSurfaceMode() = true;
-            BOPCheck.MergeEdgeMode() = true;
-            BOPCheck.Perform();
-            if (!BOPCheck.HasFaulty())
-                return true;
-
-            str << "BOP check found the following errors:" << std::endl;
             static std::vector<std::string> shapeEnumToString = buildShapeEnumVector();
             static std::vector<std::string> bopEnumToString = buildBOPCheckResultVector();
-            const BOPAlgo_ListOfCheckResult &BOPResults = BOPCheck.GetCheckResult();
-            BOPAlgo_ListIteratorOfListOfCheckResult BOPResultsIt(BOPResults);
-            for (; BOPResultsIt.More(); BOPResultsIt.Next()) {
-                const BOPAlgo_CheckResult &current = BOPResultsIt.Value();
-
-                const TopTools_ListOfShape &faultyShapes1 = current.GetFaultyShapes1();
-                TopTools_ListIteratorOfListOfShape faultyShapes1It(faultyShapes1);
-                for (;faultyShapes1It.More(); faultyShapes1It.Next()) {
-                    const TopoDS_Shape &faultyShape = faultyShapes1It.Value();
-                    str << "Error in " << shapeEnumToString[faultyShape.ShapeType()] << ": ";
-                    str << bopEnumToString[current.GetCheckStatus()] << std::endl;
+
+            // Report the errors as soon as a block of checks is finished
+            BOPCheck check(this->_Shape);
+            check.perform([&](const BOPAlgo_ListOfCheckResult& BOPResults) {
+                if (!BOPResults.IsEmpty() && !check.hasFaulty())
+                    str << "BOP check found the following errors:" << std::endl;
+                BOPAlgo_ListIteratorOfListOfCheckResult BOPResultsIt(BOPResults);
+                for (; BOPResultsIt.More(); BOPResultsIt.Next()) {
+                    const BOPAlgo_CheckResult &current = BOPResultsIt.Value();
+                    const TopTools_ListOfShape &faultyShapes1 = current.GetFaultyShapes1();
+                    TopTools_ListIteratorOfListOfShape faultyShapes1It(faultyShapes1);
+                    for (;faultyShapes1It.More(); faultyShapes1It.Next()) {
+                        const TopoDS_Shape &faultyShape = faultyShapes1It.Value();
+                        str << "Error in " << shapeEnumToString[faultyShape.ShapeType()] << ": ";
+                        str << bopEnumToString[current.GetCheckStatus()] << std::endl;
+                    }
                 }
-            }
-            return false;
+                str.flush();
+                return true;
+            });
+            return !check.hasFaulty();
         }
     }
     return true;
@@ -1862,11 +1864,8 @@ std::list<TopoDS_Wire> TopoShape::slice(const Base::Vector3d& dir, double d) con
 
 TopoDS_Compound TopoShape::slices(const Base::Vector3d& dir, const std::vector<double>& d) const
 {
-    std::vector< std::list<TopoDS_Wire> > wire_list;
     CrossSection cs(dir.x, dir.y, dir.z, this->_Shape);
-    for (double jt : d) {
-        wire_list.push_back(cs.slice(jt));
-    }
+    std::vector< std::list<TopoDS_Wire> > wire_list = cs.slices(d);
 
     std::vector< std::list<TopoDS_Wire> >::const_iterator ft;
     TopoDS_Compound comp;
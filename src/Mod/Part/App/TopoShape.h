@@ -476,8 +476,9 @@ public:
     void exportIges(const char* FileName) const;
     void exportStep(const char* FileName) const;
     void exportBrep(const char* FileName) const;
-    void exportBrep(std::ostream&) const;
-    void exportBinary(std::ostream&) const;
+    /// Export the shape. If \a withTriangles is true the triangulation of the faces is kept.
+    void exportBrep(std::ostream&, bool withTriangles = false) const;
+    void exportBinary(std::ostream&, bool withTriangles = false) const;
     void exportStl(const char* FileName, double deflection) const;
     void exportFaceSet(double, double, const std::vector<Base::Color>&, std::ostream&) const;
     void exportLineSet(std::ostream&) const;
@@ -1911,6 +1912,29 @@ public:
                                   const std::vector<TopoShape>& sources,
                                   const char* op = nullptr,
                                   double tol = -1.0);
+    /** Boolean operation with the tool shapes passed to the algorithm in groups
+     *
+     * @param maker: op code from OpCodes, either Fuse, Cut or Common
+     * @param source: the argument shape
+     * @param toolGroups: groups of tool shapes. The shapes of a group are passed
+     *                    as one compound, so they are not intersected with each
+     *                    other. The caller must make sure they don't intersect.
+     * @param op: optional string to be encoded into topo naming for indicating
+     *            the operation
+     * @param tol: tolerance option available to some shape making algorithm
+     *
+     * @return The original content of this TopoShape is discarded and replaced
+     *         with the new shape built by the shape maker. The element names are
+     *         the same as when passing all tool shapes separately. The function
+     *         returns the TopoShape itself as a self reference so that
+     *         multiple operations can be carried out for the same shape in the
+     *         same line of code.
+     */
+    TopoShape& makeElementBoolean(const char* maker,
+                                  const TopoShape& source,
+                                  const std::vector<std::vector<TopoShape>>& toolGroups,
+                                  const char* op = nullptr,
+                                  double tol = -1.0);
     /** Generalized shape making with mapped element name from shape history
      *
      * @param maker: op code from TopoShapeOpCodes
@@ -2060,6 +2084,29 @@ public:
                                  double radius1,
                                  double radius2,
                                  const char* op = nullptr);
+    /* Make fillet shape with individual radii
+     *
+     * @param source: the source shape
+     * @param edges: the edges of the source shape where to make fillets
+     * @param radii: the radius of the beginning and the ending of the fillet
+     *               of each edge
+     * @param op: optional string to be encoded into topo naming for indicating
+     *            the operation
+     *
+     * If OCCT fails to fillet all edges at once, the edges are split into
+     * groups that don't touch a common face. The groups are checked in
+     * parallel, and if each of them succeeds on its own they are filleted
+     * one after another. Otherwise the exception names the failing edges.
+     *
+     * @return The original content of this TopoShape is discarded and replaced
+     *         with the new shape. The function returns the TopoShape itself as
+     *         a self reference so that multiple operations can be carried out
+     *         for the same shape in the same line of code.
+     */
+    TopoShape& makeElementFillet(const TopoShape& source,
+                                 const std::vector<TopoShape>& edges,
+                                 const std::vector<std::pair<double, double>>& radii,
+                                 const char* op = nullptr);
     /* Make fillet shape
      *
      * @param source: the source shape
@@ -2587,6 +2634,7 @@ public:
      */
 
     friend class TopoShapeCache;
+    friend class TopoShapeOpCache;
 
 private:
     // Cache storage
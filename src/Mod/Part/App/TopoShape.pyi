@@ -227,13 +227,18 @@ class TopoShape(ComplexGeoData):
         ...
 
     @constmethod
-    def check(self, runBopCheck: bool = False) -> bool:
+    def check(self, runBopCheck: bool = False, output: object = None) -> bool:
         """
         Checks the shape and report errors in the shape structure.
-        check([runBopCheck = False])
+        check([runBopCheck = False, output = None])
         --
         This is a more detailed check as done in isValid().
         if runBopCheck is True, a BOPCheck analysis is also performed.
+        The solids and shells of a compound are checked in parallel.
+
+        Without output a ValueError with all errors is raised if the shape is invalid.
+        If output is a file-like object the errors are written to it while the check
+        is running and the result of the check is returned.
         """
         ...
 
@@ -23,7 +23,12 @@
  ***************************************************************************/
 
 #include <cmath>
+#include <exception>
+#include <functional>
 #include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
 
 #ifndef _Standard_Version_HeaderFile
 # include <Standard_Version.hxx>
@@ -56,6 +61,7 @@
 #include <BRepBuilderAPI_MakeSolid.hxx>
 #include <BRepBuilderAPI_NurbsConvert.hxx>
 #include <BRepBuilderAPI_Transform.hxx>
+#include <BRepFilletAPI_LocalOperation.hxx>
 #include <BRepFilletAPI_MakeChamfer.hxx>
 #include <BRepFilletAPI_MakeFillet.hxx>
 #include <BRepLib.hxx>
@@ -76,7 +82,9 @@
 #include <ShapeBuild_ReShape.hxx>
 #include <ShapeConstruct_Curve.hxx>
 #include <ShapeUpgrade_ShellSewing.hxx>
+#include <TopTools_DataMapOfShapeInteger.hxx>
 #include <TopTools_HSequenceOfShape.hxx>
+#include <TopTools_IndexedDataMapOfShapeListOfShape.hxx>
 #include <ShapeFix_Shape.hxx>
 #include <ShapeFix_ShapeTolerance.hxx>
 #include <gp_Pln.hxx>
@@ -93,6 +101,7 @@
 #include "TopoShapeOpCode.h"
 #include "TopoShapeCache.h"
 #include "TopoShapeMapper.h"
+#include "TopoShapeOpCache.h"
 #include "FaceMaker.h"
 #include "Geometry.h"
 #include "BRepOffsetAPI_MakeOffsetFix.h"
@@ -1425,6 +1434,9 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
     ShapeInfo edgeInfo(_Shape, TopAbs_EDGE, _cache->getAncestry(TopAbs_EDGE));
     ShapeInfo faceInfo(_Shape, TopAbs_FACE, _cache->getAncestry(TopAbs_FACE));
     mapSubElement(shapes);  // Intentionally leave the op off here
+    // Usually every element of the new shape gets at least one name, make room for them at once
+    ensureElementMap()->reserve(getElementMapSize(false) + vertexInfo.count() + edgeInfo.count()
+                                + faceInfo.count());
 
     std::array<ShapeInfo*, 3> infos = {&vertexInfo, &edgeInfo, &faceInfo};
 
@@ -1439,6 +1451,7 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
     infoMap[TopAbs_COMPSOLID] = &faceInfo;
 
     std::ostringstream ss;
+    std::ostringstream ss2;
     std::string postfix;
     Data::MappedName newName;
 
@@ -1458,13 +1471,23 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
             }
             for (int i = 1; i <= otherMap.count(); i++) {
                 const auto& otherElement = otherMap.find(incomingShape._Shape, i);
-                // Find all new objects that are a modification of the old object
+                // Most elements of the input shapes are neither modified nor
+                // generate anything. Only look up the mapped name of the source
+                // element once it is actually needed.
                 Data::ElementIDRefs sids;
-                NameKey key(
-                    info.type,
-                    incomingShape.getMappedName(Data::IndexedName::fromConst(info.shapetype, i),
-                                                true,
-                                                &sids));
+                NameKey key(info.type, Data::MappedName());
+                bool hasKeyName = false;
+                auto setKeyName = [&]() {
+                    if (!hasKeyName) {
+                        hasKeyName = true;
+                        key.name = incomingShape.getMappedName(
+                            Data::IndexedName::fromConst(info.shapetype, i),
+                            true,
+                            &sids);
+                    }
+                };
+
+                // Find all new objects that are a modification of the old object
 
                 int newShapeCounter = 0;
                 for (auto& newShape : mapper.modified(otherElement)) {
@@ -1507,6 +1530,7 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
                         continue;
                     }
 
+                    setKeyName();
                     key.tag = incomingShape.Tag;
                     auto& name_info = newNames[element][key];
                     name_info.sids = sids;
@@ -1589,6 +1613,7 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
                             continue;
                         }
 
+                        setKeyName();
                         key.tag = incomingShape.Tag;
                         auto& name_info = newNames[element][key];
                         name_info.sids = sids;
@@ -1680,7 +1705,7 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
                         ss << '|';
                     }
                     auto& other_info = it->second;
-                    std::ostringstream ss2;
+                    ss2.str("");
                     if (other_info.index != 1) {
                         // 'K' marks the additional source shape of this
                         // generate (or modified) shape.
@@ -1774,6 +1799,7 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
         // upper element in the final pass) to lower element if it appears in
         // multiple higher elements, e.g. same edge in multiple faces.
 
+        TopTools_IndexedMapOfShape submap;
         for (size_t infoIndex = infos.size() - 1; infoIndex != 0; --infoIndex) {
             std::map<Data::IndexedName,
                      std::map<Data::MappedName, NameInfo, Data::ElementNameComparator>>
@@ -1814,7 +1840,8 @@ TopoShape& TopoShape::makeShapeWithElementMap(const TopoDS_Shape& shape,
                     continue;
                 }
 
-                TopTools_IndexedMapOfShape submap;
+                // Keep the buckets of the map, it is refilled for every element
+                submap.Clear(Standard_False);
                 TopExp::MapShapes(info.find(elementCounter), next.type, submap);
                 for (int submapIndex = 1, infoCounter = 1; submapIndex <= submap.Extent();
                      ++submapIndex) {
@@ -3953,10 +3980,7 @@ TopoShape& TopoShape::makeElementSlices(const TopoShape& shape,
 {
     std::vector<TopoShape> wires;
     TopoCrossSection cs(dir.x, dir.y, dir.z, shape, op);
-    int index = 0;
-    for (auto& distance : distances) {
-        cs.slice(++index, distance, wires);
-    }
+    cs.slices(distances, wires);
     return makeElementCompound(wires, op, SingleShapeCompoundCreationPolicy::returnShape);
 }
 
@@ -4002,11 +4026,202 @@ TopoShape& TopoShape::removeElementShape(const TopoShape& shape, const std::vect
     return *this;
 }
 
+namespace
+{
+
+// Creates the builder of a fillet or chamfer on the given edges of the shape. faces holds the
+// reference face of each edge, if any, and index the position of each edge in the list of input
+// edges.
+using DressUpMaker = std::function<std::unique_ptr<BRepFilletAPI_LocalOperation>(
+    const TopoShape& shape,
+    const std::vector<TopoDS_Edge>& edges,
+    const std::vector<TopoDS_Face>& faces,
+    const std::vector<std::size_t>& index)>;
+
+// Group the edges whose fillets or chamfers may depend on each other, i.e. the edges that touch
+// a common face at one of their vertices
+std::vector<std::vector<std::size_t>> groupDressUpEdges(const TopoDS_Shape& shape,
+                                                        const std::vector<TopoDS_Edge>& edges)
+{
+    TopTools_IndexedDataMapOfShapeListOfShape vertexFaces;
+    TopExp::MapShapesAndAncestors(shape, TopAbs_VERTEX, TopAbs_FACE, vertexFaces);
+
+    std::vector<std::size_t> parent(edges.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto root = [&parent](std::size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    TopTools_DataMapOfShapeInteger owners;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        for (TopExp_Explorer xp(edges[i], TopAbs_VERTEX); xp.More(); xp.Next()) {
+            int idx = vertexFaces.FindIndex(xp.Current());
+            if (idx == 0) {
+                continue;
+            }
+            for (TopTools_ListIteratorOfListOfShape it(vertexFaces(idx)); it.More(); it.Next()) {
+                if (const Standard_Integer* owner = owners.Seek(it.Value())) {
+                    parent[root(static_cast<std::size_t>(*owner))] = root(i);
+                }
+                else {
+                    owners.Bind(it.Value(), static_cast<int>(i));
+                }
+            }
+        }
+    }
+
+    std::map<std::size_t, std::size_t> groupIndex;
+    std::vector<std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < edges.size(); ++i) {
+        auto res = groupIndex.emplace(root(i), groups.size());
+        if (res.second) {
+            groups.emplace_back();
+        }
+        groups[res.first->second].push_back(i);
+    }
+    return groups;
+}
+
+// faces is either empty or holds the reference face of each edge, it is carried over to the
+// intermediate shapes like the edges
+void makeDressUp(TopoShape& result,
+                 const TopoShape& shape,
+                 const std::vector<TopoDS_Edge>& edges,
+                 const std::vector<TopoDS_Face>& faces,
+                 const DressUpMaker& maker,
+                 const char* op,
+                 const char* name)
+{
+    std::vector<std::size_t> all(edges.size());
+    std::iota(all.begin(), all.end(), 0);
+    std::exception_ptr failure;
+    try {
+        auto mk = maker(shape, edges, faces, all);
+        result.makeElementShape(*mk, shape, op);
+        return;
+    }
+    catch (Standard_Failure&) {
+        failure = std::current_exception();
+    }
+
+    // OCCT solves all edges as one problem, so a single bad edge fails the whole operation.
+    // Check the independent groups of edges in parallel to find the failing ones, and if each
+    // of them works on its own, apply them one after another.
+    auto groups = groupDressUpEdges(shape.getShape(), edges);
+    if (groups.size() <= 1) {
+        std::rethrow_exception(failure);
+    }
+
+    std::vector<int> edgeIndex;
+    edgeIndex.reserve(edges.size());
+    for (const auto& edge : edges) {
+        edgeIndex.push_back(shape.findShape(edge));
+    }
+    std::vector<int> faceIndex;
+    faceIndex.reserve(faces.size());
+    for (const auto& face : faces) {
+        faceIndex.push_back(shape.findShape(face));
+    }
+
+    std::vector<char> failed(groups.size(), 0);
+    OSD_Parallel::For(0, static_cast<int>(groups.size()), [&](int i) {
+        try {
+            // Each group works on its own copy of the topology, the geometry is shared
+            TopoShape copy(BRepBuilderAPI_Copy(shape.getShape(), Standard_False).Shape());
+            std::vector<TopoDS_Edge> groupEdges;
+            std::vector<TopoDS_Face> groupFaces;
+            for (auto idx : groups[i]) {
+                groupEdges.push_back(TopoDS::Edge(copy.getSubShape(TopAbs_EDGE, edgeIndex[idx])));
+                if (!faces.empty()) {
+                    groupFaces.push_back(
+                        TopoDS::Face(copy.getSubShape(TopAbs_FACE, faceIndex[idx])));
+                }
+            }
+            auto mk = maker(copy, groupEdges, groupFaces, groups[i]);
+            mk->Build();
+            failed[i] = mk->IsDone() ? 0 : 1;
+        }
+        catch (...) {
+            failed[i] = 1;
+        }
+    });
+
+    std::ostringstream failedEdges;
+    for (std::size_t i = 0; i < groups.size(); ++i) {
+        if (failed[i]) {
+            for (auto idx : groups[i]) {
+                failedEdges << " Edge" << edgeIndex[idx];
+            }
+        }
+    }
+    if (!failedEdges.str().empty()) {
+        FC_THROWM(Base::CADKernelError, "Failed to make " << name << " on" << failedEdges.str());
+    }
+
+    TopoShape current = shape;
+    std::vector<TopoDS_Shape> trackedEdges(edges.begin(), edges.end());
+    std::vector<TopoDS_Shape> trackedFaces(faces.begin(), faces.end());
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        std::vector<TopoDS_Edge> groupEdges;
+        std::vector<TopoDS_Face> groupFaces;
+        for (auto idx : groups[g]) {
+            groupEdges.push_back(TopoDS::Edge(trackedEdges[idx]));
+            if (!faces.empty()) {
+                groupFaces.push_back(TopoDS::Face(trackedFaces[idx]));
+            }
+        }
+        auto mk = maker(current, groupEdges, groupFaces, groups[g]);
+        TopoShape next(result.Tag, result.Hasher);
+        next.makeElementShape(*mk, current, op);
+
+        // The shapes of the remaining groups are usually not touched, otherwise follow the history
+        auto track = [&](TopoDS_Shape& tracked, TopAbs_ShapeEnum type, std::size_t idx) {
+            if (next.findShape(tracked) > 0) {
+                return;
+            }
+            const TopTools_ListOfShape& modified = mk->Modified(tracked);
+            if (modified.Extent() != 1 || modified.First().ShapeType() != type) {
+                FC_THROWM(Base::CADKernelError,
+                          "Failed to make " << name << " on Edge" << edgeIndex[idx]);
+            }
+            tracked = modified.First();
+        };
+        for (std::size_t k = g + 1; k < groups.size(); ++k) {
+            for (auto idx : groups[k]) {
+                track(trackedEdges[idx], TopAbs_EDGE, idx);
+                if (!faces.empty()) {
+                    track(trackedFaces[idx], TopAbs_FACE, idx);
+                }
+            }
+        }
+        current = next;
+    }
+    result = current;
+}
+
+}  // namespace
+
 TopoShape& TopoShape::makeElementFillet(const TopoShape& shape,
                                         const std::vector<TopoShape>& edges,
                                         double radius1,
                                         double radius2,
                                         const char* op)
+{
+    return makeElementFillet(shape,
+                             edges,
+                             std::vector<std::pair<double, double>>(edges.size(),
+                                                                    {radius1, radius2}),
+                             op);
+}
+
+TopoShape& TopoShape::makeElementFillet(const TopoShape& shape,
+                                        const std::vector<TopoShape>& edges,
+                                        const std::vector<std::pair<double, double>>& radii,
+                                        const char* op)
 {
     if (!op) {
         op = Part::OpCodes::Fillet;
@@ -4018,7 +4233,11 @@ TopoShape& TopoShape::makeElementFillet(const TopoShape& shape,
     if (edges.empty()) {
         FC_THROWM(NullShapeException, "Null input shape");
     }
-    BRepFilletAPI_MakeFillet mkFillet(shape.getShape());
+    if (radii.size() != edges.size()) {
+        FC_THROWM(Base::ValueError, "Number of radii does not match the number of edges");
+    }
+    std::vector<TopoDS_Edge> filletEdges;
+    filletEdges.reserve(edges.size());
     for (auto& e : edges) {
         if (e.isNull()) {
             FC_THROWM(NullShapeException, "Null input shape");
@@ -4027,9 +4246,21 @@ TopoShape& TopoShape::makeElementFillet(const TopoShape& shape,
         if (!shape.findShape(edge)) {
             FC_THROWM(Base::CADKernelError, "edge does not belong to the shape");
         }
-        mkFillet.Add(radius1, radius2, TopoDS::Edge(edge));
+        filletEdges.push_back(TopoDS::Edge(edge));
     }
-    return makeElementShape(mkFillet, shape, op);
+
+    auto maker = [&radii](const TopoShape& base,
+                          const std::vector<TopoDS_Edge>& dsEdges,
+                          const std::vector<TopoDS_Face>&,
+                          const std::vector<std::size_t>& index) {
+        auto mkFillet = std::make_unique<BRepFilletAPI_MakeFillet>(base.getShape());
+        for (std::size_t i = 0; i < dsEdges.size(); ++i) {
+            mkFillet->Add(radii[index[i]].first, radii[index[i]].second, dsEdges[i]);
+        }
+        return mkFillet;
+    };
+    makeDressUp(*this, shape, filletEdges, {}, maker, op, "fillet");
+    return *this;
 }
 
 TopoShape& TopoShape::makeElementChamfer(const TopoShape& shape,
@@ -4049,7 +4280,10 @@ TopoShape& TopoShape::makeElementChamfer(const TopoShape& shape,
     if (edges.empty()) {
         FC_THROWM(NullShapeException, "Null input shape");
     }
-    BRepFilletAPI_MakeChamfer mkChamfer(shape.getShape());
+    std::vector<TopoDS_Edge> chamferEdges;
+    std::vector<TopoDS_Face> chamferFaces;
+    chamferEdges.reserve(edges.size());
+    chamferFaces.reserve(edges.size());
     for (auto& e : edges) {
         const auto& edge = e.getShape();
         if (e.isNull()) {
@@ -4058,7 +4292,10 @@ TopoShape& TopoShape::makeElementChamfer(const TopoShape& shape,
         if (!shape.findShape(edge)) {
             FC_THROWM(Base::CADKernelError, "edge does not belong to the shape");
         }
-        // Add edge to fillet algorithm
+        chamferEdges.push_back(TopoDS::Edge(edge));
+        // The reference face is taken from the input shape. The order of the ancestors may
+        // differ on the intermediate shapes of a sequential chamfer, so it is mapped through
+        // their history instead of being searched again.
         TopoDS_Shape face;
         if (flipDirection == Flip::flip) {
             face = shape.findAncestorsShapes(edge, TopAbs_FACE).back();
@@ -4066,22 +4303,34 @@ TopoShape& TopoShape::makeElementChamfer(const TopoShape& shape,
         else {
             face = shape.findAncestorShape(edge, TopAbs_FACE);
         }
-        switch (chamferType) {
-            case ChamferType::equalDistance:  // Equal distance
-                mkChamfer.Add(radius1, radius1, TopoDS::Edge(edge), TopoDS::Face(face));
-                break;
-            case ChamferType::twoDistances:  // Two distances
-                mkChamfer.Add(radius1, radius2, TopoDS::Edge(edge), TopoDS::Face(face));
-                break;
-            case ChamferType::distanceAngle:  // Distance and angle
-                mkChamfer.AddDA(radius1,
-                                Base::toRadians(radius2),
-                                TopoDS::Edge(edge),
-                                TopoDS::Face(face));
-                break;
+        chamferFaces.push_back(TopoDS::Face(face));
+    }
+
+    auto maker = [=](const TopoShape& base,
+                     const std::vector<TopoDS_Edge>& dsEdges,
+                     const std::vector<TopoDS_Face>& dsFaces,
+                     const std::vector<std::size_t>&) {
+        auto mkChamfer = std::make_unique<BRepFilletAPI_MakeChamfer>(base.getShape());
+        for (std::size_t i = 0; i < dsEdges.size(); ++i) {
+            // Add edge to fillet algorithm
+            const TopoDS_Edge& edge = dsEdges[i];
+            const TopoDS_Face& face = dsFaces[i];
+            switch (chamferType) {
+                case ChamferType::equalDistance:  // Equal distance
+                    mkChamfer->Add(radius1, radius1, edge, face);
+                    break;
+                case ChamferType::twoDistances:  // Two distances
+                    mkChamfer->Add(radius1, radius2, edge, face);
+                    break;
+                case ChamferType::distanceAngle:  // Distance and angle
+                    mkChamfer->AddDA(radius1, Base::toRadians(radius2), edge, face);
+                    break;
+            }
         }
-    }
-    return makeElementShape(mkChamfer, shape, op);
+        return mkChamfer;
+    };
+    makeDressUp(*this, shape, chamferEdges, chamferFaces, maker, op, "chamfer");
+    return *this;
 }
 
 TopoShape& TopoShape::makeElementGeneralFuse(const std::vector<TopoShape>& _shapes,
@@ -5689,6 +5938,80 @@ TopoShape& TopoShape::makeElementBoolean(const char* maker,
 }
 
 
+// Runs the boolean operation with the first of the inputs as argument and the given tools. The
+// tools are made of the remaining inputs, the element map is built from the inputs.
+static TopoShape& makeBooleanShape(TopoShape& result,
+                                   const char* maker,
+                                   const std::vector<TopoShape>& inputs,
+                                   const TopTools_ListOfShape& tools,
+                                   const char* op,
+                                   double tolerance)
+{
+    auto& opCache = TopoShapeOpCache::instance();
+    std::unique_ptr<TopoShapeOpCache::Key> cacheKey;
+    if (opCache.isEnabled()) {
+        cacheKey = std::make_unique<TopoShapeOpCache::Key>(maker, result, inputs);
+        cacheKey->add(op).add(tolerance).add(static_cast<long>(tools.Extent()));
+        if (opCache.find(*cacheKey, result)) {
+            return result;
+        }
+    }
+
+    bool buildShell = true;
+    std::unique_ptr<BRepAlgoAPI_BooleanOperation> mk;
+    if (strcmp(maker, Part::OpCodes::Fuse) == 0) {
+        mk.reset(new FCBRepAlgoAPI_Fuse);
+    }
+    else if (strcmp(maker, Part::OpCodes::Cut) == 0) {
+        mk.reset(new FCBRepAlgoAPI_Cut);
+    }
+    else if (strcmp(maker, Part::OpCodes::Common) == 0) {
+        mk.reset(new FCBRepAlgoAPI_Common);
+    }
+    else if (strcmp(maker, Part::OpCodes::Section) == 0) {
+        mk.reset(new FCBRepAlgoAPI_Section);
+        buildShell = false;
+    }
+    else {
+        FC_THROWM(Base::CADKernelError, "Unknown maker");
+    }
+
+    if (inputs.front().isNull()) {
+        FC_THROWM(NullShapeException, "Null input shape");
+    }
+    TopTools_ListOfShape shapeArguments;
+    shapeArguments.Append(inputs.front().getShape());
+
+    mk->SetRunParallel(Standard_True);
+    OSD_Parallel::SetUseOcctThreads(Standard_True);
+
+    mk->SetArguments(shapeArguments);
+    mk->SetTools(tools);
+    if (tolerance > 0.0) {
+        mk->SetFuzzyValue(tolerance);
+    } else if (tolerance < 0.0) {
+        FCBRepAlgoAPIHelper::setAutoFuzzy(mk.get());
+    }
+#if OCC_VERSION_HEX >= 0x070600
+    mk->Build(OCCTProgressIndicator::getAppIndicator().Start());
+#else
+    mk->Build();
+#endif
+    if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
+        FC_THROWM(Base::CADKernelError, "User aborted");
+    }
+    result.makeElementShape(*mk, inputs, op);
+
+    if (buildShell) {
+        result.makeElementShell();
+    }
+    if (cacheKey) {
+        opCache.insert(*cacheKey, result);
+    }
+    return result;
+}
+
+
 // TODO: Refactor this so that each OpCode type is a separate method to reduce size
 TopoShape& TopoShape::makeElementBoolean(const char* maker,
                                          const std::vector<TopoShape>& shapes,
@@ -5776,8 +6099,6 @@ TopoShape& TopoShape::makeElementBoolean(const char* maker,
         return makeElementXor(shapes, op, tolerance);
     }
 
-    bool buildShell = true;
-
     std::vector<TopoShape> _shapes;
     if (strcmp(maker, Part::OpCodes::Fuse) == 0) {
         for (auto it = shapes.begin(); it != shapes.end(); ++it) {
@@ -5835,63 +6156,84 @@ TopoShape& TopoShape::makeElementBoolean(const char* maker,
         return *this;
     }
 
-    std::unique_ptr<BRepAlgoAPI_BooleanOperation> mk;
-    if (strcmp(maker, Part::OpCodes::Fuse) == 0) {
-        mk.reset(new FCBRepAlgoAPI_Fuse);
+    TopTools_ListOfShape shapeTools;
+    for (auto it = inputs.begin() + 1; it != inputs.end(); ++it) {
+        if (it->isNull()) {
+            FC_THROWM(NullShapeException, "Null input shape");
+        }
+        shapeTools.Append(it->getShape());
     }
-    else if (strcmp(maker, Part::OpCodes::Cut) == 0) {
-        mk.reset(new FCBRepAlgoAPI_Cut);
+    return makeBooleanShape(*this, maker, inputs, shapeTools, op, tolerance);
+}
+
+TopoShape& TopoShape::makeElementBoolean(const char* maker,
+                                         const TopoShape& source,
+                                         const std::vector<std::vector<TopoShape>>& toolGroups,
+                                         const char* op,
+                                         double tolerance)
+{
+    if (!maker) {
+        FC_THROWM(Base::CADKernelError, "no maker");
     }
-    else if (strcmp(maker, Part::OpCodes::Common) == 0) {
-        mk.reset(new FCBRepAlgoAPI_Common);
+    if (strcmp(maker, Part::OpCodes::Fuse) != 0 && strcmp(maker, Part::OpCodes::Cut) != 0
+        && strcmp(maker, Part::OpCodes::Common) != 0) {
+        FC_THROWM(Base::CADKernelError, "Unsupported maker for tool groups");
     }
-    else if (strcmp(maker, Part::OpCodes::Section) == 0) {
-        mk.reset(new FCBRepAlgoAPI_Section);
-        buildShell = false;
+    if (!op) {
+        op = maker;
     }
-    else {
-        FC_THROWM(Base::CADKernelError, "Unknown maker");
+    if (source.isNull()) {
+        FC_THROWM(NullShapeException, "Null input shape");
     }
 
-    TopTools_ListOfShape shapeArguments, shapeTools;
+    // Expand the compounds the same way as above, so that the element map is built from
+    // the same inputs as when passing all tools separately
+    const bool isFuse = strcmp(maker, Part::OpCodes::Fuse) == 0;
+    const bool expandTools = isFuse || strcmp(maker, Part::OpCodes::Cut) == 0;
+    std::vector<TopoShape> inputs;
+    if (isFuse) {
+        expandCompound(source, inputs);
+    }
+    else {
+        inputs.push_back(source);
+    }
 
-    int i = -1;
-    for (const auto& shape : inputs) {
-        if (shape.isNull()) {
-            FC_THROWM(NullShapeException, "Null input shape");
+    TopTools_ListOfShape shapeTools;
+    for (auto it = inputs.begin() + 1; it != inputs.end(); ++it) {
+        shapeTools.Append(it->getShape());
+    }
+    BRep_Builder builder;
+    for (const auto& group : toolGroups) {
+        auto first = inputs.size();
+        for (const auto& tool : group) {
+            if (tool.isNull()) {
+                FC_THROWM(NullShapeException, "Null input shape");
+            }
+            if (expandTools) {
+                expandCompound(tool, inputs);
+            }
+            else {
+                inputs.push_back(tool);
+            }
         }
-        if (++i == 0) {
-            shapeArguments.Append(shape.getShape());
+        if (inputs.size() - first == 1) {
+            shapeTools.Append(inputs.back().getShape());
         }
-        else {
-            shapeTools.Append(shape.getShape());
+        else if (inputs.size() > first) {
+            TopoDS_Compound comp;
+            builder.MakeCompound(comp);
+            for (auto i = first; i < inputs.size(); ++i) {
+                builder.Add(comp, inputs[i].getShape());
+            }
+            shapeTools.Append(comp);
         }
     }
 
-    mk->SetRunParallel(Standard_True);
-    OSD_Parallel::SetUseOcctThreads(Standard_True);
-
-    mk->SetArguments(shapeArguments);
-    mk->SetTools(shapeTools);
-    if (tolerance > 0.0) {
-        mk->SetFuzzyValue(tolerance);
-    } else if (tolerance < 0.0) {
-        FCBRepAlgoAPIHelper::setAutoFuzzy(mk.get());
-    }
-#if OCC_VERSION_HEX >= 0x070600
-    mk->Build(OCCTProgressIndicator::getAppIndicator().Start());
-#else
-    mk->Build();
-#endif
-    if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
-        FC_THROWM(Base::CADKernelError, "User aborted");
-    }
-    makeElementShape(*mk, inputs, op);
-
-    if (buildShell) {
-        makeElementShell();
+    if (inputs.size() == 1) {
+        *this = inputs[0];
+        return *this;
     }
-    return *this;
+    return makeBooleanShape(*this, maker, inputs, shapeTools, op, tolerance);
 }
 
 bool TopoShape::isSame(const Data::ComplexGeoData& _other) const
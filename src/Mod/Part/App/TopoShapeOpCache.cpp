@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string_view>
+
+#include <boost/signals2/connection.hpp>
+#include <lru/lru.hpp>
+
+#include <App/Application.h>
+#include <App/Document.h>
+
+#include "TopoShapeOpCache.h"
+#include "ShapeMapHasher.h"
+
+using namespace Part;
+
+namespace
+{
+constexpr std::size_t DEFAULT_CACHE_SIZE = 64;
+
+void hashCombine(std::size_t& seed, std::size_t value)
+{
+    // same mixing as boost::hash_combine
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+// The names of the result are derived from those of the inputs, so inputs with the same shape
+// but different element maps must not share an entry.
+std::size_t elementMapHash(const TopoShape& shape)
+{
+    std::size_t seed = 0;
+    for (const auto& element : shape.getElementMap()) {
+        hashCombine(seed, element.name.hash());
+        hashCombine(seed, std::hash<std::string_view>()(element.index.getType()));
+        hashCombine(seed, std::hash<int>()(element.index.getIndex()));
+    }
+    return seed;
+}
+}  // namespace
+
+// The statistics of LRU::Cache always use std::hash of the key type
+template<>
+struct std::hash<TopoShapeOpCache::Key>
+{
+    std::size_t operator()(const TopoShapeOpCache::Key& key) const
+    {
+        return key.hash();
+    }
+};
+
+TopoShapeOpCache::Key::Key(const char* opcode,
+                           const TopoShape& result,
+                           const std::vector<TopoShape>& inputs)
+{
+    add(opcode);
+    tags.reserve(inputs.size() + 1);
+    hashers.reserve(inputs.size() + 1);
+    shapes.reserve(inputs.size());
+    elementMaps.reserve(inputs.size());
+
+    tags.push_back(result.Tag);
+    hashers.push_back(result.Hasher);
+    combine(std::hash<long>()(result.Tag));
+    for (const auto& shape : inputs) {
+        shapes.push_back(shape.getShape());
+        tags.push_back(shape.Tag);
+        hashers.push_back(shape.Hasher);
+        elementMaps.push_back(elementMapHash(shape));
+        combine(ShapeMapHasher()(shape.getShape()));
+        combine(std::hash<long>()(shape.Tag));
+        combine(elementMaps.back());
+    }
+}
+
+void TopoShapeOpCache::Key::combine(std::size_t value)
+{
+    hashCombine(hashValue, value);
+}
+
+TopoShapeOpCache::Key& TopoShapeOpCache::Key::add(double value)
+{
+    // Compare the exact bit pattern, a rounded text representation could merge
+    // parameters that lead to different results.
+    char buf[sizeof(double)];
+    std::memcpy(buf, &value, sizeof(double));
+    params.append(buf, sizeof(double));
+    combine(std::hash<double>()(value));
+    return *this;
+}
+
+TopoShapeOpCache::Key& TopoShapeOpCache::Key::add(long value)
+{
+    char buf[sizeof(long)];
+    std::memcpy(buf, &value, sizeof(long));
+    params.append(buf, sizeof(long));
+    combine(std::hash<long>()(value));
+    return *this;
+}
+
+TopoShapeOpCache::Key& TopoShapeOpCache::Key::add(const char* value)
+{
+    std::string str(value ? value : "");
+    combine(std::hash<std::string>()(str));
+    params += str;
+    params += '\0';
+    return *this;
+}
+
+bool TopoShapeOpCache::Key::operator==(const Key& other) const
+{
+    if (hashValue != other.hashValue || params != other.params || tags != other.tags
+        || elementMaps != other.elementMaps || shapes.size() != other.shapes.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < hashers.size(); ++i) {
+        if (static_cast<App::StringHasher*>(hashers[i])
+            != static_cast<App::StringHasher*>(other.hashers[i])) {
+            return false;
+        }
+    }
+    for (std::size_t i = 0; i < shapes.size(); ++i) {
+        // IsEqual compares the TShape, the location and the orientation
+        if (!shapes[i].IsEqual(other.shapes[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TopoShapeOpCache::Key::hasHasher(const App::StringHasherRef& hasher) const
+{
+    return std::any_of(hashers.begin(), hashers.end(), [&hasher](const auto& ref) {
+        return static_cast<App::StringHasher*>(ref) == static_cast<App::StringHasher*>(hasher);
+    });
+}
+
+// ----------------------------------------------------------------------------
+
+class TopoShapeOpCache::Private
+{
+public:
+    Private()
+        : cache(DEFAULT_CACHE_SIZE)
+    {}
+
+    struct Entry
+    {
+        TopoDS_Shape shape;
+        long tag = 0;
+        App::StringHasherRef hasher;
+        Data::ElementMapPtr elementMap;
+    };
+
+    mutable std::mutex mutex;
+    std::atomic<bool> enabled {false};
+    LRU::Cache<Key, std::shared_ptr<const Entry>> cache;
+    boost::signals2::scoped_connection connDeleteDocument;
+};
+
+TopoShapeOpCache::TopoShapeOpCache()
+    : d(new Private)
+{
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/General");
+    d->enabled = hGrp->GetBool("EnableOperationCache", false);
+    auto size = hGrp->GetInt("OperationCacheSize", static_cast<long>(DEFAULT_CACHE_SIZE));
+    d->cache.capacity(size > 0 ? static_cast<std::size_t>(size) : DEFAULT_CACHE_SIZE);
+
+    // The entries keep the string hasher of the document alive
+    d->connDeleteDocument = App::GetApplication().signalDeleteDocument.connect(
+        [this](const App::Document& doc) {
+            clear(doc.getStringHasher());
+        });
+}
+
+TopoShapeOpCache::~TopoShapeOpCache() = default;
+
+TopoShapeOpCache& TopoShapeOpCache::instance()
+{
+    static TopoShapeOpCache inst;
+    return inst;
+}
+
+bool TopoShapeOpCache::isEnabled() const
+{
+    return d->enabled;
+}
+
+void TopoShapeOpCache::setEnabled(bool on)
+{
+    d->enabled = on;
+    if (!on) {
+        clear();
+    }
+}
+
+std::size_t TopoShapeOpCache::capacity() const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->cache.capacity();
+}
+
+void TopoShapeOpCache::setCapacity(std::size_t size)
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->cache.capacity(size);
+}
+
+std::size_t TopoShapeOpCache::size() const
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    return d->cache.size();
+}
+
+void TopoShapeOpCache::clear()
+{
+    std::lock_guard<std::mutex> lock(d->mutex);
+    d->cache.clear();
+}
+
+void TopoShapeOpCache::clear(const App::StringHasherRef& hasher)
+{
+    if (hasher.isNull()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(d->mutex);
+    std::vector<Key> keys;
+    for (auto it = d->cache.begin(); it != d->cache.end(); ++it) {
+        auto entryHasher = static_cast<App::StringHasher*>(it.value()->hasher);
+        if (entryHasher == static_cast<App::StringHasher*>(hasher) || it.key().hasHasher(hasher)) {
+            keys.push_back(it.key());
+        }
+    }
+    for (const auto& key : keys) {
+        d->cache.erase(key);
+    }
+}
+
+bool TopoShapeOpCache::find(const Key& key, TopoShape& result) const
+{
+    if (!d->enabled) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(d->mutex);
+    if (!d->cache.contains(key)) {
+        return false;
+    }
+    const auto& entry = *d->cache.lookup(key);
+    result = TopoShape(entry.tag, entry.hasher, entry.shape);
+    if (entry.elementMap) {
+        result.resetElementMap(entry.elementMap->copy());
+    }
+    return true;
+}
+
+void TopoShapeOpCache::insert(const Key& key, const TopoShape& result)
+{
+    if (!d->enabled) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(d->mutex);
+    if (d->cache.capacity() > 0) {
+        auto entry = std::make_shared<Private::Entry>();
+        entry->shape = result.getShape();
+        entry->tag = result.Tag;
+        entry->hasher = result.Hasher;
+        if (auto elementMap = result.elementMap()) {
+            entry->elementMap = elementMap->copy();
+        }
+        d->cache.insert(key, entry);
+    }
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PART_TOPOSHAPEOPCACHE_H
+#define PART_TOPOSHAPEOPCACHE_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <TopoDS_Shape.hxx>
+
+#include <Mod/Part/PartGlobal.h>
+
+#include "TopoShape.h"
+
+namespace Part
+{
+
+/** Memoization of TopoShape operations across recomputes
+ *
+ * A recompute of a document often repeats operations whose inputs did not change, e.g. the
+ * boolean of a feature that is only touched because a sibling changed. The cache remembers the
+ * result of such an operation, including its element map, so that the identical call can
+ * return it without invoking OCCT again.
+ *
+ * An entry is identified by the operation code and its parameters, the TopoDS_Shape of each
+ * input (i.e. the identity of its TShape, its location and orientation) together with the tag,
+ * string hasher and a hash of the element map of the inputs and of the result. The key holds a
+ * reference to every input shape and hasher so neither can be released and its address reused
+ * while the entry exists. The entries using the string hasher of a document are dropped when the
+ * document is closed.
+ *
+ * The element map of a cached result is copied when it is stored and when it is returned, so
+ * the caller may modify it without affecting the cache.
+ *
+ * The cache is opt-in and bounded by a least recently used policy. It is configured by the
+ * parameters EnableOperationCache and OperationCacheSize in the group
+ * "User parameter:BaseApp/Preferences/Mod/Part/General". All functions are thread safe.
+ */
+class PartExport TopoShapeOpCache
+{
+public:
+    class PartExport Key
+    {
+    public:
+        /** Create a key
+         * @param opcode: the operation, usually one of the codes of TopoShapeOpCode.h
+         * @param result: the shape the operation is performed on. Its tag and hasher are used
+         *                for the element map of the result.
+         * @param inputs: the input shapes of the operation
+         */
+        Key(const char* opcode, const TopoShape& result, const std::vector<TopoShape>& inputs);
+
+        /// Append a parameter of the operation to the key
+        Key& add(double value);
+        Key& add(long value);
+        Key& add(const char* value);
+
+        bool operator==(const Key& other) const;
+        std::size_t hash() const
+        {
+            return hashValue;
+        }
+
+        /// Check if the key refers to the given string hasher
+        bool hasHasher(const App::StringHasherRef& hasher) const;
+
+    private:
+        void combine(std::size_t value);
+
+    private:
+        std::string params;
+        std::vector<TopoDS_Shape> shapes;
+        std::vector<long> tags;
+        std::vector<App::StringHasherRef> hashers;
+        std::vector<std::size_t> elementMaps;
+        std::size_t hashValue {0};
+    };
+
+    static TopoShapeOpCache& instance();
+
+    ~TopoShapeOpCache();
+
+    bool isEnabled() const;
+    void setEnabled(bool on);
+
+    std::size_t capacity() const;
+    void setCapacity(std::size_t size);
+
+    std::size_t size() const;
+    void clear();
+
+    /// Forget the operations whose inputs or result use the given string hasher
+    void clear(const App::StringHasherRef& hasher);
+
+    /** Look up the result of an operation
+     * @param key: the key of the operation
+     * @param result: receives the cached shape if there is one
+     * @return true if the operation was found in the cache
+     */
+    bool find(const Key& key, TopoShape& result) const;
+
+    /// Remember the result of an operation
+    void insert(const Key& key, const TopoShape& result);
+
+private:
+    TopoShapeOpCache();
+
+private:
+    class Private;
+    std::unique_ptr<Private> d;
+};
+
+}  // namespace Part
+
+#endif  // PART_TOPOSHAPEOPCACHE_H
@@ -659,9 +659,27 @@ PyObject* TopoShapePy::revolve(PyObject *args) const
 PyObject*  TopoShapePy::check(PyObject *args) const
 {
     PyObject* runBopCheck = Py_False;
-    if (!PyArg_ParseTuple(args, "|O!", &(PyBool_Type), &runBopCheck))
+    PyObject* output = Py_None;
+    if (!PyArg_ParseTuple(args, "|O!O", &(PyBool_Type), &runBopCheck, &output))
         return nullptr;
 
+    if (output != Py_None) {
+        // write the errors to the file-like object while the check is running
+        if (!PyObject_HasAttrString(output, "write")) {
+            PyErr_SetString(PyExc_TypeError, "output must have a write method");
+            return nullptr;
+        }
+
+        PY_TRY {
+            Base::PyStreambuf buf(output);
+            std::ostream str(nullptr);
+            str.rdbuf(&buf);
+            bool valid = getTopoShapePtr()->analyze(Base::asBoolean(runBopCheck), str);
+            str.flush();
+            return Py::new_reference_to(Py::Boolean(valid));
+        } PY_CATCH_OCC
+    }
+
     if (!getTopoShapePtr()->getShape().IsNull()) {
         std::stringstream str;
         if (!getTopoShapePtr()->analyze(Base::asBoolean(runBopCheck), str)) {
@@ -20,6 +20,8 @@
  *                                                                          *
  ****************************************************************************/
 
+#include <exception>
+#include <initializer_list>
 #include <limits>
 
 #include <boost/core/ignore_unused.hpp>
@@ -43,6 +45,7 @@
 # include <GeomAdaptor_Curve.hxx>
 # include <GeomLProp_CLProps.hxx>
 # include <GProp_GProps.hxx>
+# include <OSD_Parallel.hxx>
 # include <ShapeAnalysis_Wire.hxx>
 # include <ShapeFix_ShapeTolerance.hxx>
 # include <ShapeExtend_WireData.hxx>
@@ -50,6 +53,7 @@
 # include <ShapeFix_Shape.hxx>
 # include <TopExp.hxx>
 # include <TopExp_Explorer.hxx>
+# include <TopoDS_Iterator.hxx>
 # include <TopTools_HSequenceOfShape.hxx>
 
 #include <BRepTools_History.hxx>
@@ -994,17 +998,84 @@ public:
         }
     };
 
-    void checkSelfIntersection(const EdgeInfo &info, std::set<IntersectInfo> &params) const
+    // Make a copy of the given edges sharing the geometry but not the topology. The intersection
+    // is checked concurrently, and building a wire may modify the tolerance of the vertices.
+    static std::vector<TopoDS_Edge> copyEdges(std::initializer_list<TopoDS_Edge> edges)
+    {
+        TopoDS_Compound comp;
+        BRep_Builder builder;
+        builder.MakeCompound(comp);
+        for (const auto& edge : edges) {
+            builder.Add(comp, edge);
+        }
+        std::vector<TopoDS_Edge> res;
+        for (TopoDS_Iterator it(BRepBuilderAPI_Copy(comp, Standard_False).Shape()); it.More();
+             it.Next()) {
+            res.push_back(TopoDS::Edge(it.Value()));
+        }
+        return res;
+    }
+
+    struct VertexTolerance {
+        TopoDS_Vertex vertex;
+        double tolerance;
+    };
+
+    // Collect the vertex tolerances that were raised on the copies while checking the
+    // intersection. They are applied to the original vertices in the order of the checks
+    // afterwards, like checking the original edges one by one would do.
+    static void collectTolerances(std::initializer_list<TopoDS_Edge> edges,
+                                  const std::vector<TopoDS_Edge>& copies,
+                                  std::vector<VertexTolerance>& tolerances)
+    {
+        std::size_t i = 0;
+        for (const auto& edge : edges) {
+            TopoDS_Vertex vertices[2];
+            TopoDS_Vertex copied[2];
+            TopExp::Vertices(edge, vertices[0], vertices[1]);
+            TopExp::Vertices(copies[i++], copied[0], copied[1]);
+            for (int j = 0; j < 2; ++j) {
+                if (vertices[j].IsNull() || copied[j].IsNull()) {
+                    continue;
+                }
+                double tol = BRep_Tool::Tolerance(copied[j]);
+                if (tol > BRep_Tool::Tolerance(vertices[j])) {
+                    tolerances.push_back({vertices[j], tol});
+                }
+            }
+        }
+    }
+
+    void applyTolerances(const std::vector<VertexTolerance>& tolerances)
+    {
+        for (const auto& it : tolerances) {
+            // only ever raises the tolerance
+            builder.UpdateVertex(it.vertex, it.tolerance);
+        }
+    }
+
+    void checkSelfIntersection(const EdgeInfo &info,
+                               std::vector<IntersectInfo> &params,
+                               std::vector<VertexTolerance> &tolerances) const
     {
         // Early return if checking for self intersection (only for non linear spline curves)
         if (info.type <= GeomAbs_Parabola || info.isLinear) {
             return;
         }
+        auto copies = copyEdges({info.edge});
+        checkSelfIntersection(info, copies.front(), params);
+        collectTolerances({info.edge}, copies, tolerances);
+    }
+
+    void checkSelfIntersection(const EdgeInfo &info,
+                               const TopoDS_Edge &edge,
+                               std::vector<IntersectInfo> &params) const
+    {
         IntRes2d_SequenceOfIntersectionPoint points2d;
         TColgp_SequenceOfPnt points3d;
         TColStd_SequenceOfReal errors;
         TopoDS_Wire wire;
-        BRepBuilderAPI_MakeWire mkWire(info.edge);
+        BRepBuilderAPI_MakeWire mkWire(edge);
         if (!mkWire.IsDone()) {
             return;
         }
@@ -1026,8 +1097,8 @@ public:
 
         ENSURE(points2d.Length() == points3d.Length());
         for (int i=1; i<=points2d.Length(); ++i) {
-            params.emplace(points2d(i).ParamOnFirst(), points3d(i), info.edge);
-            params.emplace(points2d(i).ParamOnSecond(), points3d(i), info.edge);
+            params.emplace_back(points2d(i).ParamOnFirst(), points3d(i), info.edge);
+            params.emplace_back(points2d(i).ParamOnSecond(), points3d(i), info.edge);
         }
     }
 
@@ -1035,19 +1106,21 @@ public:
     // cognitive complexity
     bool checkIntersectionPlanar(const EdgeInfo& info,
                                  const EdgeInfo& other,
-                                 std::set<IntersectInfo>& params1,
-                                 std::set<IntersectInfo>& params2)
+                                 const TopoDS_Edge& edge,
+                                 const TopoDS_Edge& otherEdge,
+                                 std::vector<IntersectInfo>& params1,
+                                 std::vector<IntersectInfo>& params2) const
     {
         gp_Pln pln;
-        bool planar = TopoShape(info.edge).findPlane(pln);
+        bool planar = TopoShape(edge).findPlane(pln);
         if (!planar) {
             TopoDS_Compound comp;
             builder.MakeCompound(comp);
-            builder.Add(comp, info.edge);
-            builder.Add(comp, other.edge);
+            builder.Add(comp, edge);
+            builder.Add(comp, otherEdge);
             planar = TopoShape(comp).findPlane(pln);
             if (!planar) {
-                BRepExtrema_DistShapeShape extss(info.edge, other.edge);
+                BRepExtrema_DistShapeShape extss(edge, otherEdge);
                 extss.Perform();
                 if (extss.IsDone() && extss.NbSolution() > 0) {
                     if (!extss.IsDone() || extss.NbSolution() <= 0 || extss.Value() >= myTol) {
@@ -1060,11 +1133,11 @@ public:
                     auto s2 = extss.SupportOnShape2(i);
                     if (s1.ShapeType() == TopAbs_EDGE) {
                         extss.ParOnEdgeS1(i, par);
-                        pushIntersection(params1, par, extss.PointOnShape1(i), other.edge);
+                        params1.emplace_back(par, extss.PointOnShape1(i), other.edge);
                     }
                     if (s2.ShapeType() == TopAbs_EDGE) {
                         extss.ParOnEdgeS2(i, par);
-                        pushIntersection(params2, par, extss.PointOnShape2(i), info.edge);
+                        params2.emplace_back(par, extss.PointOnShape2(i), info.edge);
                     }
                 }
                 return false;
@@ -1104,11 +1177,13 @@ public:
     // cognitive complexity
     static bool checkIntersectionMakeWire(const EdgeInfo& info,
                                           const EdgeInfo& other,
+                                          const TopoDS_Edge& edge,
+                                          const TopoDS_Edge& otherEdge,
                                           int& idx,
                                           TopoDS_Wire& wire)
     {
-        BRepBuilderAPI_MakeWire mkWire(info.edge);
-        mkWire.Add(other.edge);
+        BRepBuilderAPI_MakeWire mkWire(edge);
+        mkWire.Add(otherEdge);
         if (mkWire.IsDone()) {
             idx = 2;
         }
@@ -1121,7 +1196,7 @@ public:
             }
 
             mkWire.Add(mkEdge.Edge());
-            mkWire.Add(other.edge);
+            mkWire.Add(otherEdge);
         }
 
         if (!checkIntersectionWireDone(mkWire)) {
@@ -1157,12 +1232,28 @@ public:
         return true;
     }
 
+    // Collects the intersections of two edges. This function is called concurrently, the found
+    // intersections and tolerances are merged by pushIntersection() and applyTolerances()
+    // afterwards.
+    void checkIntersection(const EdgeInfo &info,
+                           const EdgeInfo &other,
+                           std::vector<IntersectInfo> &params1,
+                           std::vector<IntersectInfo> &params2,
+                           std::vector<VertexTolerance> &tolerances) const
+    {
+        auto copies = copyEdges({info.edge, other.edge});
+        checkIntersection(info, other, copies[0], copies[1], params1, params2);
+        collectTolerances({info.edge, other.edge}, copies, tolerances);
+    }
+
     void checkIntersection(const EdgeInfo &info,
                            const EdgeInfo &other,
-                           std::set<IntersectInfo> &params1,
-                           std::set<IntersectInfo> &params2)
+                           const TopoDS_Edge &edge,
+                           const TopoDS_Edge &otherEdge,
+                           std::vector<IntersectInfo> &params1,
+                           std::vector<IntersectInfo> &params2) const
     {
-        if(!checkIntersectionPlanar(info, other, params1, params2)){
+        if(!checkIntersectionPlanar(info, other, edge, otherEdge, params1, params2)){
             return;
         }
 
@@ -1178,7 +1269,7 @@ public:
         TopoDS_Wire wire;
         int idx = 0;
 
-        if (!checkIntersectionMakeWire(info, other, idx, wire)){
+        if (!checkIntersectionMakeWire(info, other, edge, otherEdge, idx, wire)){
             return;
         }
 
@@ -1193,8 +1284,8 @@ public:
 
         ENSURE(points2d.Length() == points3d.Length());
         for (int i=1; i<=points2d.Length(); ++i) {
-            pushIntersection(params1, points2d(i).ParamOnFirst(), points3d(i), other.edge);
-            pushIntersection(params2, points2d(i).ParamOnSecond(), points3d(i), info.edge);
+            params1.emplace_back(points2d(i).ParamOnFirst(), points3d(i), other.edge);
+            params2.emplace_back(points2d(i).ParamOnSecond(), points3d(i), info.edge);
         }
     }
 
@@ -1293,20 +1384,79 @@ public:
         std::unique_ptr<Base::SequencerLauncher> seq(
                 new Base::SequencerLauncher("Splitting edges", edges.size()));
 
+        // The intersections of a block of edges are computed concurrently. They are merged in
+        // the same order as checked, so the result doesn't depend on the number of threads.
+        struct IntersectTask {
+            EdgeInfo* info {};
+            std::vector<EdgeInfo*> others;
+            std::vector<IntersectInfo> selfParams;
+            std::vector<std::pair<std::vector<IntersectInfo>, std::vector<IntersectInfo>>> params;
+            std::vector<std::vector<VertexTolerance>> tolerances;
+            std::exception_ptr error;
+        };
+        const std::size_t blockSize = 256;
+        std::vector<IntersectTask> tasks;
+        tasks.reserve(std::min(blockSize, edges.size()));
+
         idx = 0;
-        for (auto& info : edges) {
-            seq->next(true);
-            ++idx;
-            auto &params = intersects[&info];
-            checkSelfIntersection(info, params);
+        for (auto itBlock = edges.begin(); itBlock != edges.end();) {
+            tasks.clear();
+            for (; itBlock != edges.end() && tasks.size() < blockSize; ++itBlock) {
+                auto& info = *itBlock;
+                ++idx;
+                tasks.emplace_back();
+                auto& task = tasks.back();
+                task.info = &info;
+                for (auto vit=boxMap.qbegin(bgi::intersects(info.box)); vit!=boxMap.qend(); ++vit) {
+                    auto &other = *(*vit);
+                    if (other.iteration <= idx) {
+                        // means the edge is before us, and we've already checked intersection
+                        continue;
+                    }
+                    task.others.push_back(&other);
+                }
+            }
+
+            OSD_Parallel::For(0, static_cast<int>(tasks.size()), [this, &tasks](int i) {
+                auto& task = tasks[i];
+                try {
+                    task.params.resize(task.others.size());
+                    task.tolerances.resize(task.others.size() + 1);
+                    checkSelfIntersection(*task.info, task.selfParams, task.tolerances[0]);
+                    for (std::size_t j = 0; j < task.others.size(); ++j) {
+                        checkIntersection(*task.info,
+                                          *task.others[j],
+                                          task.params[j].first,
+                                          task.params[j].second,
+                                          task.tolerances[j + 1]);
+                    }
+                }
+                catch (...) {
+                    task.error = std::current_exception();
+                }
+            });
 
-            for (auto vit=boxMap.qbegin(bgi::intersects(info.box)); vit!=boxMap.qend(); ++vit) {
-                const auto &other = *(*vit);
-                if (other.iteration <= idx) {
-                    // means the edge is before us, and we've already checked intersection
-                    continue;
+            for (auto& task : tasks) {
+                seq->next(true);
+                if (task.error) {
+                    std::rethrow_exception(task.error);
+                }
+                auto &params = intersects[task.info];
+                params.insert(task.selfParams.begin(), task.selfParams.end());
+                applyTolerances(task.tolerances[0]);
+                for (std::size_t j = 0; j < task.others.size(); ++j) {
+                    applyTolerances(task.tolerances[j + 1]);
+                    for (const auto& param : task.params[j].first) {
+                        pushIntersection(params, param.param, param.point, param.intersectShape);
+                    }
+                    auto &otherParams = intersects[task.others[j]];
+                    for (const auto& param : task.params[j].second) {
+                        pushIntersection(otherParams,
+                                         param.param,
+                                         param.point,
+                                         param.intersectShape);
+                    }
                 }
-                checkIntersection(info, other, params, intersects[&other]);
             }
         }
 
@@ -31,10 +31,8 @@
 # include <QTreeView>
 # include <Standard_Version.hxx>
 # include <Bnd_Box.hxx>
-# include <BOPAlgo_ArgumentAnalyzer.hxx>
 # include <BOPAlgo_ListOfCheckResult.hxx>
 # include <BRepBndLib.hxx>
-# include <BRepBuilderAPI_Copy.hxx>
 # include <BRepCheck_Analyzer.hxx>
 # include <BRepCheck_ListIteratorOfListOfStatus.hxx>
 # include <BRepCheck_Result.hxx>
@@ -62,6 +60,7 @@
 #include <Gui/Selection/Selection.h>
 #include <Gui/ViewProvider.h>
 #include <Gui/WaitCursor.h>
+#include <Mod/Part/App/BOPCheck.h>
 #include <Mod/Part/App/PartFeature.h>
 
 #include "TaskCheckGeometry.h"
@@ -479,7 +478,11 @@ void TaskCheckGeometryResults::goCheck()
 
         buildShapeContent(sel.pObject, baseName, shape);
 
+#if OCC_VERSION_HEX >= 0x070600
+        BRepCheck_Analyzer shapeCheck(shape, Standard_True, Standard_True);
+#else
         BRepCheck_Analyzer shapeCheck(shape);
+#endif
         if (!shapeCheck.IsValid())
         {
             invalidShapes++;
@@ -721,45 +724,37 @@ int TaskCheckGeometryResults::goBOPSingleCheck(const TopoDS_Shape& shapeIn, Resu
 
   //BOPAlgo_ArgumentAnalyzer can check 2 objects with respect to a boolean op.
   //this is left for another time.
-  TopoDS_Shape BOPCopy = BRepBuilderAPI_Copy(shapeIn).Shape();
-  BOPAlgo_ArgumentAnalyzer BOPCheck;
-
-#if OCC_VERSION_HEX < 0x070600
-  BOPCheck.SetProgressIndicator(theScope);
-#else
-  Q_UNUSED(theScope)
-#endif // 0x070600
-
-
-  BOPCheck.SetShape1(BOPCopy);
-  //all settings are false by default. so only turn on what we want.
-  BOPCheck.ArgumentTypeMode() = argumentTypeMode;
-  BOPCheck.SelfInterMode() = selfInterMode;
-  BOPCheck.SmallEdgeMode() = smallEdgeMode;
-  BOPCheck.RebuildFaceMode() = rebuildFaceMode;
-  BOPCheck.ContinuityMode() = continuityMode;
-
-  BOPCheck.SetParallelMode(!runSingleThreaded); //this doesn't help for speed right now(occt 6.9.1).
-  BOPCheck.SetRunParallel(!runSingleThreaded); //performance boost, use all available cores
-  BOPCheck.TangentMode() = tangentMode; //these 4 new tests add about 5% processing time.
-  BOPCheck.MergeVertexMode() = mergeVertexMode;
-  BOPCheck.MergeEdgeMode() = mergeEdgeMode;
-  BOPCheck.CurveOnSurfaceMode() = curveOnSurfaceMode;
+  Part::BOPCheck::Settings settings;
+  settings.argumentTypeMode = argumentTypeMode;
+  settings.selfInterMode = selfInterMode;
+  settings.smallEdgeMode = smallEdgeMode;
+  settings.rebuildFaceMode = rebuildFaceMode;
+  settings.continuityMode = continuityMode;
+  settings.tangentMode = tangentMode;
+  settings.mergeVertexMode = mergeVertexMode;
+  settings.mergeEdgeMode = mergeEdgeMode;
+  settings.curveOnSurfaceMode = curveOnSurfaceMode;
+  settings.runParallel = !runSingleThreaded;
+  Part::BOPCheck BOPCheck(shapeIn, settings);
 
 #ifdef FC_DEBUG
   Base::TimeElapsed start_time;
 #endif
 
-  BOPCheck.Perform();
+  //the solids and shells are checked block by block, so the user can stop in between
+  BOPCheck.perform([&theScope](const BOPAlgo_ListOfCheckResult&) {
+      return !theScope.UserBreak();
+  });
 
 #ifdef FC_DEBUG
   float bopAlgoTime = Base::TimeElapsed::diffTimeF(start_time, Base::TimeElapsed());
   std::cout << std::endl << "BopAlgo check time is: " << bopAlgoTime << std::endl << std::endl;
 #endif
 
-  if (!BOPCheck.HasFaulty())
+  if (!BOPCheck.hasFaulty())
       return 0;
 
+  const TopoDS_Shape& BOPCopy = BOPCheck.shape();
   ResultEntry *entry = new ResultEntry();
   entry->parent = theRoot;
   entry->shape = BOPCopy; //this will cause a problem, with existing entry. i.e. entry is true.
@@ -773,7 +768,7 @@ int TaskCheckGeometryResults::goBOPSingleCheck(const TopoDS_Shape& shapeIn, Resu
   goSetupResultBoundingBox(entry);
   theRoot->children.push_back(entry);
 
-  const BOPAlgo_ListOfCheckResult &BOPResults = BOPCheck.GetCheckResult();
+  const BOPAlgo_ListOfCheckResult &BOPResults = BOPCheck.results();
   BOPAlgo_ListIteratorOfListOfCheckResult BOPResultsIt(BOPResults);
   for (; BOPResultsIt.More(); BOPResultsIt.Next())
   {
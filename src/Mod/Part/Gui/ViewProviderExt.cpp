@@ -47,6 +47,7 @@
 
 # include <QAction>
 # include <QMenu>
+# include <QtConcurrentMap>
 # include <sstream>
 
 # include <Inventor/SoPickedPoint.h>
@@ -981,36 +982,68 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
     meshParams.InParallel = Standard_True;
     meshParams.AllowQualityDecrease = Standard_True;
 
-    BRepMesh_IncrementalMesh(shape, meshParams);
+    // Reuse the triangulation stored in the shape if it matches the deflection, e.g. when the
+    // shape has been displayed before with the same settings or has only been moved.
+    // Checking this is much cheaper than letting BRepMesh find it out.
+    if (!Part::Tools::hasTriangulation(shape, deflection, meshParams.AllowQualityDecrease)) {
+        BRepMesh_IncrementalMesh(shape, meshParams);
+    }
 
     // We must reset the location here because the transformation data
     // are set in the placement property
     TopLoc_Location aLoc;
     shape.Location(aLoc);
 
-    // count triangles and nodes in the mesh
+    // collect the triangulation of the faces and count triangles and nodes
+    struct FaceMesh
+    {
+        Handle(Poly_Triangulation) mesh;
+        TopLoc_Location location;
+        int nodeOffset = 0;
+        int triaOffset = 0;
+    };
+
     TopTools_IndexedMapOfShape faceMap;
     TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    std::vector<FaceMesh> faceMeshes(faceMap.Extent());
+    // Faces sharing the same TShape also share the triangulation that may get modified when
+    // computing the normals. Such faces are converted by the same task.
+    std::vector<std::vector<int>> faceTasks;
+    std::map<const Poly_Triangulation*, std::size_t> taskOfMesh;
     for (int i = 1; i <= faceMap.Extent(); i++) {
-        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(TopoDS::Face(faceMap(i)), aLoc);
+        const TopoDS_Face& actFace = TopoDS::Face(faceMap(i));
+        FaceMesh& faceMesh = faceMeshes[i - 1];
+        faceMesh.mesh = BRep_Tool::Triangulation(actFace, faceMesh.location);
 
-        if (mesh.IsNull()) {
-            mesh = Part::Tools::triangulationOfFace(TopoDS::Face(faceMap(i)));
+        if (faceMesh.mesh.IsNull()) {
+            faceMesh.mesh = Part::Tools::triangulationOfFace(actFace);
         }
 
+        std::size_t task = faceTasks.size();
+        if (!faceMesh.mesh.IsNull()) {
+            task = taskOfMesh.emplace(faceMesh.mesh.get(), task).first->second;
+        }
+        if (task == faceTasks.size()) {
+            faceTasks.emplace_back();
+        }
+        faceTasks[task].push_back(i - 1);
+
         // Note: we must also count empty faces
-        if (!mesh.IsNull()) {
-            numTriangles += mesh->NbTriangles();
-            numNodes += mesh->NbNodes();
-            numNorms += mesh->NbNodes();
+        faceMesh.nodeOffset = numNodes;
+        faceMesh.triaOffset = numTriangles;
+        if (!faceMesh.mesh.IsNull()) {
+            numTriangles += faceMesh.mesh->NbTriangles();
+            numNodes += faceMesh.mesh->NbNodes();
+            numNorms += faceMesh.mesh->NbNodes();
         }
 
         TopExp_Explorer xp;
-        for (xp.Init(faceMap(i), TopAbs_EDGE); xp.More(); xp.Next()) {
+        for (xp.Init(actFace, TopAbs_EDGE); xp.More(); xp.Next()) {
             faceEdges.insert(Part::ShapeMapHasher {}(xp.Current()));
         }
         numFaces++;
     }
+    int faceNodeOffset = numNodes;
 
     // get an indexed map of edges
     TopTools_IndexedMapOfShape edgeMap;
@@ -1069,31 +1102,29 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
         norms[i] = SbVec3f(0.0, 0.0, 0.0);
     }
 
-    int ii = 0, faceNodeOffset = 0, faceTriaOffset = 0;
-    for (int i = 1; i <= faceMap.Extent(); i++, ii++) {
-        TopLoc_Location aLoc;
-        const TopoDS_Face& actFace = TopoDS::Face(faceMap(i));
-        // get the mesh of the shape
-        Handle(Poly_Triangulation) mesh = BRep_Tool::Triangulation(actFace, aLoc);
-        if (mesh.IsNull()) {
-            mesh = Part::Tools::triangulationOfFace(actFace);
-        }
+    // Every face writes to its own range of the arrays so that the faces can be
+    // converted in parallel.
+    auto convertFace = [&](int i) {
+        const TopoDS_Face& actFace = TopoDS::Face(faceMap(i + 1));
+        const FaceMesh& faceMesh = faceMeshes[i];
+        const Handle(Poly_Triangulation)& mesh = faceMesh.mesh;
         if (mesh.IsNull()) {
-            parts[ii] = 0;
-            continue;
+            parts[i] = 0;
+            return;
         }
 
         // getting the transformation of the shape/face
         gp_Trsf myTransf;
         Standard_Boolean identity = true;
-        if (!aLoc.IsIdentity()) {
+        if (!faceMesh.location.IsIdentity()) {
             identity = false;
-            myTransf = aLoc.Transformation();
+            myTransf = faceMesh.location.Transformation();
         }
 
-        // getting size of node and triangle array of this face
-        int nbNodesInFace = mesh->NbNodes();
+        // getting size of triangle array of this face
         int nbTriInFace = mesh->NbTriangles();
+        int nodeOffset = faceMesh.nodeOffset;
+        int32_t* faceIndex = index + 4 * faceMesh.triaOffset;
         // check orientation
         TopAbs_Orientation orient = actFace.Orientation();
 
@@ -1103,8 +1134,7 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
         const TColgp_Array1OfPnt& Nodes = mesh->Nodes();
         TColgp_Array1OfDir Normals(Nodes.Lower(), Nodes.Upper());
 #else
-        int numNodes = mesh->NbNodes();
-        TColgp_Array1OfDir Normals(1, numNodes);
+        TColgp_Array1OfDir Normals(1, mesh->NbNodes());
 #endif
         if (normalsFromUV) {
             Part::Tools::getPointNormals(actFace, mesh, Normals);
@@ -1164,25 +1194,40 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
             }
 
             // add the normals for all points of this triangle
-            norms[faceNodeOffset + N1 - 1] += Base::convertTo<SbVec3f>(NV1);
-            norms[faceNodeOffset + N2 - 1] += Base::convertTo<SbVec3f>(NV2);
-            norms[faceNodeOffset + N3 - 1] += Base::convertTo<SbVec3f>(NV3);
+            norms[nodeOffset + N1 - 1] += Base::convertTo<SbVec3f>(NV1);
+            norms[nodeOffset + N2 - 1] += Base::convertTo<SbVec3f>(NV2);
+            norms[nodeOffset + N3 - 1] += Base::convertTo<SbVec3f>(NV3);
 
             // set the vertices
-            verts[faceNodeOffset + N1 - 1] = Base::convertTo<SbVec3f>(V1);
-            verts[faceNodeOffset + N2 - 1] = Base::convertTo<SbVec3f>(V2);
-            verts[faceNodeOffset + N3 - 1] = Base::convertTo<SbVec3f>(V3);
+            verts[nodeOffset + N1 - 1] = Base::convertTo<SbVec3f>(V1);
+            verts[nodeOffset + N2 - 1] = Base::convertTo<SbVec3f>(V2);
+            verts[nodeOffset + N3 - 1] = Base::convertTo<SbVec3f>(V3);
 
             // set the index vector with the 3 point indexes and the end delimiter
-            index[faceTriaOffset * 4 + 4 * (g - 1)]     = faceNodeOffset + N1 - 1;
-            index[faceTriaOffset * 4 + 4 * (g - 1) + 1] = faceNodeOffset + N2 - 1;
-            index[faceTriaOffset * 4 + 4 * (g - 1) + 2] = faceNodeOffset + N3 - 1;
-            index[faceTriaOffset * 4 + 4 * (g - 1) + 3] = SO_END_FACE_INDEX;
+            faceIndex[4 * (g - 1)]     = nodeOffset + N1 - 1;
+            faceIndex[4 * (g - 1) + 1] = nodeOffset + N2 - 1;
+            faceIndex[4 * (g - 1) + 2] = nodeOffset + N3 - 1;
+            faceIndex[4 * (g - 1) + 3] = SO_END_FACE_INDEX;
         }
 
-        parts[ii] = nbTriInFace;  // new part
+        parts[i] = nbTriInFace;  // new part
+    };
+
+    QtConcurrent::blockingMap(faceTasks, [&convertFace](const std::vector<int>& faces) {
+        for (int i : faces) {
+            convertFace(i);
+        }
+    });
+
+    // handling the edges lying on the faces
+    for (int i = 1; i <= faceMap.Extent(); i++) {
+        const TopoDS_Face& actFace = TopoDS::Face(faceMap(i));
+        const FaceMesh& faceMesh = faceMeshes[i - 1];
+        const Handle(Poly_Triangulation)& mesh = faceMesh.mesh;
+        if (mesh.IsNull()) {
+            continue;
+        }
 
-        // handling the edges lying on this face
         TopExp_Explorer Exp;
         for (Exp.Init(actFace, TopAbs_EDGE); Exp.More(); Exp.Next()) {
             const TopoDS_Edge& curEdge = TopoDS::Edge(Exp.Current());
@@ -1194,16 +1239,16 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
 
                 // this holds the indices of the edge's triangulation to the current polygon
                 Handle(Poly_PolygonOnTriangulation) aPoly =
-                    BRep_Tool::PolygonOnTriangulation(curEdge, mesh, aLoc);
+                    BRep_Tool::PolygonOnTriangulation(curEdge, mesh, faceMesh.location);
                 if (aPoly.IsNull()) {
                     continue;  // polygon does not exist
                 }
 
                 // getting the indexes of the edge polygon
                 const TColStd_Array1OfInteger& indices = aPoly->Nodes();
-                for (Standard_Integer i = indices.Lower(); i <= indices.Upper(); i++) {
-                    int nodeIndex = indices(i);
-                    int index = faceNodeOffset + nodeIndex - 1;
+                for (Standard_Integer j = indices.Lower(); j <= indices.Upper(); j++) {
+                    int nodeIndex = indices(j);
+                    int index = faceMesh.nodeOffset + nodeIndex - 1;
                     lineSetMap[edgeIndex].push_back(index);
 
                     // usually the coordinates for this edge are already set by the
@@ -1212,12 +1257,12 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
                     // but not by any triangle. Thus, we must apply the coordinates to
                     // make sure that everything is properly set.
 #if OCC_VERSION_HEX < 0x070600
-                    gp_Pnt p(Nodes(nodeIndex));
+                    gp_Pnt p(mesh->Nodes()(nodeIndex));
 #else
                     gp_Pnt p(mesh->Node(nodeIndex));
 #endif
-                    if (!identity) {
-                        p.Transform(myTransf);
+                    if (!faceMesh.location.IsIdentity()) {
+                        p.Transform(faceMesh.location.Transformation());
                     }
                     verts[index] = Base::convertTo<SbVec3f>(p);
                 }
@@ -1228,10 +1273,6 @@ void ViewProviderPartExt::setupCoinGeometry(TopoDS_Shape shape,
         }
 
         edgeVector.push_back(-1);
-
-        // counting up the per Face offsets
-        faceNodeOffset += nbNodesInFace;
-        faceTriaOffset += nbTriInFace;
     }
 
     // handling of the free edges
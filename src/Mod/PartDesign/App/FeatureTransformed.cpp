@@ -31,7 +31,9 @@
 #include <TopExp_Explorer.hxx>
 
 
+#include <algorithm>
 #include <array>
+#include <cstring>
 
 #include <Base/Console.h>
 #include <Base/Exception.h>
@@ -53,6 +55,113 @@
 
 using namespace PartDesign;
 
+namespace
+{
+
+/*!
+ * \brief groupDisjointShapes
+ * Distributes the shapes to groups so that the bounding boxes of the shapes of a group don't
+ * overlap. This proves that the shapes of a group are disjoint. The boxes are sorted along the
+ * x axis and each shape is put into the first group that contains none of the shapes
+ * overlapping it. Returns an empty list if a shape has no valid bounding box.
+ */
+std::vector<std::vector<Part::TopoShape>>
+groupDisjointShapes(const std::vector<Part::TopoShape>& shapes)
+{
+    std::vector<Bnd_Box> boxes(shapes.size());
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        BRepBndLib::Add(shapes[i].getShape(), boxes[i]);
+        if (boxes[i].IsVoid()) {
+            return {};
+        }
+        boxes[i].Enlarge(Precision::Confusion());
+    }
+
+    std::vector<std::size_t> order(shapes.size());
+    for (std::size_t i = 0; i < order.size(); i++) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&boxes](std::size_t i1, std::size_t i2) {
+        return boxes[i1].CornerMin().X() < boxes[i2].CornerMin().X();
+    });
+
+    std::vector<std::size_t> groupOf(shapes.size(), 0);
+    std::size_t numGroups = 0;
+    std::vector<std::size_t> active;
+    for (std::size_t index : order) {
+        const double xMin = boxes[index].CornerMin().X();
+        active.erase(std::remove_if(active.begin(),
+                                    active.end(),
+                                    [&](std::size_t other) {
+                                        return boxes[other].CornerMax().X() < xMin;
+                                    }),
+                     active.end());
+
+        std::vector<bool> usedGroups(numGroups, false);
+        for (std::size_t other : active) {
+            if (!boxes[index].IsOut(boxes[other])) {
+                usedGroups[groupOf[other]] = true;
+            }
+        }
+
+        auto group = std::find(usedGroups.begin(), usedGroups.end(), false);
+        groupOf[index] = static_cast<std::size_t>(group - usedGroups.begin());
+        numGroups = std::max(numGroups, groupOf[index] + 1);
+        active.push_back(index);
+    }
+
+    std::vector<std::vector<Part::TopoShape>> groups(numGroups);
+    for (std::size_t i = 0; i < shapes.size(); i++) {
+        groups[groupOf[i]].push_back(shapes[i]);
+    }
+    return groups;
+}
+
+/*!
+ * \brief makeLocalizedBoolean
+ * Fuses or cuts the transformed instances with the support shape which is the first element
+ * of \a shapes. Instances that are proven to be disjoint by their bounding boxes are passed as
+ * one compound to the boolean algorithm so that they aren't intersected with each other. The
+ * element map is still built from the single instances, and as the instances of a group don't
+ * share any element, the element names don't depend on the grouping. For a cut the instances
+ * outside the support are skipped as they can't remove any material.
+ */
+void makeLocalizedBoolean(Part::TopoShape& result,
+                          const char* maker,
+                          const std::vector<Part::TopoShape>& shapes)
+{
+    std::vector<Part::TopoShape> instances(shapes.begin() + 1, shapes.end());
+    if (strcmp(maker, Part::OpCodes::Cut) == 0) {
+        Bnd_Box supportBox;
+        BRepBndLib::Add(shapes.front().getShape(), supportBox);
+        supportBox.Enlarge(Precision::Confusion());
+        instances.erase(std::remove_if(instances.begin(),
+                                       instances.end(),
+                                       [&supportBox](const Part::TopoShape& instance) {
+                                           Bnd_Box box;
+                                           BRepBndLib::Add(instance.getShape(), box);
+                                           return !box.IsVoid() && box.IsOut(supportBox);
+                                       }),
+                        instances.end());
+        if (instances.empty()) {
+            result = shapes.front();
+            return;
+        }
+    }
+
+    auto groups = groupDisjointShapes(instances);
+    if (groups.empty() || groups.size() == instances.size()) {
+        std::vector<Part::TopoShape> sources {shapes.front()};
+        sources.insert(sources.end(), instances.begin(), instances.end());
+        result.makeElementBoolean(maker, sources);
+        return;
+    }
+
+    result.makeElementBoolean(maker, shapes.front(), groups);
+}
+
+}  // namespace
+
 namespace PartDesign
 {
 using Part::OCCTProgressIndicator;
@@ -385,14 +494,14 @@ App::DocumentObjectExecReturn* Transformed::execute()
                     if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
                         return new App::DocumentObjectExecReturn("User aborted");
                     }
-                    supportShape.makeElementFuse(shapes);
+                    makeLocalizedBoolean(supportShape, Part::OpCodes::Fuse, shapes);
                 }
                 if (!cutShape.isNull()) {
                     auto shapes = getTransformedCompShape(supportShape, cutShape);
                     if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
                         return new App::DocumentObjectExecReturn("User aborted");
                     }
-                    supportShape.makeElementCut(shapes);
+                    makeLocalizedBoolean(supportShape, Part::OpCodes::Cut, shapes);
                 }
             }
             break;
@@ -401,7 +510,7 @@ App::DocumentObjectExecReturn* Transformed::execute()
             if (OCCTProgressIndicator::getAppIndicator().UserBreak()) {
                 return new App::DocumentObjectExecReturn("User aborted");
             }
-            supportShape.makeElementFuse(shapes);
+            makeLocalizedBoolean(supportShape, Part::OpCodes::Fuse, shapes);
             break;
         }
     }
@@ -20,6 +20,8 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <map>
+
 #include <Geom_BSplineSurface.hxx>
 #include <TColgp_Array1OfPnt.hxx>
 
@@ -40,6 +42,8 @@
 
 #include "ApproxSurface.h"
 #include "BSplineFitting.h"
+#include "Preprocessing.h"
+#include "PrimitiveDetection.h"
 #include "RegionGrowing.h"
 #include "SampleConsensus.h"
 #include "Segmentation.h"
@@ -93,6 +97,42 @@ public:
             "UVDirs: set the u,v parameter directions as tuple of two vectors\n"
             "        If not set then they will be determined by computing a best-fit plane\n"
         );
+        add_keyword_method("detectPrimitives",&Module::detectPrimitives,
+            "detectPrimitives(Points, Normals=None, Types=('Plane', 'Cylinder', 'Sphere', 'Cone'),\n"
+            "DistanceThreshold=0.01, NormalThreshold=0.9, MinSupport=100, Hypotheses=100,\n"
+            "SamplingRadius=0.0, MaxPrimitives=0, Seed=0) -> list of dicts\n\n"
+            "Points: the point cloud\n"
+            "Normals: the normals of the points, needed to detect cylinders and cones\n"
+            "Types: the primitive types to search for\n"
+            "DistanceThreshold: maximum distance of an inlier to the primitive\n"
+            "NormalThreshold: minimum cosine of the angle between point and primitive normal\n"
+            "MinSupport: minimum number of inliers of a primitive\n"
+            "Hypotheses: number of hypotheses per type and round, scored in parallel\n"
+            "SamplingRadius: if positive take samples from this neighbourhood\n"
+            "MaxPrimitives: maximum number of primitives, 0 means no limit\n"
+            "Seed: seed of the random number generator\n\n"
+            "Each dict has the keys 'Type', 'Parameters', 'Model' (the inlier indices)\n"
+            "and 'StdDeviation'. The parameters are:\n"
+            "Plane: base, normal\n"
+            "Cylinder: base, axis, radius\n"
+            "Sphere: center, radius\n"
+            "Cone: apex, axis, half-angle in radian\n"
+            "This function doesn't need the Point Cloud Library.\n"
+        );
+        add_keyword_method("downsampleVoxelGrid",&Module::downsampleVoxelGrid,
+            "downsampleVoxelGrid(Points, DimX, [DimY, DimZ]) -> Points\n"
+            "Replaces the points inside each voxel of the given size by their centroid.\n"
+            "This function doesn't need the Point Cloud Library.\n"
+        );
+        add_keyword_method("estimateNormals",&Module::estimateNormals,
+            "estimateNormals(Points, [KSearch=10, SearchRadius=0, Orient=True]) -> Normals\n"
+            "Estimates the point normals by a principal component analysis of the\n"
+            "neighbourhood of each point. KSearch is the number of nearest neighbours,\n"
+            "SearchRadius limits the distance of a neighbour. If Orient is True the\n"
+            "normals are oriented consistently.\n"
+            "The result can be assigned to a Points::PropertyNormalList.\n"
+            "This function doesn't need the Point Cloud Library.\n"
+        );
 #if defined(HAVE_PCL_SURFACE)
         add_keyword_method("triangulate",&Module::triangulate,
             "triangulate(PointKernel,searchRadius[,mu=2.5])."
@@ -448,6 +488,173 @@ private:
             throw Py::RuntimeError("Unknown C++ exception");
         }
     }
+    Py::Object detectPrimitives(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *pts;
+        PyObject *vec = nullptr;
+        PyObject *types = nullptr;
+        Reen::PrimitiveDetection::Parameters param;
+        double distance = param.distanceThreshold;
+        double normal = param.normalThreshold;
+        int minSupport = static_cast<int>(param.minSupport);
+        int hypotheses = param.hypotheses;
+        double radius = param.samplingRadius;
+        int maxPrimitives = static_cast<int>(param.maxPrimitives);
+        unsigned int seed = param.seed;
+
+        static const std::array<const char*,11> kwds_detect {"Points", "Normals", "Types",
+            "DistanceThreshold", "NormalThreshold", "MinSupport", "Hypotheses", "SamplingRadius",
+            "MaxPrimitives", "Seed", nullptr};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!|OOddiidiI", kwds_detect,
+                                        &(Points::PointsPy::Type), &pts, &vec, &types,
+                                        &distance, &normal, &minSupport, &hypotheses,
+                                        &radius, &maxPrimitives, &seed))
+            throw Py::Exception();
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+        std::vector<Base::Vector3d> normals;
+        if (vec && vec != Py_None) {
+            Py::Sequence list(vec);
+            normals.reserve(list.size());
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                normals.push_back(Py::Vector(*it).toVector());
+            }
+            if (normals.size() != points->size()) {
+                throw Py::ValueError("Number of normals doesn't match the number of points");
+            }
+        }
+
+        const std::map<std::string, Reen::PrimitiveDetection::Type> typeNames {
+            {"Plane", Reen::PrimitiveDetection::Type::Plane},
+            {"Cylinder", Reen::PrimitiveDetection::Type::Cylinder},
+            {"Sphere", Reen::PrimitiveDetection::Type::Sphere},
+            {"Cone", Reen::PrimitiveDetection::Type::Cone}
+        };
+        if (types && types != Py_None) {
+            param.types.clear();
+            Py::Sequence list(types);
+            for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+                std::string name = Py::String(*it);
+                auto jt = typeNames.find(name);
+                if (jt == typeNames.end()) {
+                    throw Py::ValueError("Unsupported primitive type: " + name);
+                }
+                param.types.push_back(jt->second);
+            }
+        }
+
+        param.distanceThreshold = distance;
+        param.normalThreshold = normal;
+        param.minSupport = static_cast<std::size_t>(std::max(minSupport, 1));
+        param.hypotheses = std::max(hypotheses, 1);
+        param.samplingRadius = radius;
+        param.maxPrimitives = static_cast<std::size_t>(std::max(maxPrimitives, 0));
+        param.seed = seed;
+
+        Reen::PrimitiveDetection detect(*points, normals);
+        detect.setParameters(param);
+        std::vector<Reen::PrimitiveDetection::Primitive> primitives = detect.perform();
+
+        Py::List list;
+        for (const auto& it : primitives) {
+            std::string name;
+            for (const auto& jt : typeNames) {
+                if (jt.second == it.type) {
+                    name = jt.first;
+                }
+            }
+
+            Py::Dict dict;
+            Py::Tuple tuple(it.parameters.size());
+            for (std::size_t i = 0; i < it.parameters.size(); i++)
+                tuple.setItem(i, Py::Float(it.parameters[i]));
+            Py::Tuple data(it.inliers.size());
+            for (std::size_t i = 0; i < it.inliers.size(); i++)
+                data.setItem(i, Py::Long(it.inliers[i]));
+            dict.setItem(Py::String("Type"), Py::String(name));
+            dict.setItem(Py::String("Parameters"), tuple);
+            dict.setItem(Py::String("Model"), data);
+            dict.setItem(Py::String("StdDeviation"), Py::Float(it.stdDeviation));
+            list.append(dict);
+        }
+
+        return list;
+    }
+    Py::Object downsampleVoxelGrid(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *pts;
+        double voxDimX = 0;
+        double voxDimY = 0;
+        double voxDimZ = 0;
+
+        static const std::array<const char*,5> kwds_voxel {"Points", "DimX", "DimY", "DimZ", nullptr};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!d|dd", kwds_voxel,
+                                        &(Points::PointsPy::Type), &pts,
+                                        &voxDimX, &voxDimY, &voxDimZ))
+            throw Py::Exception();
+
+        if (voxDimY == 0)
+            voxDimY = voxDimX;
+
+        if (voxDimZ == 0)
+            voxDimZ = voxDimX;
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+
+        try {
+            std::vector<Base::Vector3d> sample;
+            VoxelGridFilter filter(*points);
+            filter.setLeafSize(voxDimX, voxDimY, voxDimZ);
+            filter.perform(sample);
+
+            Points::PointKernel* points_sample = new Points::PointKernel();
+            points_sample->reserve(sample.size());
+            for (const auto& it : sample) {
+                points_sample->push_back(it);
+            }
+
+            return Py::asObject(new Points::PointsPy(points_sample));
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+    }
+
+    Py::Object estimateNormals(const Py::Tuple& args, const Py::Dict& kwds)
+    {
+        PyObject *pts;
+        int ksearch = 10;
+        double searchRadius = 0;
+        PyObject *orient = Py_True;
+
+        static const std::array<const char*,5> kwds_normals {"Points", "KSearch", "SearchRadius", "Orient", nullptr};
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(), kwds.ptr(), "O!|idO!", kwds_normals,
+                                        &(Points::PointsPy::Type), &pts,
+                                        &ksearch, &searchRadius, &PyBool_Type, &orient))
+            throw Py::Exception();
+
+        Points::PointKernel* points = static_cast<Points::PointsPy*>(pts)->getPointKernelPtr();
+
+        try {
+            std::vector<Base::Vector3f> normals;
+            PCANormalEstimation estimate(*points);
+            estimate.setKSearch(ksearch);
+            estimate.setSearchRadius(searchRadius);
+            estimate.setOrientNormals(Base::asBoolean(orient));
+            estimate.perform(normals);
+
+            Py::List list;
+            for (const auto& it : normals) {
+                list.append(Py::Vector(it));
+            }
+
+            return list;
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+    }
+
 #if defined(HAVE_PCL_SURFACE)
     /*
 import ReverseEngineering as Reen
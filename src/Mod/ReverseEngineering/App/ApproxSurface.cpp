@@ -20,14 +20,20 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
 #include <QFuture>
 #include <QFutureWatcher>
 #include <QtConcurrentMap>
 
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseQR>
+#include <Eigen/IterativeLinearSolvers>
+#include <Eigen/OrderingMethods>
 
 #include <Base/Sequencer.h>
 #include <Base/Tools.h>
@@ -37,7 +43,6 @@
 
 
 using namespace Reen;
-namespace sp = std::placeholders;
 
 // SplineBasisfunction
 
@@ -867,10 +872,10 @@ BSplineParameterCorrection::BSplineParameterCorrection(unsigned usUOrder,
     : ParameterCorrection(usUOrder, usVOrder, usUCtrlpoints, usVCtrlpoints)
     , _clUSpline(usUCtrlpoints + usUOrder)
     , _clVSpline(usVCtrlpoints + usVOrder)
-    , _clSmoothMatrix(0, usUCtrlpoints * usVCtrlpoints - 1, 0, usUCtrlpoints * usVCtrlpoints - 1)
-    , _clFirstMatrix(0, usUCtrlpoints * usVCtrlpoints - 1, 0, usUCtrlpoints * usVCtrlpoints - 1)
-    , _clSecondMatrix(0, usUCtrlpoints * usVCtrlpoints - 1, 0, usUCtrlpoints * usVCtrlpoints - 1)
-    , _clThirdMatrix(0, usUCtrlpoints * usVCtrlpoints - 1, 0, usUCtrlpoints * usVCtrlpoints - 1)
+    , _clSmoothMatrix(usUCtrlpoints * usVCtrlpoints, usUCtrlpoints * usVCtrlpoints)
+    , _clFirstMatrix(usUCtrlpoints * usVCtrlpoints, usUCtrlpoints * usVCtrlpoints)
+    , _clSecondMatrix(usUCtrlpoints * usVCtrlpoints, usUCtrlpoints * usVCtrlpoints)
+    , _clThirdMatrix(usUCtrlpoints * usVCtrlpoints, usUCtrlpoints * usVCtrlpoints)
 {
     Init();
 }
@@ -880,10 +885,10 @@ void BSplineParameterCorrection::Init()
     // Initializations
     _pvcUVParam = nullptr;
     _pvcPoints = nullptr;
-    _clFirstMatrix.Init(0.0);
-    _clSecondMatrix.Init(0.0);
-    _clThirdMatrix.Init(0.0);
-    _clSmoothMatrix.Init(0.0);
+    _clFirstMatrix.setZero();
+    _clSecondMatrix.setZero();
+    _clThirdMatrix.setZero();
+    _clSmoothMatrix.setZero();
 
     /* Calculate the knot vectors */
     unsigned usUMax = _usUCtrlpoints - _usUOrder + 1;
@@ -1034,234 +1039,247 @@ void BSplineParameterCorrection::DoParameterCorrection(int iIter)
     } while (i < iIter && fMaxDiff > Precision::Confusion() && fMaxScalar < 0.99);
 }
 
-bool BSplineParameterCorrection::SolveWithoutSmoothing()
+namespace
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Matrix Xx(0, ulDim - 1, 0, 0);
-    math_Matrix Xy(0, ulDim - 1, 0, 0);
-    math_Matrix Xz(0, ulDim - 1, 0, 0);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        unsigned ulIdx = 0;
-
-        // Pre-calculation of the values of the base functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
-
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
-                }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
-                }
+// Integrals of products of (derivatives of) basis functions in one parameter direction.
+// Two basis functions only overlap if their indices differ by less than the order, so
+// only this band is stored.
+class BandedIntegrals
+{
+public:
+    BandedIntegrals(BSplineBasis& basis, int numPoles, int order, int iOrd1, int iOrd2)
+        : order(order)
+        , values(static_cast<std::size_t>(numPoles) * static_cast<std::size_t>(2 * order - 1),
+                 0.0)
+    {
+        for (int i = 0; i < numPoles; i++) {
+            int kMin = std::max<int>(0, i - order + 1);
+            int kMax = std::min<int>(numPoles - 1, i + order - 1);
+            for (int k = kMin; k <= kMax; k++) {
+                values[index(i, k)] = basis.GetIntegralOfProductOfBSplines(i, k, iOrd1, iOrd2);
             }
         }
     }
-
-    // Determine the right side
-    for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
-        const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
-    }
-
-    // Solve the over-determined LGS with Householder-Transformation
-    math_Householder hhX(M, bx);
-    math_Householder hhY(M, by);
-    math_Householder hhZ(M, bz);
-
-    if (!(hhX.IsDone() && hhY.IsDone() && hhZ.IsDone())) {
-        // LGS could not be solved
-        return false;
+    double operator()(int i, int k) const
+    {
+        if (std::abs(i - k) >= order) {
+            return 0.0;
+        }
+        return values[index(i, k)];
     }
-    Xx = hhX.AllValues();
-    Xy = hhY.AllValues();
-    Xz = hhZ.AllValues();
 
-    unsigned ulIdx = 0;
-    for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx, 0), Xy(ulIdx, 0), Xz(ulIdx, 0));
-            ulIdx++;
-        }
+private:
+    std::size_t index(int i, int k) const
+    {
+        return static_cast<std::size_t>(i) * static_cast<std::size_t>(2 * order - 1)
+            + static_cast<std::size_t>(k - i + order - 1);
     }
 
-    return true;
-}
+private:
+    int order;
+    std::vector<double> values;
+};
 
-namespace Reen
-{
-class ScalarProduct
+// Assembles one of the smoothing matrices. 'term' computes the entry for the row (k,l)
+// and the column (i,j) of the tensor product basis.
+template<typename Func>
+BSplineParameterCorrection::SparseMatrix assembleSmoothMatrix(int numUPoles,
+                                                              int numVPoles,
+                                                              int uOrder,
+                                                              int vOrder,
+                                                              Func&& term,
+                                                              Base::SequencerLauncher& seq)
 {
-public:
-    explicit ScalarProduct(const math_Matrix& mat)
-        : mat(mat)
-    {}
-    std::vector<double> multiply(int col) const
-    {
-        math_Vector vec = mat.Col(col);
-        std::vector<double> out(mat.ColNumber());
-        for (int n = mat.LowerCol(); n <= mat.UpperCol(); n++) {
-            out[n] = vec * mat.Col(n);
+    int dim = numUPoles * numVPoles;
+    std::vector<BSplineParameterCorrection::Triplet> triplets;
+    triplets.reserve(static_cast<std::size_t>(dim) * static_cast<std::size_t>(2 * uOrder - 1)
+                     * static_cast<std::size_t>(2 * vOrder - 1));
+
+    int m = 0;
+    for (int k = 0; k < numUPoles; k++) {
+        for (int l = 0; l < numVPoles; l++) {
+            int iMin = std::max<int>(0, k - uOrder + 1);
+            int iMax = std::min<int>(numUPoles - 1, k + uOrder - 1);
+            int jMin = std::max<int>(0, l - vOrder + 1);
+            int jMax = std::min<int>(numVPoles - 1, l + vOrder - 1);
+            for (int i = iMin; i <= iMax; i++) {
+                for (int j = jMin; j <= jMax; j++) {
+                    double value = term(i, j, k, l);
+                    if (value != 0.0) {
+                        triplets.emplace_back(m, i * numVPoles + j, value);
+                    }
+                }
+            }
+            seq.next();
+            m++;
         }
-        return out;
     }
 
-private:
-    const math_Matrix& mat;
-};
-}  // namespace Reen
+    BSplineParameterCorrection::SparseMatrix mat(dim, dim);
+    mat.setFromTriplets(triplets.begin(), triplets.end());
+    return mat;
+}
+}  // namespace
 
-bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+BSplineParameterCorrection::SparseMatrix BSplineParameterCorrection::CalcObservationMatrix()
 {
-    unsigned ulSize = _pvcPoints->Length();
-    unsigned ulDim = _usUCtrlpoints * _usVCtrlpoints;
-    math_Matrix M(0, ulSize - 1, 0, ulDim - 1);
-    math_Vector Xx(0, ulDim - 1);
-    math_Vector Xy(0, ulDim - 1);
-    math_Vector Xz(0, ulDim - 1);
-    math_Vector bx(0, ulSize - 1);
-    math_Vector by(0, ulSize - 1);
-    math_Vector bz(0, ulSize - 1);
-    math_Vector Mbx(0, ulDim - 1);
-    math_Vector Mby(0, ulDim - 1);
-    math_Vector Mbz(0, ulDim - 1);
+    int ulSize = _pvcPoints->Length();
+    int ulDim = static_cast<int>(_usUCtrlpoints * _usVCtrlpoints);
+    int uOrder = static_cast<int>(_usUOrder);
+    int vOrder = static_cast<int>(_usVOrder);
+    int numVPoles = static_cast<int>(_usVCtrlpoints);
+
+    // The rows of the matrix are independent of each other, so blocks of them are
+    // computed in parallel. Each row has at most uOrder * vOrder non-zero entries.
+    const int blockSize = 1024;
+    std::vector<int> blocks;
+    for (int i = 0; i < ulSize; i += blockSize) {
+        blocks.push_back(i);
+    }
+
+    std::function<std::vector<Triplet>(int)> fillBlock = [&](int first) {
+        std::vector<Triplet> triplets;
+        int last = std::min<int>(first + blockSize, ulSize);
+        triplets.reserve(static_cast<std::size_t>(last - first)
+                         * static_cast<std::size_t>(uOrder * vOrder));
+
+        TColStd_Array1OfReal basisU(0, uOrder - 1);
+        TColStd_Array1OfReal basisV(0, vOrder - 1);
+        for (int i = first; i < last; i++) {
+            const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
+            double fU = uvValue.X();
+            double fV = uvValue.Y();
+            // outside of the domain all basis functions vanish
+            if (fU < _vUKnots.First() || fU > _vUKnots.Last() || fV < _vVKnots.First()
+                || fV > _vVKnots.Last()) {
+                continue;
+            }
 
-    // Determining the coefficient matrix of the overdetermined LGS
-    for (unsigned i = 0; i < ulSize; i++) {
-        const gp_Pnt2d& uvValue = (*_pvcUVParam)(i);
-        double fU = uvValue.X();
-        double fV = uvValue.Y();
-        int ulIdx = 0;
-
-        // Pre-calculation of the values of the basis functions
-        std::vector<double> basisU(_usUCtrlpoints);
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            basisU[j] = _clUSpline.BasisFunction(j, fU);
-        }
-        std::vector<double> basisV(_usVCtrlpoints);
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            basisV[k] = _clVSpline.BasisFunction(k, fV);
-        }
+            // Only the basis functions of the knot span don't vanish
+            int uSpan = _clUSpline.FindSpan(fU);
+            int vSpan = _clVSpline.FindSpan(fV);
+            _clUSpline.AllBasisFunctions(fU, basisU);
+            _clVSpline.AllBasisFunctions(fV, basisV);
 
-        for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-            double valueU = basisU[j];
-            if (valueU == 0.0) {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = 0.0;
-                    ulIdx++;
+            for (int j = 0; j < uOrder; j++) {
+                double valueU = basisU(j);
+                if (valueU == 0.0) {
+                    continue;
                 }
-            }
-            else {
-                for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-                    M(i, ulIdx) = valueU * basisV[k];
-                    ulIdx++;
+                int uIndex = uSpan - uOrder + 1 + j;
+                for (int k = 0; k < vOrder; k++) {
+                    double value = valueU * basisV(k);
+                    if (value != 0.0) {
+                        int vIndex = vSpan - vOrder + 1 + k;
+                        triplets.emplace_back(i, uIndex * numVPoles + vIndex, value);
+                    }
                 }
             }
         }
-    }
 
-    // The product of its transform and itself results in the quadratic
-    // system matrix (slowly)
-#if 0
-    math_Matrix MTM = M.TMultiply(M);
-#elif 0
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    for (unsigned m = 0; m < ulDim; m++) {
-        math_Vector Mm = M.Col(m);
-        for (unsigned n = m; n < ulDim; n++) {
-            MTM(m, n) = MTM(n, m) = Mm * M.Col(n);
-        }
-    }
-#else  // multi-threaded
-    std::vector<int> columns(ulDim);
-    std::generate(columns.begin(), columns.end(), Base::iotaGen<int>(0));
-    ScalarProduct scalar(M);
-    // NOLINTBEGIN
-    QFuture<std::vector<double>> future =
-        QtConcurrent::mapped(columns, std::bind(&ScalarProduct::multiply, &scalar, sp::_1));
-    // NOLINTEND
-    QFutureWatcher<std::vector<double>> watcher;
+        return triplets;
+    };
+
+    QFuture<std::vector<Triplet>> future = QtConcurrent::mapped(blocks, fillBlock);
+    QFutureWatcher<std::vector<Triplet>> watcher;
     watcher.setFuture(future);
     watcher.waitForFinished();
 
-    math_Matrix MTM(0, ulDim - 1, 0, ulDim - 1);
-    int rowIndex = 0;
+    std::vector<Triplet> triplets;
+    triplets.reserve(static_cast<std::size_t>(ulSize) * static_cast<std::size_t>(uOrder * vOrder));
     for (const auto& it : future) {
-        int colIndex = 0;
-        for (std::vector<double>::const_iterator jt = it.begin(); jt != it.end();
-             ++jt, colIndex++) {
-            MTM(rowIndex, colIndex) = *jt;
-        }
-        rowIndex++;
+        triplets.insert(triplets.end(), it.begin(), it.end());
     }
-#endif
 
-    // Determine the right side
+    SparseMatrix M(ulSize, ulDim);
+    M.setFromTriplets(triplets.begin(), triplets.end());
+    return M;
+}
+
+Eigen::MatrixX3d BSplineParameterCorrection::CalcRightSide() const
+{
+    Eigen::MatrixX3d b(_pvcPoints->Length(), 3);
     for (int ii = _pvcPoints->Lower(); ii <= _pvcPoints->Upper(); ii++) {
         const gp_Pnt& pnt = (*_pvcPoints)(ii);
-        bx(ii) = pnt.X();
-        by(ii) = pnt.Y();
-        bz(ii) = pnt.Z();
+        int row = ii - _pvcPoints->Lower();
+        b(row, 0) = pnt.X();
+        b(row, 1) = pnt.Y();
+        b(row, 2) = pnt.Z();
     }
-    for (unsigned i = 0; i < ulDim; i++) {
-        math_Vector Mi = M.Col(i);
-        Mbx(i) = Mi * bx;
-        Mby(i) = Mi * by;
-        Mbz(i) = Mi * bz;
+    return b;
+}
+
+void BSplineParameterCorrection::SetControlPoints(const Eigen::MatrixX3d& solution)
+{
+    int ulIdx = 0;
+    for (unsigned j = 0; j < _usUCtrlpoints; j++) {
+        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
+            _vCtrlPntsOfSurf(j, k) =
+                gp_Pnt(solution(ulIdx, 0), solution(ulIdx, 1), solution(ulIdx, 2));
+            ulIdx++;
+        }
     }
+}
 
-    // Solve the LGS with the LU decomposition
-    math_Gauss mgGaussX(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussY(MTM + fWeight * _clSmoothMatrix);
-    math_Gauss mgGaussZ(MTM + fWeight * _clSmoothMatrix);
+bool BSplineParameterCorrection::SolveWithoutSmoothing()
+{
+    // Determining the coefficient matrix of the overdetermined LGS
+    SparseMatrix M = CalcObservationMatrix();
+    M.makeCompressed();
+
+    // Determine the right side
+    Eigen::MatrixX3d b = CalcRightSide();
 
-    mgGaussX.Solve(Mbx, Xx);
-    if (!mgGaussX.IsDone()) {
+    // Solve the over-determined LGS with a QR decomposition. The decomposition
+    // is computed only once for all three coordinates.
+    Eigen::SparseQR<SparseMatrix, Eigen::COLAMDOrdering<int>> qr(M);
+    if (qr.info() != Eigen::Success) {
+        // LGS could not be solved
         return false;
     }
 
-    mgGaussY.Solve(Mby, Xy);
-    if (!mgGaussY.IsDone()) {
+    Eigen::MatrixX3d X = qr.solve(b);
+    if (qr.info() != Eigen::Success) {
         return false;
     }
 
-    mgGaussZ.Solve(Mbz, Xz);
-    if (!mgGaussZ.IsDone()) {
-        return false;
+    SetControlPoints(X);
+    return true;
+}
+
+bool BSplineParameterCorrection::SolveWithSmoothing(double fWeight)
+{
+    // Determining the coefficient matrix of the overdetermined LGS
+    SparseMatrix M = CalcObservationMatrix();
+
+    // The product of its transform and itself results in the quadratic
+    // system matrix. As the matrix is sparse this is cheap.
+    SparseMatrix MT = M.transpose();
+    SparseMatrix A = MT * M;
+    A += fWeight * _clSmoothMatrix;
+
+    // Determine the right side
+    Eigen::MatrixX3d Mb = MT * CalcRightSide();
+
+    // The system matrix is symmetric and (semi-)definite
+    Eigen::MatrixX3d X;
+    Eigen::SimplicialLDLT<SparseMatrix> ldlt(A);
+    if (ldlt.info() == Eigen::Success) {
+        X = ldlt.solve(Mb);
     }
 
-    unsigned ulIdx = 0;
-    for (unsigned j = 0; j < _usUCtrlpoints; j++) {
-        for (unsigned k = 0; k < _usVCtrlpoints; k++) {
-            _vCtrlPntsOfSurf(j, k) = gp_Pnt(Xx(ulIdx), Xy(ulIdx), Xz(ulIdx));
-            ulIdx++;
+    if (ldlt.info() != Eigen::Success || !X.allFinite()) {
+        Eigen::ConjugateGradient<SparseMatrix, Eigen::Lower | Eigen::Upper> cg(A);
+        if (cg.info() != Eigen::Success) {
+            return false;
+        }
+        X = cg.solve(Mb);
+        if (cg.info() != Eigen::Success) {
+            return false;
         }
     }
 
+    SetControlPoints(X);
     return true;
 }
 
@@ -1273,8 +1291,6 @@ void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc,
     if (bRecalc) {
         Base::SequencerLauncher seq("Initializing...",
                                     static_cast<size_t>(3) * static_cast<size_t>(_usUCtrlpoints)
-                                        * static_cast<size_t>(_usUCtrlpoints)
-                                        * static_cast<size_t>(_usVCtrlpoints)
                                         * static_cast<size_t>(_usVCtrlpoints));
         CalcFirstSmoothMatrix(seq);
         CalcSecondSmoothMatrix(seq);
@@ -1286,82 +1302,60 @@ void BSplineParameterCorrection::CalcSmoothingTerms(bool bRecalc,
 
 void BSplineParameterCorrection::CalcFirstSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m = 0;
-    for (unsigned k = 0; k < _usUCtrlpoints; k++) {
-        for (unsigned l = 0; l < _usVCtrlpoints; l++) {
-            unsigned n = 0;
-
-            for (unsigned i = 0; i < _usUCtrlpoints; i++) {
-                for (unsigned j = 0; j < _usVCtrlpoints; j++) {
-                    _clFirstMatrix(m, n) = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 1, 1)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 0)
-                        + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 0, 0)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 1, 1);
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    int numU = static_cast<int>(_usUCtrlpoints);
+    int numV = static_cast<int>(_usVCtrlpoints);
+    int ordU = static_cast<int>(_usUOrder);
+    int ordV = static_cast<int>(_usVOrder);
+
+    BandedIntegrals u00(_clUSpline, numU, ordU, 0, 0), u11(_clUSpline, numU, ordU, 1, 1);
+    BandedIntegrals v00(_clVSpline, numV, ordV, 0, 0), v11(_clVSpline, numV, ordV, 1, 1);
+
+    auto term = [&](int i, int j, int k, int l) {
+        return u11(i, k) * v00(j, l) + u00(i, k) * v11(j, l);
+    };
+    _clFirstMatrix = assembleSmoothMatrix(numU, numV, ordU, ordV, term, seq);
 }
 
 void BSplineParameterCorrection::CalcSecondSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m = 0;
-    for (unsigned k = 0; k < _usUCtrlpoints; k++) {
-        for (unsigned l = 0; l < _usVCtrlpoints; l++) {
-            unsigned n = 0;
-
-            for (unsigned i = 0; i < _usUCtrlpoints; i++) {
-                for (unsigned j = 0; j < _usVCtrlpoints; j++) {
-                    _clSecondMatrix(m, n) = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 2, 2)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 0)
-                        + 2 * _clUSpline.GetIntegralOfProductOfBSplines(i, k, 1, 1)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 1, 1)
-                        + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 0, 0)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 2, 2);
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    int numU = static_cast<int>(_usUCtrlpoints);
+    int numV = static_cast<int>(_usVCtrlpoints);
+    int ordU = static_cast<int>(_usUOrder);
+    int ordV = static_cast<int>(_usVOrder);
+
+    BandedIntegrals u00(_clUSpline, numU, ordU, 0, 0), u11(_clUSpline, numU, ordU, 1, 1),
+        u22(_clUSpline, numU, ordU, 2, 2);
+    BandedIntegrals v00(_clVSpline, numV, ordV, 0, 0), v11(_clVSpline, numV, ordV, 1, 1),
+        v22(_clVSpline, numV, ordV, 2, 2);
+
+    auto term = [&](int i, int j, int k, int l) {
+        return u22(i, k) * v00(j, l) + 2 * u11(i, k) * v11(j, l) + u00(i, k) * v22(j, l);
+    };
+    _clSecondMatrix = assembleSmoothMatrix(numU, numV, ordU, ordV, term, seq);
 }
 
 void BSplineParameterCorrection::CalcThirdSmoothMatrix(Base::SequencerLauncher& seq)
 {
-    unsigned m = 0;
-    for (unsigned k = 0; k < _usUCtrlpoints; k++) {
-        for (unsigned l = 0; l < _usVCtrlpoints; l++) {
-            unsigned n = 0;
-
-            for (unsigned i = 0; i < _usUCtrlpoints; i++) {
-                for (unsigned j = 0; j < _usVCtrlpoints; j++) {
-                    _clThirdMatrix(m, n) = _clUSpline.GetIntegralOfProductOfBSplines(i, k, 3, 3)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 0)
-                        + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 3, 1)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 0, 2)
-                        + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 1, 3)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 2, 0)
-                        + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 1, 1)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 2, 2)
-                        + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 2, 2)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 1, 1)
-                        + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 0, 2)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 3, 1)
-                        + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 2, 0)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 1, 3)
-                        + _clUSpline.GetIntegralOfProductOfBSplines(i, k, 0, 0)
-                            * _clVSpline.GetIntegralOfProductOfBSplines(j, l, 3, 3);
-                    seq.next();
-                    n++;
-                }
-            }
-            m++;
-        }
-    }
+    int numU = static_cast<int>(_usUCtrlpoints);
+    int numV = static_cast<int>(_usVCtrlpoints);
+    int ordU = static_cast<int>(_usUOrder);
+    int ordV = static_cast<int>(_usVOrder);
+
+    BandedIntegrals u00(_clUSpline, numU, ordU, 0, 0), u11(_clUSpline, numU, ordU, 1, 1),
+        u22(_clUSpline, numU, ordU, 2, 2), u33(_clUSpline, numU, ordU, 3, 3),
+        u31(_clUSpline, numU, ordU, 3, 1), u13(_clUSpline, numU, ordU, 1, 3),
+        u02(_clUSpline, numU, ordU, 0, 2), u20(_clUSpline, numU, ordU, 2, 0);
+    BandedIntegrals v00(_clVSpline, numV, ordV, 0, 0), v11(_clVSpline, numV, ordV, 1, 1),
+        v22(_clVSpline, numV, ordV, 2, 2), v33(_clVSpline, numV, ordV, 3, 3),
+        v31(_clVSpline, numV, ordV, 3, 1), v13(_clVSpline, numV, ordV, 1, 3),
+        v02(_clVSpline, numV, ordV, 0, 2), v20(_clVSpline, numV, ordV, 2, 0);
+
+    auto term = [&](int i, int j, int k, int l) {
+        return u33(i, k) * v00(j, l) + u31(i, k) * v02(j, l) + u13(i, k) * v20(j, l)
+            + u11(i, k) * v22(j, l) + u22(i, k) * v11(j, l) + u02(i, k) * v31(j, l)
+            + u20(i, k) * v13(j, l) + u00(i, k) * v33(j, l);
+    };
+    _clThirdMatrix = assembleSmoothMatrix(numU, numV, ordU, ordV, term, seq);
 }
 
 void BSplineParameterCorrection::EnableSmoothing(bool bSmooth, double fSmoothInfl)
@@ -1385,32 +1379,35 @@ void BSplineParameterCorrection::EnableSmoothing(bool bSmooth,
     ParameterCorrection::EnableSmoothing(bSmooth, fSmoothInfl);
 }
 
-const math_Matrix& BSplineParameterCorrection::GetFirstSmoothMatrix() const
+const BSplineParameterCorrection::SparseMatrix&
+BSplineParameterCorrection::GetFirstSmoothMatrix() const
 {
     return _clFirstMatrix;
 }
 
-const math_Matrix& BSplineParameterCorrection::GetSecondSmoothMatrix() const
+const BSplineParameterCorrection::SparseMatrix&
+BSplineParameterCorrection::GetSecondSmoothMatrix() const
 {
     return _clSecondMatrix;
 }
 
-const math_Matrix& BSplineParameterCorrection::GetThirdSmoothMatrix() const
+const BSplineParameterCorrection::SparseMatrix&
+BSplineParameterCorrection::GetThirdSmoothMatrix() const
 {
     return _clThirdMatrix;
 }
 
-void BSplineParameterCorrection::SetFirstSmoothMatrix(const math_Matrix& rclMat)
+void BSplineParameterCorrection::SetFirstSmoothMatrix(const SparseMatrix& rclMat)
 {
     _clFirstMatrix = rclMat;
 }
 
-void BSplineParameterCorrection::SetSecondSmoothMatrix(const math_Matrix& rclMat)
+void BSplineParameterCorrection::SetSecondSmoothMatrix(const SparseMatrix& rclMat)
 {
     _clSecondMatrix = rclMat;
 }
 
-void BSplineParameterCorrection::SetThirdSmoothMatrix(const math_Matrix& rclMat)
+void BSplineParameterCorrection::SetThirdSmoothMatrix(const SparseMatrix& rclMat)
 {
     _clThirdMatrix = rclMat;
 }
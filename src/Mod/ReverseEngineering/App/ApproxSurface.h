@@ -23,6 +23,8 @@
 #ifndef REEN_APPROXSURFACE_H
 #define REEN_APPROXSURFACE_H
 
+#include <vector>
+
 #include <Geom_BSplineSurface.hxx>
 #include <TColStd_Array1OfInteger.hxx>
 #include <TColStd_Array1OfReal.hxx>
@@ -30,6 +32,7 @@
 #include <TColgp_Array1OfPnt2d.hxx>
 #include <TColgp_Array2OfPnt.hxx>
 #include <math_Matrix.hxx>
+#include <Eigen/Sparse>
 
 #include <Base/Vector3D.h>
 #include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
@@ -378,11 +381,18 @@ protected:
  * See Hoschek/Lasser 2nd ed. (1992).
  * The approximation is expanded to include smoothing terms so that smooth surfaces
  * can be generated.
+ *
+ * Since a B-spline basis function only has local support the observation matrix
+ * and the smoothing matrices are sparse and banded. They are therefore kept as
+ * sparse matrices and the systems are solved with sparse direct solvers.
  */
 
 class ReenExport BSplineParameterCorrection: public ParameterCorrection
 {
 public:
+    using SparseMatrix = Eigen::SparseMatrix<double>;
+    using Triplet = Eigen::Triplet<double>;
+
     // Constructor
     explicit BSplineParameterCorrection(
         unsigned usUOrder = 4,        // Order in u-direction (order = degree + 1)
@@ -404,16 +414,33 @@ protected:
     void DoParameterCorrection(int iIter) override;
 
     /**
-     * Solve an overdetermined LGS with the help of the Householder-Tansformation
+     * Solve an overdetermined LGS with the help of a sparse QR decomposition
      */
     bool SolveWithoutSmoothing() override;
 
     /**
-     * Solve a regular system of equations by LU decomposition. Depending on the weighting,
-     * smoothing terms are included
+     * Solve a regular system of equations by sparse Cholesky decomposition. If this fails
+     * the conjugate gradient method is used. Depending on the weighting, smoothing terms are
+     * included
      */
     bool SolveWithSmoothing(double fWeight) override;
 
+    /**
+     * Builds the sparse coefficient matrix of the overdetermined LGS. The rows are
+     * computed in parallel.
+     */
+    SparseMatrix CalcObservationMatrix();
+
+    /**
+     * Computes the right side of the overdetermined LGS, one column for each coordinate
+     */
+    Eigen::MatrixX3d CalcRightSide() const;
+
+    /**
+     * Sets the control points from the solution of the LGS
+     */
+    void SetControlPoints(const Eigen::MatrixX3d& solution);
+
 public:
     /**
      * Setting the knot vector
@@ -428,32 +455,32 @@ public:
     /**
      * Returns the first matrix of smoothing terms, if calculated
      */
-    virtual const math_Matrix& GetFirstSmoothMatrix() const;
+    virtual const SparseMatrix& GetFirstSmoothMatrix() const;
 
     /**
      * Returns the second matrix of smoothing terms, if calculated
      */
-    virtual const math_Matrix& GetSecondSmoothMatrix() const;
+    virtual const SparseMatrix& GetSecondSmoothMatrix() const;
 
     /**
      * Returns the third matrix of smoothing terms, if calculated
      */
-    virtual const math_Matrix& GetThirdSmoothMatrix() const;
+    virtual const SparseMatrix& GetThirdSmoothMatrix() const;
 
     /**
      * Sets the first matrix of the smoothing terms
      */
-    virtual void SetFirstSmoothMatrix(const math_Matrix& rclMat);
+    virtual void SetFirstSmoothMatrix(const SparseMatrix& rclMat);
 
     /**
      * Sets the second matrix of smoothing terms
      */
-    virtual void SetSecondSmoothMatrix(const math_Matrix& rclMat);
+    virtual void SetSecondSmoothMatrix(const SparseMatrix& rclMat);
 
     /**
      * Sets the third matrix of smoothing terms
      */
-    virtual void SetThirdSmoothMatrix(const math_Matrix& rclMat);
+    virtual void SetThirdSmoothMatrix(const SparseMatrix& rclMat);
 
     /**
      * Use smoothing-terms
@@ -491,12 +518,12 @@ protected:
     virtual void CalcThirdSmoothMatrix(Base::SequencerLauncher&);
 
 protected:
-    BSplineBasis _clUSpline;      //! B-spline basic function in the u-direction
-    BSplineBasis _clVSpline;      //! B-spline basic function in the v-direction
-    math_Matrix _clSmoothMatrix;  //! Matrix of smoothing functionals
-    math_Matrix _clFirstMatrix;   //! Matrix of the 1st smoothing functionals
-    math_Matrix _clSecondMatrix;  //! Matrix of the 2nd smoothing functionals
-    math_Matrix _clThirdMatrix;   //! Matrix of the 3rd smoothing functionals
+    BSplineBasis _clUSpline;       //! B-spline basic function in the u-direction
+    BSplineBasis _clVSpline;       //! B-spline basic function in the v-direction
+    SparseMatrix _clSmoothMatrix;  //! Matrix of smoothing functionals
+    SparseMatrix _clFirstMatrix;   //! Matrix of the 1st smoothing functionals
+    SparseMatrix _clSecondMatrix;  //! Matrix of the 2nd smoothing functionals
+    SparseMatrix _clThirdMatrix;   //! Matrix of the 3rd smoothing functionals
 };
 
 }  // namespace Reen
@@ -0,0 +1,197 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <Base/BoundBox.h>
+
+#include "PointKDTree.h"
+
+
+using namespace Reen;
+
+namespace
+{
+using Neighbour = std::pair<double, int>;  // squared distance, index
+using NeighbourQueue = std::priority_queue<Neighbour>;
+
+// Ranges smaller than this are not split up for the parallel build
+constexpr int minParallelRange = 4096;
+
+void searchNearest(const std::vector<Base::Vector3d>& points,
+                   const std::vector<int>& index,
+                   const std::vector<unsigned char>& axis,
+                   int first,
+                   int last,
+                   const Base::Vector3d& pnt,
+                   std::size_t k,
+                   double maxDist2,
+                   NeighbourQueue& queue)
+{
+    while (first < last) {
+        int mid = (first + last) / 2;
+        const Base::Vector3d& node = points[index[mid]];
+        double dist2 = Base::DistanceP2(pnt, node);
+        if (dist2 < maxDist2) {
+            if (queue.size() < k) {
+                queue.emplace(dist2, index[mid]);
+            }
+            else if (dist2 < queue.top().first) {
+                queue.pop();
+                queue.emplace(dist2, index[mid]);
+            }
+        }
+
+        double diff = pnt[axis[mid]] - node[axis[mid]];
+        int nearFirst = diff < 0.0 ? first : mid + 1;
+        int nearLast = diff < 0.0 ? mid : last;
+        int farFirst = diff < 0.0 ? mid + 1 : first;
+        int farLast = diff < 0.0 ? last : mid;
+
+        searchNearest(points, index, axis, nearFirst, nearLast, pnt, k, maxDist2, queue);
+
+        // the far side can only contain closer points if the splitting plane is close enough
+        double bound = queue.size() < k ? maxDist2 : queue.top().first;
+        if (diff * diff >= bound) {
+            return;
+        }
+        first = farFirst;
+        last = farLast;
+    }
+}
+}  // namespace
+
+PointKDTree::PointKDTree(const std::vector<Base::Vector3d>& points)
+    : points(points)
+    , index(points.size())
+    , axis(points.size(), 0)
+{
+    std::iota(index.begin(), index.end(), 0);
+
+    // Split the upper levels sequentially until there are enough independent
+    // ranges to keep all threads busy, then build the subtrees in parallel
+    std::vector<Range> ranges {{0, static_cast<int>(index.size())}};
+    const std::size_t numRanges = 4 * static_cast<std::size_t>(QThread::idealThreadCount());
+    while (ranges.size() < numRanges) {
+        std::vector<Range> next;
+        bool splitAny = false;
+        for (const auto& it : ranges) {
+            if (it.last - it.first < minParallelRange) {
+                next.push_back(it);
+                continue;
+            }
+            split(it.first, it.last);
+            int mid = (it.first + it.last) / 2;
+            next.push_back({it.first, mid});
+            next.push_back({mid + 1, it.last});
+            splitAny = true;
+        }
+        ranges.swap(next);
+        if (!splitAny) {
+            break;
+        }
+    }
+
+    QtConcurrent::blockingMap(ranges, [this](const Range& range) {
+        build(range.first, range.last);
+    });
+}
+
+void PointKDTree::split(int first, int last)
+{
+    // split along the axis of the biggest extent
+    Base::BoundBox3d box;
+    for (int i = first; i < last; i++) {
+        box.Add(points[index[i]]);
+    }
+
+    unsigned char dir = 0;
+    if (box.LengthY() > box.LengthX() && box.LengthY() >= box.LengthZ()) {
+        dir = 1;
+    }
+    else if (box.LengthZ() > box.LengthX() && box.LengthZ() > box.LengthY()) {
+        dir = 2;
+    }
+
+    int mid = (first + last) / 2;
+    std::nth_element(index.begin() + first,
+                     index.begin() + mid,
+                     index.begin() + last,
+                     [this, dir](int i1, int i2) {
+                         return points[i1][dir] < points[i2][dir];
+                     });
+    axis[mid] = dir;
+}
+
+void PointKDTree::build(int first, int last)
+{
+    if (last - first > 1) {
+        split(first, last);
+        int mid = (first + last) / 2;
+        build(first, mid);
+        build(mid + 1, last);
+    }
+}
+
+void PointKDTree::kNearest(const Base::Vector3d& pnt,
+                           std::size_t k,
+                           std::vector<int>& indices) const
+{
+    kNearest(pnt, k, std::numeric_limits<double>::max(), indices);
+}
+
+void PointKDTree::kNearest(const Base::Vector3d& pnt,
+                           std::size_t k,
+                           double radius,
+                           std::vector<int>& indices) const
+{
+    indices.clear();
+    if (k == 0) {
+        return;
+    }
+
+    double maxDist2 = radius < std::numeric_limits<double>::max()
+        ? radius * radius
+        : std::numeric_limits<double>::max();
+    NeighbourQueue queue;
+    searchNearest(points, index, axis, 0, static_cast<int>(index.size()), pnt, k, maxDist2, queue);
+
+    indices.resize(queue.size());
+    for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+        *it = queue.top().second;
+        queue.pop();
+    }
+}
+
+void PointKDTree::inRange(const Base::Vector3d& pnt,
+                          double radius,
+                          std::vector<int>& indices) const
+{
+    kNearest(pnt, index.size(), radius, indices);
+}
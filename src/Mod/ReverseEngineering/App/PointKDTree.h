@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef REEN_POINTKDTREE_H
+#define REEN_POINTKDTREE_H
+
+#include <vector>
+
+#include <Base/Vector3D.h>
+#include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
+
+
+namespace Reen
+{
+
+/**
+ * A static, balanced k-d tree over a point set. The tree is stored implicitly as a
+ * permutation of the point indices where the median of each range is the node.
+ * The subtrees are independent of each other and thus are built in parallel.
+ * All search functions are const and may be called concurrently.
+ * The point set must outlive the tree.
+ */
+class ReenExport PointKDTree
+{
+public:
+    explicit PointKDTree(const std::vector<Base::Vector3d>& points);
+
+    std::size_t size() const
+    {
+        return index.size();
+    }
+
+    /** Returns the indices of the \a k nearest points of \a pnt ordered by distance. */
+    void kNearest(const Base::Vector3d& pnt, std::size_t k, std::vector<int>& indices) const;
+    /** Returns the indices of the \a k nearest points of \a pnt with a distance less than
+     * \a radius ordered by distance. */
+    void kNearest(const Base::Vector3d& pnt,
+                  std::size_t k,
+                  double radius,
+                  std::vector<int>& indices) const;
+    /** Returns the indices of all points with a distance less than \a radius. */
+    void inRange(const Base::Vector3d& pnt, double radius, std::vector<int>& indices) const;
+
+private:
+    struct Range
+    {
+        int first;
+        int last;
+    };
+    void split(int first, int last);
+    void build(int first, int last);
+
+private:
+    const std::vector<Base::Vector3d>& points;
+    std::vector<int> index;
+    std::vector<unsigned char> axis;
+};
+
+}  // namespace Reen
+
+#endif  // REEN_POINTKDTREE_H
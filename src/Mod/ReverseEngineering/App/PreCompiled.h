@@ -32,6 +32,8 @@
 
 
 // standard
+#include <algorithm>
+#include <functional>
 #include <map>
 
 // boost
@@ -41,8 +43,10 @@
 #include <Geom_BSplineSurface.hxx>
 #include <Precision.hxx>
 #include <TColgp_Array1OfPnt.hxx>
-#include <math_Gauss.hxx>
-#include <math_Householder.hxx>
+
+// Eigen
+#include <Eigen/SparseCholesky>
+#include <Eigen/SparseQR>
 
 // Qt
 #include <QFuture>
@@ -0,0 +1,295 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+
+#include <QtConcurrentMap>
+#include <Eigen/Eigenvalues>
+
+#include <Base/BoundBox.h>
+#include <Base/Converter.h>
+#include <Base/Exception.h>
+#include <Mod/Points/App/Points.h>
+
+#include "PointKDTree.h"
+#include "Preprocessing.h"
+
+
+using namespace Reen;
+
+namespace
+{
+struct Centroid
+{
+    Base::Vector3d sum;
+    int count {0};
+};
+
+using VoxelMap = std::unordered_map<std::uint64_t, Centroid>;
+
+// Number of points handled by one parallel job
+constexpr std::size_t blockSize = 16384;
+
+std::vector<Base::Vector3d> validPoints(const Points::PointKernel& kernel)
+{
+    std::vector<Base::Vector3d> points;
+    points.reserve(kernel.size());
+    for (const auto& pnt : kernel) {
+        if (!std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z)) {
+            points.push_back(pnt);
+        }
+    }
+    return points;
+}
+
+std::vector<std::size_t> makeBlocks(std::size_t size)
+{
+    std::vector<std::size_t> blocks;
+    for (std::size_t i = 0; i < size; i += blockSize) {
+        blocks.push_back(i);
+    }
+    return blocks;
+}
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+VoxelGridFilter::VoxelGridFilter(const Points::PointKernel& pts)
+    : myPoints(pts)
+{}
+
+void VoxelGridFilter::setLeafSize(double lx, double ly, double lz)
+{
+    leafX = lx;
+    leafY = ly;
+    leafZ = lz;
+}
+
+void VoxelGridFilter::perform(std::vector<Base::Vector3d>& centroids) const
+{
+    if (leafX <= 0.0 || leafY <= 0.0 || leafZ <= 0.0) {
+        throw Base::ValueError("Leaf size must be positive");
+    }
+
+    std::vector<Base::Vector3d> points = validPoints(myPoints);
+    if (points.empty()) {
+        return;
+    }
+
+    Base::BoundBox3d box;
+    for (const auto& pnt : points) {
+        box.Add(pnt);
+    }
+
+    // Each voxel index is stored with 21 bits in the hash key
+    const double maxCells = static_cast<double>(1 << 21);
+    if (box.LengthX() / leafX >= maxCells || box.LengthY() / leafY >= maxCells
+        || box.LengthZ() / leafZ >= maxCells) {
+        throw Base::ValueError("Leaf size is too small for the extent of the point cloud");
+    }
+
+    auto key = [&](const Base::Vector3d& pnt) {
+        auto ix = static_cast<std::uint64_t>((pnt.x - box.MinX) / leafX);
+        auto iy = static_cast<std::uint64_t>((pnt.y - box.MinY) / leafY);
+        auto iz = static_cast<std::uint64_t>((pnt.z - box.MinZ) / leafZ);
+        return (ix << 42) | (iy << 21) | iz;
+    };
+
+    // Each block of points is accumulated into its own hash table
+    std::vector<std::size_t> blocks = makeBlocks(points.size());
+    std::vector<VoxelMap> maps = QtConcurrent::blockingMapped<std::vector<VoxelMap>>(
+        blocks,
+        [&](std::size_t first) {
+            VoxelMap voxels;
+            std::size_t last = std::min(first + blockSize, points.size());
+            for (std::size_t i = first; i < last; i++) {
+                Centroid& centroid = voxels[key(points[i])];
+                centroid.sum += points[i];
+                centroid.count++;
+            }
+            return voxels;
+        });
+
+    VoxelMap voxels = std::move(maps.front());
+    for (auto it = maps.begin() + 1; it != maps.end(); ++it) {
+        for (const auto& jt : *it) {
+            Centroid& centroid = voxels[jt.first];
+            centroid.sum += jt.second.sum;
+            centroid.count += jt.second.count;
+        }
+    }
+
+    // Order the result by voxel to make it independent of the hashing
+    std::vector<std::uint64_t> keys;
+    keys.reserve(voxels.size());
+    for (const auto& it : voxels) {
+        keys.push_back(it.first);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    centroids.reserve(centroids.size() + keys.size());
+    for (auto it : keys) {
+        const Centroid& centroid = voxels[it];
+        centroids.push_back(centroid.sum / static_cast<double>(centroid.count));
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+PCANormalEstimation::PCANormalEstimation(const Points::PointKernel& pts)
+    : myPoints(pts)
+{}
+
+void PCANormalEstimation::perform(std::vector<Base::Vector3f>& normals) const
+{
+    if (kSearch <= 0 && searchRadius <= 0.0) {
+        throw Base::ValueError("Either the number of neighbours or a search radius must be set");
+    }
+
+    std::vector<Base::Vector3d> points;
+    points.reserve(myPoints.size());
+    for (const auto& pnt : myPoints) {
+        points.push_back(pnt);
+    }
+
+    normals.assign(points.size(), Base::Vector3f());
+    if (points.empty()) {
+        return;
+    }
+
+    // points with invalid coordinates must not be part of the tree
+    std::vector<Base::Vector3d> valid;
+    std::vector<int> validIndex;
+    valid.reserve(points.size());
+    validIndex.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        const Base::Vector3d& pnt = points[i];
+        if (!std::isnan(pnt.x) && !std::isnan(pnt.y) && !std::isnan(pnt.z)) {
+            valid.push_back(pnt);
+            validIndex.push_back(static_cast<int>(i));
+        }
+    }
+
+    PointKDTree tree(valid);
+    std::size_t numNeighbours = kSearch > 0 ? static_cast<std::size_t>(kSearch) : valid.size();
+    double radius = searchRadius > 0.0 ? searchRadius : std::numeric_limits<double>::max();
+
+    // The neighbours are kept for the orientation step
+    std::vector<std::vector<int>> neighbours(valid.size());
+    std::vector<Base::Vector3d> result(valid.size());
+    std::vector<std::size_t> blocks = makeBlocks(valid.size());
+    QtConcurrent::blockingMap(blocks, [&](std::size_t first) {
+        std::size_t last = std::min(first + blockSize, valid.size());
+        for (std::size_t i = first; i < last; i++) {
+            std::vector<int>& indices = neighbours[i];
+            tree.kNearest(valid[i], numNeighbours, radius, indices);
+            if (indices.size() < 3) {
+                continue;
+            }
+
+            Base::Vector3d center;
+            for (int index : indices) {
+                center += valid[index];
+            }
+            center /= static_cast<double>(indices.size());
+
+            Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+            for (int index : indices) {
+                Base::Vector3d diff = valid[index] - center;
+                Eigen::Vector3d vec(diff.x, diff.y, diff.z);
+                cov += vec * vec.transpose();
+            }
+
+            // The normal is the eigenvector of the smallest eigenvalue
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(cov);
+            Eigen::Vector3d normal = solver.eigenvectors().col(0);
+            result[i] = Base::Vector3d(normal.x(), normal.y(), normal.z());
+        }
+    });
+
+    if (orient) {
+        // Propagate the orientation along a minimum spanning tree of the symmetric
+        // neighbourhood graph where the edge weight is 1 - |ni * nj| (Hoppe et al.)
+        std::vector<std::vector<int>> graph(valid.size());
+        for (std::size_t i = 0; i < neighbours.size(); i++) {
+            for (int j : neighbours[i]) {
+                if (j != static_cast<int>(i)) {
+                    graph[i].push_back(j);
+                    graph[j].push_back(static_cast<int>(i));
+                }
+            }
+        }
+
+        // Start each connected component at its highest point with an upward normal
+        std::vector<int> order(valid.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&valid](int i1, int i2) {
+            return valid[i1].z > valid[i2].z;
+        });
+
+        using Edge = std::pair<double, std::pair<int, int>>;  // weight, (from, to)
+        std::priority_queue<Edge, std::vector<Edge>, std::greater<>> queue;
+        std::vector<bool> visited(valid.size(), false);
+        for (int seed : order) {
+            if (visited[seed] || result[seed].Sqr() == 0.0) {
+                continue;
+            }
+            if (result[seed].z < 0.0) {
+                result[seed] = -result[seed];
+            }
+            visited[seed] = true;
+            for (int next : graph[seed]) {
+                queue.emplace(1.0 - std::fabs(result[seed] * result[next]),
+                              std::make_pair(seed, next));
+            }
+
+            while (!queue.empty()) {
+                auto [from, to] = queue.top().second;
+                queue.pop();
+                if (visited[to] || result[to].Sqr() == 0.0) {
+                    continue;
+                }
+                if (result[from] * result[to] < 0.0) {
+                    result[to] = -result[to];
+                }
+                visited[to] = true;
+                for (int next : graph[to]) {
+                    if (!visited[next]) {
+                        queue.emplace(1.0 - std::fabs(result[to] * result[next]),
+                                      std::make_pair(to, next));
+                    }
+                }
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < result.size(); i++) {
+        normals[validIndex[i]] = Base::convertTo<Base::Vector3f>(result[i]);
+    }
+}
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef REEN_PREPROCESSING_H
+#define REEN_PREPROCESSING_H
+
+#include <vector>
+
+#include <Base/Vector3D.h>
+#include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
+
+
+namespace Points
+{
+class PointKernel;
+}
+
+namespace Reen
+{
+
+/**
+ * Downsamples a point cloud by replacing all points inside a voxel by their centroid.
+ * The occupied voxels are collected in hash tables that are filled in parallel.
+ * Unlike the PCL based filter this doesn't depend on PCL.
+ */
+class ReenExport VoxelGridFilter
+{
+public:
+    explicit VoxelGridFilter(const Points::PointKernel&);
+    /** \brief Set the size of a voxel in x, y and z direction.
+     */
+    void setLeafSize(double lx, double ly, double lz);
+    /** \brief Perform the downsampling.
+     * \param[out] the centroids of the occupied voxels
+     */
+    void perform(std::vector<Base::Vector3d>& points) const;
+
+private:
+    const Points::PointKernel& myPoints;
+    double leafX {1.0};
+    double leafY {1.0};
+    double leafZ {1.0};
+};
+
+/**
+ * Estimates the point normals of a point cloud by a principal component analysis of the
+ * neighbourhood of each point. The neighbours are searched with a k-d tree and the normals
+ * are computed in parallel. Optionally, the normals are oriented consistently by propagating
+ * the orientation along a minimum spanning tree of the neighbourhood graph.
+ * Unlike NormalEstimation this doesn't depend on PCL.
+ */
+class ReenExport PCANormalEstimation
+{
+public:
+    explicit PCANormalEstimation(const Points::PointKernel&);
+    /** \brief Set the number of k nearest neighbors to use for the normal estimation.
+     */
+    void setKSearch(int k)
+    {
+        kSearch = k;
+    }
+    /** \brief Set the sphere radius that is to be used for determining the nearest neighbors.
+     * If also a number of neighbours is set then at most this number is used.
+     */
+    void setSearchRadius(double radius)
+    {
+        searchRadius = radius;
+    }
+    /** \brief Enable the consistent orientation of the normals.
+     */
+    void setOrientNormals(bool on)
+    {
+        orient = on;
+    }
+    /** \brief Perform the normal estimation.
+     * \param[out] the estimated normals, suitable for Points::PropertyNormalList. If a point
+     * has less than three neighbours its normal is the null vector.
+     */
+    void perform(std::vector<Base::Vector3f>& normals) const;
+
+private:
+    const Points::PointKernel& myPoints;
+    int kSearch {10};
+    double searchRadius {0.0};
+    bool orient {true};
+};
+
+}  // namespace Reen
+
+#endif  // REEN_PREPROCESSING_H
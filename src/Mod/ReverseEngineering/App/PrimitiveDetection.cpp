@@ -0,0 +1,598 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <numbers>
+#include <random>
+
+#include <QtConcurrentMap>
+
+#include <Base/BoundBox.h>
+#include <Base/Converter.h>
+#include <Mod/Mesh/App/Core/Approximation.h>
+#include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsGrid.h>
+
+#include "PrimitiveDetection.h"
+
+
+using namespace Reen;
+
+namespace
+{
+
+struct Model
+{
+    PrimitiveDetection::Type type {PrimitiveDetection::Type::Plane};
+    Base::Vector3d base;  // plane base, cylinder base, sphere center, cone apex
+    Base::Vector3d axis;  // plane normal, cylinder and cone axis
+    double radius {0.0};  // cylinder and sphere radius, cone half-angle
+    std::size_t score {0};
+
+    double distance(const Base::Vector3d& pnt) const
+    {
+        Base::Vector3d vec = pnt - base;
+        switch (type) {
+            case PrimitiveDetection::Type::Plane:
+                return std::fabs(vec * axis);
+            case PrimitiveDetection::Type::Sphere:
+                return std::fabs(vec.Length() - radius);
+            case PrimitiveDetection::Type::Cylinder: {
+                Base::Vector3d radial = vec - (vec * axis) * axis;
+                return std::fabs(radial.Length() - radius);
+            }
+            case PrimitiveDetection::Type::Cone: {
+                // distance in the half-plane spanned by the axis and the point
+                double height = vec * axis;
+                double rho = (vec - height * axis).Length();
+                double along = rho * std::sin(radius) + height * std::cos(radius);
+                if (along < 0.0) {
+                    return vec.Length();
+                }
+                return std::fabs(rho * std::cos(radius) - height * std::sin(radius));
+            }
+        }
+        return std::numeric_limits<double>::max();
+    }
+
+    Base::Vector3d normal(const Base::Vector3d& pnt) const
+    {
+        Base::Vector3d vec = pnt - base;
+        switch (type) {
+            case PrimitiveDetection::Type::Plane:
+                return axis;
+            case PrimitiveDetection::Type::Sphere:
+                return vec.Normalize();
+            case PrimitiveDetection::Type::Cylinder: {
+                Base::Vector3d radial = vec - (vec * axis) * axis;
+                return radial.Normalize();
+            }
+            case PrimitiveDetection::Type::Cone: {
+                Base::Vector3d radial = vec - (vec * axis) * axis;
+                radial.Normalize();
+                return std::cos(radius) * radial - std::sin(radius) * axis;
+            }
+        }
+        return axis;
+    }
+
+    std::vector<double> parameters() const
+    {
+        std::vector<double> param {base.x, base.y, base.z};
+        if (type != PrimitiveDetection::Type::Sphere) {
+            param.insert(param.end(), {axis.x, axis.y, axis.z});
+        }
+        if (type != PrimitiveDetection::Type::Plane) {
+            param.push_back(radius);
+        }
+        return param;
+    }
+};
+
+// Solves the 3x3 system with the rows r1, r2, r3 and the right side b by Cramer's rule
+bool solve3x3(const Base::Vector3d& r1,
+              const Base::Vector3d& r2,
+              const Base::Vector3d& r3,
+              const Base::Vector3d& b,
+              Base::Vector3d& x)
+{
+    Base::Vector3d c23 = r2 % r3;
+    Base::Vector3d c31 = r3 % r1;
+    Base::Vector3d c12 = r1 % r2;
+    double det = r1 * c23;
+    if (std::fabs(det) < 1e-12) {
+        return false;
+    }
+    x = (b.x * c23 + b.y * c31 + b.z * c12) / det;
+    return true;
+}
+
+class Detector
+{
+public:
+    using Type = PrimitiveDetection::Type;
+
+    Detector(const std::vector<Base::Vector3d>& points,
+             const std::vector<Base::Vector3d>& normals,
+             const PrimitiveDetection::Parameters& param)
+        : points(points)
+        , normals(normals)
+        , param(param)
+        , generator(param.seed)
+    {}
+
+    void setGrid(const Points::PointsGrid* grid)
+    {
+        this->grid = grid;
+    }
+
+    bool hasNormals() const
+    {
+        return !normals.empty();
+    }
+
+    std::size_t sampleSize(Type type) const
+    {
+        switch (type) {
+            case Type::Plane:
+                return 3;
+            case Type::Cylinder:
+                return 2;
+            case Type::Sphere:
+                return 4;
+            case Type::Cone:
+                return 3;
+        }
+        return 0;
+    }
+
+    bool sample(const std::vector<int>& remaining, std::size_t num, std::vector<int>& indices)
+    {
+        indices.clear();
+        std::uniform_int_distribution<std::size_t> dist(0, remaining.size() - 1);
+        indices.push_back(remaining[dist(generator)]);
+
+        // take the other points from the neighbourhood of the first point
+        std::vector<int> candidates;
+        const std::vector<int>* pool = &remaining;
+        if (grid && param.samplingRadius > 0.0) {
+            const Base::Vector3d& center = points[indices.front()];
+            Base::BoundBox3d box(center, param.samplingRadius);
+            std::vector<unsigned long> elements;
+            grid->InSide(box, elements, center, param.samplingRadius);
+            for (auto it : elements) {
+                if (active[it]) {
+                    candidates.push_back(static_cast<int>(it));
+                }
+            }
+            if (candidates.size() < num) {
+                return false;
+            }
+            pool = &candidates;
+        }
+
+        std::uniform_int_distribution<std::size_t> local(0, pool->size() - 1);
+        for (int tries = 0; indices.size() < num && tries < 10 * static_cast<int>(num); tries++) {
+            int index = (*pool)[local(generator)];
+            if (std::find(indices.begin(), indices.end(), index) == indices.end()) {
+                indices.push_back(index);
+            }
+        }
+
+        return indices.size() == num;
+    }
+
+    bool createModel(Type type, const std::vector<int>& indices, Model& model) const
+    {
+        model.type = type;
+        switch (type) {
+            case Type::Plane:
+                return createPlane(indices, model);
+            case Type::Cylinder:
+                return createCylinder(indices, model);
+            case Type::Sphere:
+                return createSphere(indices, model);
+            case Type::Cone:
+                return createCone(indices, model);
+        }
+        return false;
+    }
+
+    bool isInlier(const Model& model, int index) const
+    {
+        const Base::Vector3d& pnt = points[index];
+        if (model.distance(pnt) > param.distanceThreshold) {
+            return false;
+        }
+        if (hasNormals()) {
+            return std::fabs(model.normal(pnt) * normals[index]) >= param.normalThreshold;
+        }
+        return true;
+    }
+
+    std::size_t score(const Model& model, const std::vector<int>& remaining) const
+    {
+        return std::count_if(remaining.begin(), remaining.end(), [&](int index) {
+            return isInlier(model, index);
+        });
+    }
+
+    std::vector<int> inliers(const Model& model, const std::vector<int>& remaining) const
+    {
+        std::vector<int> result;
+        std::copy_if(remaining.begin(),
+                     remaining.end(),
+                     std::back_inserter(result),
+                     [&](int index) {
+                         return isInlier(model, index);
+                     });
+        return result;
+    }
+
+    // Refines the model with the fit algorithms of the Mesh module.
+    Model refine(const Model& model, const std::vector<int>& indices) const
+    {
+        Model fitted = model;
+        std::vector<Base::Vector3f> pts;
+        pts.reserve(indices.size());
+        for (int index : indices) {
+            pts.push_back(Base::convertTo<Base::Vector3f>(points[index]));
+        }
+
+        const float invalid = std::numeric_limits<float>::max();
+        switch (model.type) {
+            case Type::Plane: {
+                MeshCore::PlaneFit fit;
+                fit.AddPoints(pts);
+                if (fit.Fit() < invalid) {
+                    fitted.base = Base::convertTo<Base::Vector3d>(fit.GetBase());
+                    fitted.axis = Base::convertTo<Base::Vector3d>(fit.GetNormal());
+                }
+            } break;
+            case Type::Cylinder: {
+                MeshCore::CylinderFit fit;
+                fit.AddPoints(pts);
+                fit.SetInitialValues(Base::convertTo<Base::Vector3f>(model.base),
+                                     Base::convertTo<Base::Vector3f>(model.axis));
+                if (fit.Fit() < invalid) {
+                    fitted.base = Base::convertTo<Base::Vector3d>(fit.GetBase());
+                    fitted.axis = Base::convertTo<Base::Vector3d>(fit.GetAxis());
+                    fitted.radius = fit.GetRadius();
+                }
+            } break;
+            case Type::Sphere: {
+                MeshCore::SphereFit fit;
+                fit.AddPoints(pts);
+                if (fit.Fit() < invalid) {
+                    fitted.base = Base::convertTo<Base::Vector3d>(fit.GetCenter());
+                    fitted.radius = fit.GetRadius();
+                }
+            } break;
+            case Type::Cone:
+                // there is no cone fit available
+                break;
+        }
+
+        fitted.axis.Normalize();
+        return fitted;
+    }
+
+    double stdDeviation(const Model& model, const std::vector<int>& indices) const
+    {
+        if (indices.empty()) {
+            return 0.0;
+        }
+        double sum = 0.0;
+        for (int index : indices) {
+            double dist = model.distance(points[index]);
+            sum += dist * dist;
+        }
+        return std::sqrt(sum / static_cast<double>(indices.size()));
+    }
+
+    void setActive(std::vector<bool>&& flags)
+    {
+        active = std::move(flags);
+    }
+
+    void deactivate(const std::vector<int>& indices)
+    {
+        for (int index : indices) {
+            active[index] = false;
+        }
+    }
+
+private:
+    bool compatibleNormals(const Model& model, const std::vector<int>& indices) const
+    {
+        if (!hasNormals()) {
+            return true;
+        }
+        return std::all_of(indices.begin(), indices.end(), [&](int index) {
+            return std::fabs(model.normal(points[index]) * normals[index])
+                >= param.normalThreshold;
+        });
+    }
+
+    bool createPlane(const std::vector<int>& indices, Model& model) const
+    {
+        const Base::Vector3d& p1 = points[indices[0]];
+        const Base::Vector3d& p2 = points[indices[1]];
+        const Base::Vector3d& p3 = points[indices[2]];
+        Base::Vector3d normal = (p2 - p1) % (p3 - p1);
+        if (normal.Length() < 1e-12) {
+            return false;
+        }
+        model.base = p1;
+        model.axis = normal.Normalize();
+        return compatibleNormals(model, indices);
+    }
+
+    bool createSphere(const std::vector<int>& indices, Model& model) const
+    {
+        const Base::Vector3d& p0 = points[indices[0]];
+        const Base::Vector3d& p1 = points[indices[1]];
+        const Base::Vector3d& p2 = points[indices[2]];
+        const Base::Vector3d& p3 = points[indices[3]];
+        double s0 = p0.Sqr();
+        Base::Vector3d b(p1.Sqr() - s0, p2.Sqr() - s0, p3.Sqr() - s0);
+        Base::Vector3d center;
+        if (!solve3x3(2.0 * (p1 - p0), 2.0 * (p2 - p0), 2.0 * (p3 - p0), b, center)) {
+            return false;
+        }
+        model.base = center;
+        model.radius = Base::Distance(center, p0);
+        return compatibleNormals(model, indices);
+    }
+
+    bool createCylinder(const std::vector<int>& indices, Model& model) const
+    {
+        const Base::Vector3d& p1 = points[indices[0]];
+        const Base::Vector3d& p2 = points[indices[1]];
+        const Base::Vector3d& n1 = normals[indices[0]];
+        const Base::Vector3d& n2 = normals[indices[1]];
+        Base::Vector3d axis = n1 % n2;
+        if (axis.Length() < 1e-6) {
+            return false;
+        }
+        axis.Normalize();
+
+        // closest points of the two lines through the points along their normals
+        Base::Vector3d w = p1 - p2;
+        double b = n1 * n2;
+        double d = n1 * w;
+        double e = n2 * w;
+        double denom = n1.Sqr() * n2.Sqr() - b * b;
+        if (std::fabs(denom) < 1e-12) {
+            return false;
+        }
+        double s = (b * e - n2.Sqr() * d) / denom;
+        double t = (n1.Sqr() * e - b * d) / denom;
+        Base::Vector3d center = 0.5 * ((p1 + s * n1) + (p2 + t * n2));
+
+        model.base = center;
+        model.axis = axis;
+        Base::Vector3d v1 = p1 - center;
+        Base::Vector3d v2 = p2 - center;
+        model.radius = 0.5
+            * ((v1 - (v1 * axis) * axis).Length() + (v2 - (v2 * axis) * axis).Length());
+        return compatibleNormals(model, indices);
+    }
+
+    bool createCone(const std::vector<int>& indices, Model& model) const
+    {
+        // the apex is the intersection of the three tangent planes
+        const Base::Vector3d& p1 = points[indices[0]];
+        const Base::Vector3d& p2 = points[indices[1]];
+        const Base::Vector3d& p3 = points[indices[2]];
+        const Base::Vector3d& n1 = normals[indices[0]];
+        const Base::Vector3d& n2 = normals[indices[1]];
+        const Base::Vector3d& n3 = normals[indices[2]];
+        Base::Vector3d apex;
+        if (!solve3x3(n1, n2, n3, Base::Vector3d(n1 * p1, n2 * p2, n3 * p3), apex)) {
+            return false;
+        }
+
+        Base::Vector3d u1 = p1 - apex;
+        Base::Vector3d u2 = p2 - apex;
+        Base::Vector3d u3 = p3 - apex;
+        if (u1.Length() < 1e-12 || u2.Length() < 1e-12 || u3.Length() < 1e-12) {
+            return false;
+        }
+        u1.Normalize();
+        u2.Normalize();
+        u3.Normalize();
+
+        // the unit directions to the points lie on a circle around the axis
+        Base::Vector3d axis = (u2 - u1) % (u3 - u1);
+        if (axis.Length() < 1e-12) {
+            return false;
+        }
+        axis.Normalize();
+        if (axis * u1 < 0.0) {
+            axis = -axis;
+        }
+
+        double angle = (std::acos(std::clamp(axis * u1, -1.0, 1.0))
+                        + std::acos(std::clamp(axis * u2, -1.0, 1.0))
+                        + std::acos(std::clamp(axis * u3, -1.0, 1.0)))
+            / 3.0;
+        const double minAngle = std::numbers::pi / 180.0;
+        if (angle < minAngle || angle > std::numbers::pi / 2.0 - minAngle) {
+            return false;
+        }
+
+        model.base = apex;
+        model.axis = axis;
+        model.radius = angle;
+        return compatibleNormals(model, indices);
+    }
+
+private:
+    const std::vector<Base::Vector3d>& points;
+    const std::vector<Base::Vector3d>& normals;
+    const PrimitiveDetection::Parameters& param;
+    const Points::PointsGrid* grid {nullptr};
+    std::vector<bool> active;
+    std::mt19937 generator;
+};
+
+}  // namespace
+
+PrimitiveDetection::PrimitiveDetection(const Points::PointKernel& pts,
+                                       const std::vector<Base::Vector3d>& nor)
+    : myPoints(pts)
+    , myNormals(nor)
+{}
+
+void PrimitiveDetection::setParameters(const Parameters& param)
+{
+    myParameters = param;
+}
+
+const PrimitiveDetection::Parameters& PrimitiveDetection::getParameters() const
+{
+    return myParameters;
+}
+
+std::vector<PrimitiveDetection::Primitive> PrimitiveDetection::perform()
+{
+    std::vector<Base::Vector3d> points;
+    points.reserve(myPoints.size());
+    for (const auto& pnt : myPoints) {
+        points.push_back(pnt);
+    }
+
+    bool useNormals = myNormals.size() == points.size();
+    static const std::vector<Base::Vector3d> noNormals;
+    Detector detector(points, useNormals ? myNormals : noNormals, myParameters);
+
+    // points with invalid coordinates or normals are ignored
+    std::vector<int> remaining;
+    std::vector<bool> active(points.size(), false);
+    remaining.reserve(points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        const Base::Vector3d& pnt = points[i];
+        if (std::isnan(pnt.x) || std::isnan(pnt.y) || std::isnan(pnt.z)) {
+            continue;
+        }
+        if (useNormals) {
+            const Base::Vector3d& nor = myNormals[i];
+            if (std::isnan(nor.x) || std::isnan(nor.y) || std::isnan(nor.z)) {
+                continue;
+            }
+        }
+        remaining.push_back(static_cast<int>(i));
+        active[i] = true;
+    }
+    detector.setActive(std::move(active));
+
+    std::unique_ptr<Points::PointsGrid> grid;
+    if (myParameters.samplingRadius > 0.0) {
+        grid = std::make_unique<Points::PointsGrid>(myPoints, myParameters.samplingRadius);
+        detector.setGrid(grid.get());
+    }
+
+    std::vector<Type> types;
+    for (Type type : myParameters.types) {
+        if (type == Type::Plane || type == Type::Sphere || useNormals) {
+            types.push_back(type);
+        }
+    }
+
+    std::vector<Primitive> primitives;
+    std::size_t minSupport = std::max<std::size_t>(myParameters.minSupport, 1);
+    while (!types.empty() && remaining.size() >= minSupport) {
+        if (myParameters.maxPrimitives > 0 && primitives.size() >= myParameters.maxPrimitives) {
+            break;
+        }
+
+        // generate the hypotheses of all primitive types
+        std::vector<Model> candidates;
+        std::vector<int> indices;
+        for (Type type : types) {
+            std::size_t num = detector.sampleSize(type);
+            if (remaining.size() < num) {
+                continue;
+            }
+            for (int i = 0; i < myParameters.hypotheses; i++) {
+                Model model;
+                if (detector.sample(remaining, num, indices)
+                    && detector.createModel(type, indices, model)) {
+                    candidates.push_back(model);
+                }
+            }
+        }
+
+        if (candidates.empty()) {
+            break;
+        }
+
+        // scoring is independent for each hypothesis
+        QtConcurrent::blockingMap(candidates, [&detector, &remaining](Model& model) {
+            model.score = detector.score(model, remaining);
+        });
+
+        auto best = std::max_element(candidates.begin(),
+                                     candidates.end(),
+                                     [](const Model& m1, const Model& m2) {
+                                         return m1.score < m2.score;
+                                     });
+        if (best->score < minSupport) {
+            break;
+        }
+
+        Model model = *best;
+        std::vector<int> inliers = detector.inliers(model, remaining);
+        Model fitted = detector.refine(model, inliers);
+        std::vector<int> fittedInliers = detector.inliers(fitted, remaining);
+        if (fittedInliers.size() >= inliers.size()) {
+            model = fitted;
+            inliers.swap(fittedInliers);
+        }
+
+        Primitive primitive;
+        primitive.type = model.type;
+        primitive.parameters = model.parameters();
+        primitive.stdDeviation = detector.stdDeviation(model, inliers);
+        primitive.inliers = inliers;
+        primitives.push_back(primitive);
+
+        // remove the inliers from the remaining points
+        detector.deactivate(inliers);
+        std::vector<int> rest;
+        rest.reserve(remaining.size() - inliers.size());
+        std::set_difference(remaining.begin(),
+                            remaining.end(),
+                            inliers.begin(),
+                            inliers.end(),
+                            std::back_inserter(rest));
+        remaining.swap(rest);
+    }
+
+    return primitives;
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/***************************************************************************
+ *   Copyright (c) 2026 The FreeCAD Project Association AISBL              *
+ *                                                                         *
+ *   This file is part of FreeCAD.                                         *
+ *                                                                         *
+ *   FreeCAD is free software: you can redistribute it and/or modify it    *
+ *   under the terms of the GNU Lesser General Public License as           *
+ *   published by the Free Software Foundation, either version 2.1 of the  *
+ *   License, or (at your option) any later version.                       *
+ *                                                                         *
+ *   FreeCAD is distributed in the hope that it will be useful, but        *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU      *
+ *   Lesser General Public License for more details.                       *
+ *                                                                         *
+ *   You should have received a copy of the GNU Lesser General Public      *
+ *   License along with FreeCAD. If not, see                               *
+ *   <https://www.gnu.org/licenses/>.                                      *
+ *                                                                         *
+ **************************************************************************/
+
+#ifndef REEN_PRIMITIVEDETECTION_H
+#define REEN_PRIMITIVEDETECTION_H
+
+#include <vector>
+
+#include <Base/Vector3D.h>
+#include <Mod/ReverseEngineering/ReverseEngineeringGlobal.h>
+
+
+namespace Points
+{
+class PointKernel;
+}
+
+namespace Reen
+{
+
+/**
+ * Detects planes, cylinders, spheres and cones in a point cloud with a RANSAC approach.
+ * In each round a batch of hypotheses of all requested primitive types is generated from
+ * minimal point samples and scored in parallel against the remaining points. The best
+ * hypothesis is refined with the fit algorithms of the Mesh module, its inliers are
+ * removed and the next round starts.
+ * Unlike SampleConsensus this doesn't depend on PCL.
+ */
+class ReenExport PrimitiveDetection
+{
+public:
+    enum class Type
+    {
+        Plane,
+        Cylinder,
+        Sphere,
+        Cone
+    };
+
+    struct Parameters
+    {
+        /// Maximum distance of an inlier to the primitive
+        double distanceThreshold = 0.01;
+        /// Minimum cosine of the angle between a point normal and the primitive normal
+        double normalThreshold = 0.9;
+        /// Minimum number of inliers of a primitive
+        std::size_t minSupport = 100;
+        /// Number of hypotheses generated per primitive type in each round
+        int hypotheses = 100;
+        /// If positive the points of a sample are taken from this neighbourhood
+        /// of the first sample point, otherwise from the whole cloud
+        double samplingRadius = 0.0;
+        /// Maximum number of detected primitives, zero means no limit
+        std::size_t maxPrimitives = 0;
+        /// Primitive types to search for
+        std::vector<Type> types {Type::Plane, Type::Cylinder, Type::Sphere, Type::Cone};
+        /// Seed of the random number generator
+        unsigned int seed = 0;
+    };
+
+    /**
+     * The parameters of a detected primitive are:
+     * Plane: base point, normal
+     * Cylinder: base point, axis, radius
+     * Sphere: center, radius
+     * Cone: apex, axis, half-angle in radian
+     */
+    struct Primitive
+    {
+        Type type;
+        std::vector<double> parameters;
+        std::vector<int> inliers;
+        double stdDeviation;
+    };
+
+    /*!
+     * \brief PrimitiveDetection
+     * Cylinders and cones can only be detected if a normal for each point is given.
+     */
+    PrimitiveDetection(const Points::PointKernel&, const std::vector<Base::Vector3d>&);
+    void setParameters(const Parameters&);
+    const Parameters& getParameters() const;
+    std::vector<Primitive> perform();
+
+private:
+    const Points::PointKernel& myPoints;
+    const std::vector<Base::Vector3d>& myNormals;
+    Parameters myParameters;
+};
+
+}  // namespace Reen
+
+#endif  // REEN_PRIMITIVEDETECTION_H
@@ -125,6 +125,9 @@ void Sketch::clear()
     //     delete constr;
     // }
     Constrs.clear();
+    setUpConstraints.clear();
+    setUpConstrIndex.clear();
+    setUpExtGeoCount = 0;
 
     GCSsys.clear();
     isInitMove = false;
@@ -324,6 +327,21 @@ int Sketch::setUpSketch(const std::vector<Part::Geometry*>& GeoList,
 
     calculateDependentParametersElements();
 
+    // remember the set up for updateSketch(), Constrs is in the order of ConstraintList
+    setUpConstraints.reserve(ConstraintList.size());
+    setUpConstrIndex.reserve(ConstraintList.size());
+    std::size_t constrIndex = 0;
+    for (auto* constr : ConstraintList) {
+        setUpConstraints.emplace_back(constr->clone());
+        if (constrIndex < Constrs.size() && Constrs[constrIndex].constr == constr) {
+            setUpConstrIndex.push_back(static_cast<int>(constrIndex++));
+        }
+        else {
+            setUpConstrIndex.push_back(-1);
+        }
+    }
+    setUpExtGeoCount = extGeoCount;
+
     if (debugMode == GCS::Minimal || debugMode == GCS::IterationLevel) {
         Base::TimeElapsed end_time;
 
@@ -334,6 +352,104 @@ int Sketch::setUpSketch(const std::vector<Part::Geometry*>& GeoList,
     return GCSsys.dofsNumber();
 }
 
+namespace
+{
+// whether the constraints only differ in their value and in attributes the solver does not use
+bool haveSameStructure(const Constraint& constr1, const Constraint& constr2)
+{
+    if (constr1.Type != constr2.Type || constr1.AlignmentType != constr2.AlignmentType
+        || constr1.isDriving != constr2.isDriving || constr1.isActive != constr2.isActive
+        || constr1.InternalAlignmentIndex != constr2.InternalAlignmentIndex
+        || constr1.getElementsSize() != constr2.getElementsSize()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < constr1.getElementsSize(); i++) {
+        if (constr1.getElement(i) != constr2.getElement(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+}  // namespace
+
+bool Sketch::updateSketch(const std::vector<Part::Geometry*>& GeoList,
+                          const std::vector<Constraint*>& ConstraintList,
+                          int extGeoCount)
+{
+    Base::TimeElapsed start_time;
+
+    if (Geoms.empty() || GeoList.size() != Geoms.size() || extGeoCount != setUpExtGeoCount
+        || ConstraintList.size() != setUpConstraints.size() || hasConflicts()
+        || hasRedundancies() || hasPartialRedundancies() || hasMalformedConstraints()) {
+        return false;
+    }
+
+    // The solver parameters hold the geometry of the last solve, so the geometry must not have
+    // changed since then
+    std::size_t intGeoCount = GeoList.size() - extGeoCount;
+    for (std::size_t i = 0; i < GeoList.size(); i++) {
+        const Part::Geometry* geo = GeoList[i];
+        const Part::Geometry* solverGeo = Geoms[i].geo;
+        if (!geo->isSame(*solverGeo, Precision::Confusion(), Precision::Angular())) {
+            return false;
+        }
+        if (i < intGeoCount
+            && (GeometryFacade::getBlocked(geo) != GeometryFacade::getBlocked(solverGeo)
+                || GeometryFacade::getInternalType(geo)
+                    != GeometryFacade::getInternalType(solverGeo))) {
+            return false;
+        }
+    }
+
+    std::vector<std::pair<double*, double>> values;
+    for (std::size_t i = 0; i < ConstraintList.size(); i++) {
+        const Constraint* constr = ConstraintList[i];
+        if (!haveSameStructure(*constr, *setUpConstraints[i])) {
+            return false;
+        }
+        int index = setUpConstrIndex[i];
+        if (constr->getValue() == setUpConstraints[i]->getValue() || index < 0
+            || !Constrs[index].driving) {
+            // the value of a non-driving constraint is calculated by the solver
+            continue;
+        }
+        // the value of a tangency or of Snell's law is transformed while setting up the sketch
+        const ConstrDef& def = Constrs[index];
+        if (!constr->isDimensional() || constr->Type == SnellsLaw || !def.value
+            || def.secondvalue) {
+            return false;
+        }
+        values.emplace_back(def.value, constr->getValue());
+    }
+
+    for (const auto& [param, value] : values) {
+        *param = value;
+    }
+    for (std::size_t i = 0; i < ConstraintList.size(); i++) {
+        setUpConstraints[i]->setValue(ConstraintList[i]->getValue());
+        if (setUpConstrIndex[i] >= 0) {
+            Constrs[setUpConstrIndex[i]].constr = ConstraintList[i];
+        }
+    }
+    // take over the attributes of the geometry that don't matter to the solver
+    for (std::size_t i = 0; i < GeoList.size(); i++) {
+        delete Geoms[i].geo;
+        Geoms[i].geo = GeoList[i]->clone();
+    }
+
+    pDependencyGroups.clear();
+    resetSolver();
+
+    if (debugMode == GCS::Minimal || debugMode == GCS::IterationLevel) {
+        Base::TimeElapsed end_time;
+
+        Base::Console().log("Sketcher::updateSketch()-T:%s\n",
+                            Base::TimeElapsed::diffTime(start_time, end_time).c_str());
+    }
+
+    return true;
+}
+
 void Sketch::buildInternalAlignmentGeometryMap(const std::vector<Constraint*>& constraintList)
 {
     for (auto* c : constraintList) {
@@ -4626,6 +4742,7 @@ int Sketch::solve()
     Base::TimeElapsed start_time;
     std::string solvername;
 
+    GCSsys.resetIterationCount();
     auto result = internalSolve(solvername);
 
     Base::TimeElapsed end_time;
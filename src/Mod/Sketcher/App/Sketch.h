@@ -23,6 +23,8 @@
 #ifndef SKETCHER_SKETCH_H
 #define SKETCHER_SKETCH_H
 
+#include <memory>
+
 #include <Base/Persistence.h>
 #include <CXX/Objects.hxx>
 #include <Mod/Part/App/TopoShape.h>
@@ -77,6 +79,20 @@ public:
     int setUpSketch(const std::vector<Part::Geometry*>& GeoList,
                     const std::vector<Constraint*>& ConstraintList,
                     int extGeoCount = 0);
+    /** update the sketch set up by setUpSketch() for changed constraint values
+     *
+     * Setting up a sketch rebuilds the solver system and diagnoses it, which is the expensive
+     * part of solving a large sketch. If the geometry and the constraints only differ from the
+     * ones of the last set up in the values of driving dimensional constraints, the values are
+     * changed in place and the diagnosis of the last set up is kept. As the diagnosis of
+     * dependent constraints depends on the values, this is only done if the last set up found
+     * no conflicting, redundant or malformed constraints.
+     *
+     * returns true if the sketch was updated, false if it has to be set up again
+     */
+    bool updateSketch(const std::vector<Part::Geometry*>& GeoList,
+                      const std::vector<Constraint*>& ConstraintList,
+                      int extGeoCount = 0);
     /// return the actual geometry of the sketch a TopoShape
     Part::TopoShape toShape() const;
     /// add unspecified geometry
@@ -136,6 +152,22 @@ public:
     {
         return SolveTime;
     }
+    /// returns the number of solver iterations of the last solve, all algorithms tried included
+    inline int getSolveIterations() const
+    {
+        return GCSsys.getIterationCount();
+    }
+    /// returns the time in seconds the diagnosis of the last set up took
+    inline double getDiagnoseTime() const
+    {
+        return GCSsys.getDiagnoseTime();
+    }
+
+    /// returns the degree of freedom of the set up sketch
+    inline int getDoF() const
+    {
+        return GCSsys.dofsNumber();
+    }
 
     inline bool hasMalformedConstraints() const
     {
@@ -557,6 +589,11 @@ private:
 
     std::vector<GeoDef> Geoms;
     std::vector<ConstrDef> Constrs;
+    // copies of the constraints of the last set up and the index in Constrs of each of them,
+    // -1 if it is not passed to the solver, to detect the changes that need a new set up
+    std::vector<std::unique_ptr<Constraint>> setUpConstraints;
+    std::vector<int> setUpConstrIndex;
+    int setUpExtGeoCount = 0;
     GCS::System GCSsys;
     int ConstraintsCounter;
     std::vector<int> Conflicting;
@@ -29,6 +29,7 @@
 #include <BRepAdaptor_Curve.hxx>
 #include <BRepAdaptor_Surface.hxx>
 #include <Mod/Part/App/FCBRepAlgoAPI_Section.h>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeEdge.hxx>
 #include <BRepBuilderAPI_MakeFace.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
@@ -52,6 +53,7 @@
 #include <Geom_Parabola.hxx>
 #include <Geom_Plane.hxx>
 #include <Geom_TrimmedCurve.hxx>
+#include <OSD_Parallel.hxx>
 #include <Standard_Version.hxx>
 #include <TColStd_Array1OfInteger.hxx>
 #include <TopExp.hxx>
@@ -535,9 +537,18 @@ int SketchObject::solve(bool updateGeoAfterSolving /*=true*/)
     // We should have an updated Sketcher (sketchobject) geometry or this solve() should not have
     // happened therefore we update our sketch solver geometry with the SketchObject one.
     //
-    // set up a sketch (including dofs counting and diagnosing of conflicts)
-    lastDoF = solvedSketch.setUpSketch(
-        getCompleteGeometry(), Constraints.getValues(), getExternalGeometryCount());
+    // set up a sketch (including dofs counting and diagnosing of conflicts). If only the values
+    // of constraints changed since the last set up, e.g. while editing a dimension, the solver
+    // system and its diagnosis are updated in place.
+    std::vector<Part::Geometry*> completeGeometry = getCompleteGeometry();
+    if (solvedSketch.updateSketch(
+            completeGeometry, Constraints.getValues(), getExternalGeometryCount())) {
+        lastDoF = solvedSketch.getDoF();
+    }
+    else {
+        lastDoF = solvedSketch.setUpSketch(
+            completeGeometry, Constraints.getValues(), getExternalGeometryCount());
+    }
 
     // At this point we have the solver information about conflicting/redundant/over-constrained,
     // but the sketch is NOT solved. Some examples: Redundant: a vertical line, a horizontal line
@@ -8594,9 +8605,9 @@ std::vector<TopoDS_Shape> projectShape(const TopoDS_Shape& inShape, const gp_Ax3
         brep_hlr->Hide();
     }
     catch (const Standard_Failure& e) {
-        Base::Console().error("GO::projectShape - OCC error - %s - while projecting shape\n",
-            e.GetMessageString());
-        throw Base::RuntimeError("SketchObject::projectShape - OCC error");
+        // Reported by the caller, which may run concurrently
+        throw Base::RuntimeError(std::string("SketchObject::projectShape - OCC error - ")
+                                 + e.GetMessageString());
     }
     catch (...) {
         throw Base::RuntimeError("SketchObject::projectShape - unknown error");
@@ -8752,6 +8763,119 @@ void processFace (const Rotation& invRot,
     }
 }
 
+void importVertex(const TopoDS_Shape& refSubShape,
+                  const Handle(Geom_Plane)& gPlane,
+                  const Base::Placement& invPlm,
+                  std::vector<std::unique_ptr<Part::Geometry>>& geos)
+{
+    gp_Pnt P = BRep_Tool::Pnt(TopoDS::Vertex(refSubShape));
+    GeomAPI_ProjectPointOnSurf proj(P, gPlane);
+    P = proj.NearestPoint();
+    Base::Vector3d p(P.X(), P.Y(), P.Z());
+    invPlm.multVec(p, p);
+
+    Part::GeomPoint* point = new Part::GeomPoint(p);
+    GeometryFacade::setConstruction(point, true);
+    geos.emplace_back(point);
+}
+
+// Project and/or intersect an external reference with the sketch plane. Only the OCC objects
+// created here are modified, so several references can be processed concurrently. Returns the
+// number of geometries of the projection, the following ones are those of the intersection.
+std::size_t projectExternal(const TopoDS_Shape& shape,
+                            bool projection,
+                            bool intersection,
+                            const Base::Placement& invPlm,
+                            const Base::Rotation& invRot,
+                            const gp_Trsf& mov,
+                            const gp_Pln& sketchPlane,
+                            double arcFitTolerance,
+                            std::vector<std::unique_ptr<Part::Geometry>>& geos)
+{
+    TopoDS_Shape refSubShape = shape;
+    gp_Ax3 sketchAx3 = sketchPlane.Position();
+    Handle(Geom_Plane) gPlane = new Geom_Plane(sketchPlane);
+    BRepBuilderAPI_MakeFace mkFace(sketchPlane);
+    TopoDS_Shape aProjFace = mkFace.Shape();
+
+    if (projection && !refSubShape.IsNull()) {
+        switch (refSubShape.ShapeType()) {
+        case TopAbs_FACE: {
+            processFace(invRot, invPlm, mov, sketchPlane, gPlane, sketchAx3, aProjFace, geos, refSubShape);
+        } break;
+        case TopAbs_EDGE: {
+            const TopoDS_Edge& edge = TopoDS::Edge(refSubShape);
+            processEdge(edge, geos, gPlane, invPlm, mov, sketchPlane, invRot, sketchAx3, aProjFace);
+        } break;
+        case TopAbs_VERTEX: {
+            importVertex(refSubShape, gPlane, invPlm, geos);
+        } break;
+        default:
+            throw Base::TypeError("Unknown type of geometry");
+            break;
+        }
+    }
+    std::size_t projSize = geos.size();
+
+    if (intersection && !refSubShape.IsNull()) {
+        FCBRepAlgoAPI_Section maker(refSubShape, sketchPlane);
+        maker.Approximation(Standard_True);
+        if (!maker.IsDone())
+            FC_THROWM(Base::CADKernelError, "Failed to get intersection");
+        Part::TopoShape intersectionShape(maker.Shape());
+        auto edges = intersectionShape.getSubTopoShapes(TopAbs_EDGE);
+        for (const auto& s : edges) {
+            TopoDS_Edge edge = TopoDS::Edge(s.getShape());
+            processEdge(edge, geos, gPlane, invPlm, mov, sketchPlane, invRot, sketchAx3, aProjFace);
+        }
+        // Section of some face (e.g. sphere) produce more than one arcs
+        // from the same circle. So we try to fit the arcs with a single
+        // circle/arc.
+        if (refSubShape.ShapeType() == TopAbs_FACE && geos.size() > 1) {
+            auto wires = Part::TopoShape().makeElementWires(edges);
+            if (wires.countSubShapes(TopAbs_WIRE) == 1) {
+                TopoDS_Vertex firstVertex, lastVertex;
+                BRepTools_WireExplorer exp(TopoDS::Wire(wires.getSubShape(TopAbs_WIRE, 1)));
+                firstVertex = exp.CurrentVertex();
+                while (!exp.More())
+                    exp.Next();
+                lastVertex = exp.CurrentVertex();
+                gp_Pnt P1 = BRep_Tool::Pnt(firstVertex);
+                gp_Pnt P2 = BRep_Tool::Pnt(lastVertex);
+                if (auto geo = fitArcs(geos, P1, P2, arcFitTolerance)) {
+                    geos.clear();
+                    geos.emplace_back(geo);
+                }
+            }
+        }
+        for (const auto& s : intersectionShape.getSubShapes(TopAbs_VERTEX, TopAbs_EDGE)) {
+            importVertex(s, gPlane, invPlm, geos);
+        }
+    }
+
+    return projSize;
+}
+
+// Message of the exception being handled
+std::string currentExceptionMessage()
+{
+    try {
+        throw;
+    }
+    catch (Base::Exception& e) {
+        return e.what();
+    }
+    catch (Standard_Failure& e) {
+        return e.GetMessageString();
+    }
+    catch (std::exception& e) {
+        return e.what();
+    }
+    catch (...) {
+        return "Unknown exception";
+    }
+}
+
 }
 
 void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd)
@@ -8819,34 +8943,44 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
     gp_Ax3 sketchAx3(
         gp_Pnt(Pos.x, Pos.y, Pos.z), gp_Dir(dN.x, dN.y, dN.z), gp_Dir(dX.x, dX.y, dX.z));
     gp_Pln sketchPlane(sketchAx3);
-
-    Handle(Geom_Plane) gPlane = new Geom_Plane(sketchPlane);
-    BRepBuilderAPI_MakeFace mkFace(sketchPlane);
-    TopoDS_Shape aProjFace = mkFace.Shape();
+    double arcFitTolerance = ArcFitTolerance.getValue();
 
     Types.resize(Objects.size(), static_cast<long>(ExtType::Projection));
 
-    std::set<std::string> refSet;
-    // We use a vector here to keep the order (roughly) the same as ExternalGeometry
-    std::vector<std::vector<std::unique_ptr<Part::Geometry> > > newGeos;
-    newGeos.reserve(Objects.size());
+    struct ExternalJob
+    {
+        std::string key;
+        bool frozen = false;
+        bool beingCreated = false;
+        long type = 0;
+        TopoDS_Shape shape;
+        std::vector<std::unique_ptr<Part::Geometry>> geos;
+        std::size_t projSize = 0;
+        bool cached = false;
+        std::string error;
+    };
+
+    // First resolve the referenced shapes and take the projections of those references whose
+    // shape, type and sketch placement did not change since the last rebuild from the cache.
+    // Shapes made on the fly (App::Plane, Part::DatumLine, Part::DatumPoint) never match, but
+    // they are cheap to project.
+    std::vector<ExternalJob> jobs(Objects.size());
+    std::vector<int> pending;
     for (int i=0; i < int(Objects.size()); i++) {
         const App::DocumentObject *Obj=Objects[i];
         const std::string &SubElement=SubElements[i];
-        const std::string &key = keys[i];
+        auto &job = jobs[i];
+        job.key = keys[i];
+        job.type = Types[i];
 
-        bool beingCreated = false;
         if (extToAdd) {
-            beingCreated = extToAdd->obj == Obj && extToAdd->subname == SubElement;
+            job.beingCreated = extToAdd->obj == Obj && extToAdd->subname == SubElement;
         }
 
-        bool projection = Types[i] == (int)ExtType::Projection || Types[i] == (int)ExtType::Both;
-        bool intersection = Types[i] == (int)ExtType::Intersection || Types[i] == (int)ExtType::Both;
-
         // Skip frozen geometries
         bool frozen = false;
         bool sync = false;
-        for(auto id : externalGeoRefMap[key]) {
+        for(auto id : externalGeoRefMap[job.key]) {
             auto it = externalGeoMap.find(id);
             if(it != externalGeoMap.end()) {
                 auto egf = ExternalGeometryFacade::getFacade(ExternalGeo[it->second]);
@@ -8859,27 +8993,13 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
             }
         }
         if(frozen && !sync) {
-            refSet.insert(std::move(key));
+            job.frozen = true;
             continue;
         }
         if (!Obj || !Obj->getNameInDocument()) {
             continue;
         }
 
-        std::vector<std::unique_ptr<Part::Geometry> > geos;
-
-        auto importVertex = [&](const TopoDS_Shape& refSubShape) {
-            gp_Pnt P = BRep_Tool::Pnt(TopoDS::Vertex(refSubShape));
-            GeomAPI_ProjectPointOnSurf proj(P, gPlane);
-            P = proj.NearestPoint();
-            Base::Vector3d p(P.X(), P.Y(), P.Z());
-            invPlm.multVec(p, p);
-
-            Part::GeomPoint* point = new Part::GeomPoint(p);
-            GeometryFacade::setConstruction(point, true);
-            geos.emplace_back(point);
-        };
-
         try {
             TopoDS_Shape refSubShape;
 
@@ -8941,109 +9061,122 @@ void SketchObject::rebuildExternalGeometry(std::optional<ExternalToAdd> extToAdd
                 throw Base::TypeError(
                     "Datum feature type is not yet supported as external geometry for a sketch");
             }
+            job.shape = refSubShape;
+        } catch (...) {
+            job.error = currentExceptionMessage();
+            continue;
+        }
 
-            if (projection && !refSubShape.IsNull()) {
-                switch (refSubShape.ShapeType()) {
-                case TopAbs_FACE: {
-                    processFace(invRot, invPlm, mov, sketchPlane, gPlane, sketchAx3, aProjFace, geos, refSubShape);
-                } break;
-                case TopAbs_EDGE: {
-                    const TopoDS_Edge& edge = TopoDS::Edge(refSubShape);
-                    processEdge(edge, geos, gPlane, invPlm, mov, sketchPlane, invRot, sketchAx3, aProjFace);
-                } break;
-                case TopAbs_VERTEX: {
-                    importVertex(refSubShape);
-                } break;
-                default:
-                    throw Base::TypeError("Unknown type of geometry");
-                    break;
-                }
-                if (beingCreated && !extToAdd->intersection) {
-                    // We are adding the projections, so we need to initialize those
-                    for (auto& geo : geos) {
-                        auto egf = ExternalGeometryFacade::getFacade(geo.get());
-                        egf->setFlag(ExternalGeometryExtension::Defining, extToAdd->defining);
-                    }
+        // The projections of a reference being created get extra flags, so don't reuse them
+        if (!job.beingCreated) {
+            auto it = externalProjectionCache.find(job.key);
+            if (it != externalProjectionCache.end() && it->second.shape.IsEqual(job.shape)
+                && it->second.type == job.type && it->second.placement == Plm
+                && it->second.arcFitTolerance == arcFitTolerance) {
+                for (auto& geo : it->second.geos) {
+                    job.geos.emplace_back(geo->copy());
                 }
+                job.cached = true;
+                continue;
             }
-            int projSize = geos.size();
-
-            if (intersection && !refSubShape.IsNull()) {
-                FCBRepAlgoAPI_Section maker(refSubShape, sketchPlane);
-                maker.Approximation(Standard_True);
-                if (!maker.IsDone())
-                    FC_THROWM(Base::CADKernelError, "Failed to get intersection");
-                Part::TopoShape intersectionShape(maker.Shape());
-                auto edges = intersectionShape.getSubTopoShapes(TopAbs_EDGE);
-                for (const auto& s : edges) {
-                    TopoDS_Edge edge = TopoDS::Edge(s.getShape());
-                    processEdge(edge, geos, gPlane, invPlm, mov, sketchPlane, invRot, sketchAx3, aProjFace);
-                }
-                // Section of some face (e.g. sphere) produce more than one arcs
-                // from the same circle. So we try to fit the arcs with a single
-                // circle/arc.
-                if (refSubShape.ShapeType() == TopAbs_FACE && geos.size() > 1) {
-                    auto wires = Part::TopoShape().makeElementWires(edges);
-                    if (wires.countSubShapes(TopAbs_WIRE) == 1) {
-                        TopoDS_Vertex firstVertex, lastVertex;
-                        BRepTools_WireExplorer exp(TopoDS::Wire(wires.getSubShape(TopAbs_WIRE, 1)));
-                        firstVertex = exp.CurrentVertex();
-                        while (!exp.More())
-                            exp.Next();
-                        lastVertex = exp.CurrentVertex();
-                        gp_Pnt P1 = BRep_Tool::Pnt(firstVertex);
-                        gp_Pnt P2 = BRep_Tool::Pnt(lastVertex);
-                        if (auto geo = fitArcs(geos, P1, P2, ArcFitTolerance.getValue())) {
-                            geos.clear();
-                            geos.emplace_back(geo);
-                        }
-                    }
-                }
-                for (const auto& s : intersectionShape.getSubShapes(TopAbs_VERTEX, TopAbs_EDGE)) {
-                    importVertex(s);
-                }
+        }
+        pending.push_back(i);
+    }
 
-                if (beingCreated && extToAdd->intersection) {
-                    // We are adding the projections, so we need to initialize those
-                    for (size_t i = projSize; i < geos.size(); ++i) {
-                        auto egf = ExternalGeometryFacade::getFacade(geos[i].get());
-                        egf->setFlag(ExternalGeometryExtension::Defining, extToAdd->defining);
-                    }
+    // The remaining references are independent of each other, so project them concurrently.
+    // OCC algorithms may modify the shapes they work on, therefore concurrent tasks work on
+    // copies of the shapes. Errors are only reported afterwards as Base::Console is not thread
+    // safe.
+    bool parallel = pending.size() > 1;
+    OSD_Parallel::For(
+        0,
+        static_cast<int>(pending.size()),
+        [&](int n) {
+            auto& job = jobs[pending[n]];
+            bool projection = job.type == (int)ExtType::Projection || job.type == (int)ExtType::Both;
+            bool intersection = job.type == (int)ExtType::Intersection || job.type == (int)ExtType::Both;
+            try {
+                TopoDS_Shape shape = job.shape;
+                if (parallel && !shape.IsNull()) {
+                    shape = BRepBuilderAPI_Copy(shape).Shape();
                 }
-            }
+                job.projSize = projectExternal(shape,
+                                               projection,
+                                               intersection,
+                                               invPlm,
+                                               invRot,
+                                               mov,
+                                               sketchPlane,
+                                               arcFitTolerance,
+                                               job.geos);
+            } catch (...) {
+                job.geos.clear();
+                job.error = currentExceptionMessage();
+            }
+        },
+        !parallel);
 
-        } catch (Base::Exception &e) {
-            FC_ERR("Failed to project external geometry in "
-                   << getFullName() << ": " << key << std::endl << e.what());
-            continue;
-        } catch (Standard_Failure &e) {
-            FC_ERR("Failed to project external geometry in "
-                   << getFullName() << ": " << key << std::endl << e.GetMessageString());
-            continue;
-        } catch (std::exception &e) {
-            FC_ERR("Failed to project external geometry in "
-                   << getFullName() << ": " << key << std::endl << e.what());
+    std::set<std::string> refSet;
+    // We use a vector here to keep the order (roughly) the same as ExternalGeometry
+    std::vector<std::vector<std::unique_ptr<Part::Geometry> > > newGeos;
+    newGeos.reserve(Objects.size());
+    for (auto &job : jobs) {
+        auto &geos = job.geos;
+        if (job.frozen) {
+            refSet.insert(job.key);
             continue;
-        } catch (...) {
+        }
+        if (!job.error.empty()) {
             FC_ERR("Failed to project external geometry in "
-                   << getFullName() << ": " << key << std::endl << "Unknown exception");
+                   << getFullName() << ": " << job.key << std::endl << job.error);
             continue;
         }
         if (geos.empty()) {
             continue;
         }
 
-        if(!refSet.emplace(key).second) {
-            FC_WARN("Duplicated external reference in " << getFullName() << ": " << key);
+        if(!refSet.emplace(job.key).second) {
+            FC_WARN("Duplicated external reference in " << getFullName() << ": " << job.key);
             continue;
         }
 
+        if (job.beingCreated) {
+            // We are adding the projections or intersections, so we need to initialize those
+            std::size_t begin = extToAdd->intersection ? job.projSize : 0;
+            std::size_t end = extToAdd->intersection ? geos.size() : job.projSize;
+            for (std::size_t i = begin; i < std::min(end, geos.size()); ++i) {
+                auto egf = ExternalGeometryFacade::getFacade(geos[i].get());
+                egf->setFlag(ExternalGeometryExtension::Defining, extToAdd->defining);
+            }
+        }
+        else if (!job.cached) {
+            auto &entry = externalProjectionCache[job.key];
+            entry.shape = job.shape;
+            entry.placement = Plm;
+            entry.type = job.type;
+            entry.arcFitTolerance = arcFitTolerance;
+            entry.geos.clear();
+            for (auto& geo : geos) {
+                entry.geos.emplace_back(geo->copy());
+            }
+        }
+
         for (auto& geo : geos) {
-            ExternalGeometryFacade::getFacade(geo.get())->setRef(key);
+            ExternalGeometryFacade::getFacade(geo.get())->setRef(job.key);
         }
         newGeos.push_back(std::move(geos));
     }
 
+    // Forget the references that are gone or failed
+    for (auto it = externalProjectionCache.begin(); it != externalProjectionCache.end();) {
+        if (refSet.count(it->first)) {
+            ++it;
+        }
+        else {
+            it = externalProjectionCache.erase(it);
+        }
+    }
+
     // allocate unique geometry id
     for(auto &geos : newGeos) {
         auto egf = ExternalGeometryFacade::getFacade(geos.front().get());
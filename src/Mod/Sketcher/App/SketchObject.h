@@ -1125,6 +1125,19 @@ private:
     // mapping from ExternalGeo[*].Id to index of ExternalGeo
     std::map<long, int> externalGeoMap;
 
+    // Projections of ExternalGeometry[*] made by the last rebuildExternalGeometry(), stored with
+    // the inputs they were made from. The referenced shape is held so that its TShape cannot be
+    // released and its address reused while the entry exists.
+    struct ExternalProjection
+    {
+        TopoDS_Shape shape;
+        Base::Placement placement;
+        long type = 0;
+        double arcFitTolerance = 0.0;
+        std::vector<std::unique_ptr<Part::Geometry>> geos;
+    };
+    std::map<std::string, ExternalProjection> externalProjectionCache;
+
     // mapping from Geometry[*].Id to index of Geometry
     std::map<long, int> geoMap;
 
@@ -0,0 +1,308 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#include <algorithm>
+#include <cmath>
+
+#include "ConstraintBatch.h"
+
+
+namespace GCS
+{
+
+namespace
+{
+
+int slotCount(ConstraintType type)
+{
+    switch (type) {
+        case Equal:
+            return 2;
+        case Difference:
+            return 3;
+        case P2PDistance:
+            return 5;
+        case PointOnLine:
+            return 6;
+        case Parallel:
+        case Perpendicular:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+bool ConstraintBatch::isBatched(Constraint* constr)
+{
+    return slotCount(constr->getTypeId()) > 0;
+}
+
+void ConstraintBatch::add(int row, Constraint* constr, const std::vector<int>& columns)
+{
+    ConstraintType type = constr->getTypeId();
+    auto it = std::ranges::find_if(groups, [type](const Group& group) {
+        return group.type == type;
+    });
+    if (it == groups.end()) {
+        int slots = slotCount(type);
+        it = groups.emplace(groups.end());
+        it->type = type;
+        it->columns.resize(slots);
+        it->params.resize(slots);
+        it->values.resize(slots);
+        it->grads.resize(slots);
+    }
+
+    Group& group = *it;
+    VEC_pD params = constr->params();
+    group.constrs.push_back(constr);
+    group.rows.push_back(row);
+    for (std::size_t slot = 0; slot < group.columns.size(); slot++) {
+        group.columns[slot].push_back(columns[slot]);
+        group.params[slot].push_back(params[slot]);
+        group.values[slot].push_back(*params[slot]);
+        group.grads[slot].push_back(0.);
+    }
+    group.scales.push_back(constr->getScale());
+    group.ratios.push_back(type == Equal ? static_cast<ConstraintEqual*>(constr)->getRatio() : 1.);
+    group.errors.push_back(0.);
+}
+
+void ConstraintBatch::clear()
+{
+    groups.clear();
+}
+
+void ConstraintBatch::update()
+{
+    for (auto& group : groups) {
+        for (std::size_t slot = 0; slot < group.columns.size(); slot++) {
+            for (std::size_t k = 0; k < group.rows.size(); k++) {
+                if (group.columns[slot][k] < 0) {
+                    group.values[slot][k] = *group.params[slot][k];
+                }
+            }
+        }
+        for (std::size_t k = 0; k < group.constrs.size(); k++) {
+            group.scales[k] = group.constrs[k]->getScale();
+        }
+    }
+}
+
+void ConstraintBatch::calcResidual(const double* x, double* r)
+{
+    for (auto& group : groups) {
+        evaluate(group, x, false);
+        for (std::size_t k = 0; k < group.rows.size(); k++) {
+            r[group.rows[k]] = group.errors[k];
+        }
+    }
+}
+
+void ConstraintBatch::evaluate(Group& group, const double* x, bool withGrad)
+{
+    // gather the current values of the variables
+    int count = static_cast<int>(group.rows.size());
+    for (std::size_t slot = 0; slot < group.columns.size(); slot++) {
+        const int* columns = group.columns[slot].data();
+        double* values = group.values[slot].data();
+        for (int k = 0; k < count; k++) {
+            if (columns[k] >= 0) {
+                values[k] = x[columns[k]];
+            }
+        }
+    }
+
+    const double* scale = group.scales.data();
+    double* err = group.errors.data();
+    auto v = [&group](int slot) -> const double* {
+        return group.values[slot].data();
+    };
+    auto g = [&group](int slot) -> double* {
+        return group.grads[slot].data();
+    };
+
+    switch (group.type) {
+        case Equal: {
+            const double* p1 = v(0);
+            const double* p2 = v(1);
+            const double* ratio = group.ratios.data();
+            for (int k = 0; k < count; k++) {
+                err[k] = scale[k] * (p1[k] - ratio[k] * p2[k]);
+            }
+            if (withGrad) {
+                double* g1 = g(0);
+                double* g2 = g(1);
+                for (int k = 0; k < count; k++) {
+                    g1[k] = scale[k];
+                    g2[k] = -scale[k];
+                }
+            }
+        } break;
+        case Difference: {
+            const double* p1 = v(0);
+            const double* p2 = v(1);
+            const double* d = v(2);
+            for (int k = 0; k < count; k++) {
+                err[k] = scale[k] * (p2[k] - p1[k] - d[k]);
+            }
+            if (withGrad) {
+                double* g1 = g(0);
+                double* g2 = g(1);
+                double* gd = g(2);
+                for (int k = 0; k < count; k++) {
+                    g1[k] = -scale[k];
+                    g2[k] = scale[k];
+                    gd[k] = -scale[k];
+                }
+            }
+        } break;
+        case P2PDistance: {
+            const double* p1x = v(0);
+            const double* p1y = v(1);
+            const double* p2x = v(2);
+            const double* p2y = v(3);
+            const double* dist = v(4);
+            double* g1x = g(0);
+            double* g1y = g(1);
+            double* g2x = g(2);
+            double* g2y = g(3);
+            double* gd = g(4);
+            for (int k = 0; k < count; k++) {
+                double dx = p1x[k] - p2x[k];
+                double dy = p1y[k] - p2y[k];
+                double d = std::sqrt(dx * dx + dy * dy);
+                err[k] = scale[k] * (d - dist[k]);
+                if (withGrad) {
+                    g1x[k] = scale[k] * (dx / d);
+                    g1y[k] = scale[k] * (dy / d);
+                    g2x[k] = scale[k] * (-dx / d);
+                    g2y[k] = scale[k] * (-dy / d);
+                    gd[k] = -scale[k];
+                }
+            }
+        } break;
+        case PointOnLine: {
+            const double* p0x = v(0);
+            const double* p0y = v(1);
+            const double* p1x = v(2);
+            const double* p1y = v(3);
+            const double* p2x = v(4);
+            const double* p2y = v(5);
+            double* g0x = g(0);
+            double* g0y = g(1);
+            double* g1x = g(2);
+            double* g1y = g(3);
+            double* g2x = g(4);
+            double* g2y = g(5);
+            for (int k = 0; k < count; k++) {
+                double x0 = p0x[k], x1 = p1x[k], x2 = p2x[k];
+                double y0 = p0y[k], y1 = p1y[k], y2 = p2y[k];
+                double dx = x2 - x1;
+                double dy = y2 - y1;
+                double d2 = dx * dx + dy * dy;
+                double d = std::sqrt(d2);
+                double area = -x0 * dy + y0 * dx + x1 * y2 - x2 * y1;
+                err[k] = scale[k] * area / d;
+                if (withGrad) {
+                    g0x[k] = scale[k] * ((y1 - y2) / d);
+                    g0y[k] = scale[k] * ((x2 - x1) / d);
+                    g1x[k] = scale[k] * (((y2 - y0) * d + (dx / d) * area) / d2);
+                    g1y[k] = scale[k] * (((x0 - x2) * d + (dy / d) * area) / d2);
+                    g2x[k] = scale[k] * (((y0 - y1) * d - (dx / d) * area) / d2);
+                    g2y[k] = scale[k] * (((x1 - x0) * d - (dy / d) * area) / d2);
+                }
+            }
+        } break;
+        case Parallel:
+        case Perpendicular: {
+            bool parallel = group.type == Parallel;
+            const double* l1p1x = v(0);
+            const double* l1p1y = v(1);
+            const double* l1p2x = v(2);
+            const double* l1p2y = v(3);
+            const double* l2p1x = v(4);
+            const double* l2p1y = v(5);
+            const double* l2p2x = v(6);
+            const double* l2p2y = v(7);
+            for (int k = 0; k < count; k++) {
+                double dx1 = l1p1x[k] - l1p2x[k];
+                double dy1 = l1p1y[k] - l1p2y[k];
+                double dx2 = l2p1x[k] - l2p2x[k];
+                double dy2 = l2p1y[k] - l2p2y[k];
+                err[k] = parallel ? scale[k] * (dx1 * dy2 - dy1 * dx2)
+                                  : scale[k] * (dx1 * dx2 + dy1 * dy2);
+            }
+            if (!withGrad) {
+                break;
+            }
+            double* g1p1x = g(0);
+            double* g1p1y = g(1);
+            double* g1p2x = g(2);
+            double* g1p2y = g(3);
+            double* g2p1x = g(4);
+            double* g2p1y = g(5);
+            double* g2p2x = g(6);
+            double* g2p2y = g(7);
+            if (parallel) {
+                for (int k = 0; k < count; k++) {
+                    double dx1 = l1p1x[k] - l1p2x[k];
+                    double dy1 = l1p1y[k] - l1p2y[k];
+                    double dx2 = l2p1x[k] - l2p2x[k];
+                    double dy2 = l2p1y[k] - l2p2y[k];
+                    g1p1x[k] = scale[k] * dy2;
+                    g1p2x[k] = scale[k] * -dy2;
+                    g1p1y[k] = scale[k] * -dx2;
+                    g1p2y[k] = scale[k] * dx2;
+                    g2p1x[k] = scale[k] * -dy1;
+                    g2p2x[k] = scale[k] * dy1;
+                    g2p1y[k] = scale[k] * dx1;
+                    g2p2y[k] = scale[k] * -dx1;
+                }
+            }
+            else {
+                for (int k = 0; k < count; k++) {
+                    double dx1 = l1p1x[k] - l1p2x[k];
+                    double dy1 = l1p1y[k] - l1p2y[k];
+                    double dx2 = l2p1x[k] - l2p2x[k];
+                    double dy2 = l2p1y[k] - l2p2y[k];
+                    g1p1x[k] = scale[k] * dx2;
+                    g1p2x[k] = scale[k] * -dx2;
+                    g1p1y[k] = scale[k] * dy2;
+                    g1p2y[k] = scale[k] * -dy2;
+                    g2p1x[k] = scale[k] * dx1;
+                    g2p2x[k] = scale[k] * -dx1;
+                    g2p1y[k] = scale[k] * dy1;
+                    g2p2y[k] = scale[k] * -dy1;
+                }
+            }
+        } break;
+        default:
+            break;
+    }
+}
+
+}  // namespace GCS
@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2026 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+
+#ifndef PLANEGCS_CONSTRAINTBATCH_H
+#define PLANEGCS_CONSTRAINTBATCH_H
+
+#include <vector>
+
+#include "Constraints.h"
+
+namespace GCS
+{
+
+/** Batched evaluation of the constraints of the most common types
+ *
+ * Evaluating the constraints one by one through Constraint::error() and Constraint::grad() costs
+ * a virtual call and a chase of the parameter pointers per constraint, and each entry of the
+ * gradient evaluates the constraint again. ConstraintBatch groups the constraints by type and
+ * keeps their parameters in one contiguous array per parameter slot, so that the errors and all
+ * gradient entries of a group are computed in a single loop that the compiler can vectorise.
+ *
+ * The formulas are the same as in the constraint classes, which remain the reference and
+ * evaluate all the other types.
+ */
+class ConstraintBatch
+{
+public:
+    /// If the constraint is of a type that is evaluated in batches
+    static bool isBatched(Constraint* constr);
+
+    /** Add a constraint
+     * @param row: the index of the constraint in the residual vector
+     * @param constr: the constraint, its parameters must not be redirected
+     * @param columns: the index of each parameter of the constraint in the vector of variables
+     *                 or -1 if the parameter is not a variable
+     */
+    void add(int row, Constraint* constr, const std::vector<int>& columns);
+    void clear();
+
+    /// Read the values of the parameters that are not variables and the scales of the constraints
+    void update();
+
+    /// Write the error of each constraint into its row of r
+    void calcResidual(const double* x, double* r);
+
+    /// Call func(row, column, error, derivative) for each derivative with respect to a variable
+    template<typename Func>
+    void forEachDerivative(const double* x, Func&& func)
+    {
+        for (auto& group : groups) {
+            evaluate(group, x, true);
+            std::size_t count = group.rows.size();
+            for (std::size_t slot = 0; slot < group.columns.size(); slot++) {
+                const int* columns = group.columns[slot].data();
+                const double* grads = group.grads[slot].data();
+                for (std::size_t k = 0; k < count; k++) {
+                    if (columns[k] >= 0) {
+                        func(group.rows[k], columns[k], group.errors[k], grads[k]);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    struct Group
+    {
+        ConstraintType type;
+        std::vector<Constraint*> constrs;
+        std::vector<int> rows;
+        // one array per parameter slot, with one entry per constraint
+        std::vector<std::vector<int>> columns;
+        std::vector<std::vector<double*>> params;
+        std::vector<VEC_D> values;
+        std::vector<VEC_D> grads;
+        VEC_D scales;
+        VEC_D ratios;
+        VEC_D errors;
+    };
+
+    void evaluate(Group& group, const double* x, bool withGrad);
+
+private:
+    std::vector<Group> groups;
+};
+
+}  // namespace GCS
+
+#endif  // PLANEGCS_CONSTRAINTBATCH_H
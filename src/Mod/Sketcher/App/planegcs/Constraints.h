@@ -158,6 +158,11 @@ public:
         return driving;
     }
 
+    double getScale() const
+    {
+        return scale;
+    }
+
     void setInternalAlignment(Alignment isinternalalignment)
     {
         internalAlignment = isinternalalignment;
@@ -224,6 +229,10 @@ private:
 
 public:
     ConstraintEqual(double* p1, double* p2, double p1p2ratio = 1.0);
+    double getRatio() const
+    {
+        return ratio;
+    }
     ConstraintType getTypeId() override;
     double error() override;
     double grad(double*) override;
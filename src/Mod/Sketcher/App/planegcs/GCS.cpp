@@ -47,10 +47,13 @@
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <future>
 #include <iostream>
 #include <limits>
 #include <numbers>
+#include <thread>
 
 #include "GCS.h"
 #include "qp_eq.h"
@@ -83,6 +86,7 @@
 #ifdef EIGEN_SPARSEQR_COMPATIBLE
 #include <Eigen/OrderingMethods>
 #endif
+#include <Eigen/SparseCholesky>
 
 // _GCS_EXTRACT_SOLVER_SUBSYSTEM_ to be enabled in Constraints.h when needed.
 #if defined(_GCS_EXTRACT_SOLVER_SUBSYSTEM_) || defined(_DEBUG_TO_FILE)
@@ -471,6 +475,9 @@ System::System()
     , hasDiagnosis(false)
     , isInit(false)
     , emptyDiagnoseMatrix(true)
+    , diagnosisReused(false)
+    , iterationCount(0)
+    , diagnoseTime(0.0)
     , maxIter(100)
     , maxIterRedundant(100)
     , sketchSizeMultiplier(false)
@@ -479,6 +486,9 @@ System::System()
     , convergenceRedundant(1e-10)
     , qrAlgorithm(EigenSparseQR)
     , dogLegGaussStep(FullPivLU)
+    , sparseJacobianThreshold(400)
+    , solveClustersConcurrently(true)
+    , cacheDiagnosis(true)
     , qrpivotThreshold(1E-13)
     , debugMode(Minimal)
     , LM_eps(1E-10)
@@ -1825,7 +1835,10 @@ void System::initSolution(Algorithm alg)
 
     // diagnose conflicting or redundant constraints
     if (!hasDiagnosis) {
+        auto start = std::chrono::steady_clock::now();
         diagnose(alg);
+        diagnoseTime =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     }
 
     // if still no diagnosis after explicitly calling `diagnose`, nothing to do here
@@ -1974,26 +1987,69 @@ int System::solve(bool isFine, Algorithm alg, bool isRedundantsolving)
         return Failed;
     }
 
-    bool isReset = false;
-    // return success by default in order to permit coincidence constraints to be applied
-    // even if no other system has to be solved
-    int res = Success;
+    std::vector<int> clusters;
     for (int cid = 0; cid < int(subSystems.size()); cid++) {
-        if ((subSystems[cid] || subSystemsAux[cid]) && !isReset) {
-            resetToReference();
-            isReset = true;
+        if (subSystems[cid] || subSystemsAux[cid]) {
+            clusters.push_back(cid);
         }
+    }
+    if (!clusters.empty()) {
+        resetToReference();
+    }
+
+    auto solveCluster = [&](int cid) {
         if (subSystems[cid] && subSystemsAux[cid]) {
-            res = std::max(res,
-                           solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving));
+            return solve(subSystems[cid], subSystemsAux[cid], isFine, isRedundantsolving);
         }
         else if (subSystems[cid]) {
-            res = std::max(res, solve(subSystems[cid], isFine, alg, isRedundantsolving));
+            return solve(subSystems[cid], isFine, alg, isRedundantsolving);
+        }
+        return solve(subSystemsAux[cid], isFine, alg, isRedundantsolving);
+    };
+
+    // The clusters share neither constraints nor parameters, so they can be solved
+    // concurrently. The iteration level debug output and the subsystem extraction are not
+    // thread-safe and keep the clusters in sequence.
+    std::vector<int> results(clusters.size(), Success);
+    unsigned int numThreads = std::min<std::size_t>(std::thread::hardware_concurrency(),
+                                                    clusters.size());
+    bool concurrent = solveClustersConcurrently && numThreads > 1 && debugMode != IterationLevel;
+#ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
+    concurrent = false;
+#endif
+    if (concurrent) {
+        // Clusters differ a lot in size, so every task picks the next cluster when it is done
+        std::atomic<std::size_t> next {0};
+        auto worker = [&]() {
+            for (std::size_t i = next++; i < clusters.size(); i = next++) {
+                results[i] = solveCluster(clusters[i]);
+            }
+        };
+        std::vector<std::future<void>> futures;
+        for (unsigned int i = 1; i < numThreads; i++) {
+            futures.push_back(std::async(std::launch::async, worker));
+        }
+        worker();
+        // wait for all tasks before an exception of one of them is passed on
+        for (auto& fut : futures) {
+            fut.wait();
         }
-        else if (subSystemsAux[cid]) {
-            res = std::max(res, solve(subSystemsAux[cid], isFine, alg, isRedundantsolving));
+        for (auto& fut : futures) {
+            fut.get();
         }
     }
+    else {
+        for (std::size_t i = 0; i < clusters.size(); i++) {
+            results[i] = solveCluster(clusters[i]);
+        }
+    }
+
+    // return success by default in order to permit coincidence constraints to be applied
+    // even if no other system has to be solved
+    int res = Success;
+    for (int result : results) {
+        res = std::max(res, result);
+    }
     if (res == Success) {
         for (std::set<Constraint*>::const_iterator constr = redundant.begin();
              constr != redundant.end();
@@ -2083,6 +2139,7 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     double h_norm {};
 
     for (int iter = 1; iter < maxIterNumber; ++iter) {
+        ++iterationCount;
         h_norm = h.norm();
         if (h_norm <= convCriterion || err <= smallF) {
             if (debugMode == IterationLevel) {
@@ -2155,6 +2212,47 @@ int System::solve_BFGS(SubSystem* subsys, bool /*isFine*/, bool isRedundantsolvi
     return Failed;
 }
 
+namespace
+{
+
+Eigen::VectorXd denseGaussStep(const Eigen::MatrixXd& Jx,
+                               const Eigen::VectorXd& fx,
+                               DogLegGaussStep method)
+{
+    // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
+    // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
+    switch (method) {
+        case LeastNormFullPivLU:
+            return Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
+        case LeastNormLdlt:
+            return Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
+        case FullPivLU:
+        default:
+            return Jx.fullPivLu().solve(-fx);
+    }
+}
+
+// Least norm Gauss-Newton step h = J^T (J J^T)^-1 (-fx) with a sparse Jacobian.
+// Returns false if J J^T is (nearly) singular, e.g. because of redundant constraints.
+bool sparseGaussStep(const Eigen::SparseMatrix<double>& Jx,
+                     const Eigen::VectorXd& fx,
+                     Eigen::VectorXd& h)
+{
+    Eigen::SparseMatrix<double> JJt = Jx * Jx.transpose();
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(JJt);
+    if (ldlt.info() != Eigen::Success) {
+        return false;
+    }
+    Eigen::VectorXd y = ldlt.solve(-fx);
+    if (ldlt.info() != Eigen::Success || !y.allFinite()) {
+        return false;
+    }
+    h = Jx.transpose() * y;
+    return (Jx * h + fx).norm() <= 1e-5 * fx.norm();
+}
+
+}  // namespace
+
 int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 {
 #ifdef _GCS_EXTRACT_SOLVER_SUBSYSTEM_
@@ -2168,10 +2266,23 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         return Success;
     }
 
+    // Each constraint only depends on a few parameters, so for large systems the dense
+    // matrices would mostly hold zeros
+    bool sparse = xsize >= sparseJacobianThreshold;
+
     Eigen::VectorXd e(csize),
         e_new(csize);  // vector of all function errors (every constraint is one function)
-    Eigen::MatrixXd J(csize, xsize);  // Jacobi of the subsystem
-    Eigen::MatrixXd A(xsize, xsize);
+    Eigen::MatrixXd J;  // Jacobi of the subsystem
+    Eigen::MatrixXd A;
+    Eigen::SparseMatrix<double> SJ, SA, SI;  // the same for a sparse system
+    if (sparse) {
+        SI.resize(xsize, xsize);
+        SI.setIdentity();
+    }
+    else {
+        J.resize(csize, xsize);
+        A.resize(xsize, xsize);
+    }
     Eigen::VectorXd x(xsize), h(xsize), x_new(xsize), g(xsize), diag_A(xsize);
 
     subsys->redirectParams();
@@ -2209,6 +2320,7 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
     double nu = 2, mu = 0;
     int iter = 0, stop = 0;
     for (iter = 0; iter < maxIterNumber && !stop; ++iter) {
+        ++iterationCount;
         // check error
         double err = e.squaredNorm();
         if (err <= eps * eps) {
@@ -2223,14 +2335,25 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         }
 
         // J^T J, J^T e
-        subsys->calcJacobi(J);
+        if (sparse) {
+            subsys->calcJacobi(SJ);
+            // adding the zero identity stores the whole diagonal so that it can be
+            // augmented in place
+            SA = SJ.transpose() * SJ + 0. * SI;
+            g = SJ.transpose() * e;
+            diag_A = SA.diagonal();
+        }
+        else {
+            subsys->calcJacobi(J);
 
-        A = J.transpose() * J;
-        g = J.transpose() * e;
+            A = J.transpose() * J;
+            g = J.transpose() * e;
+            diag_A =
+                A.diagonal();  // save diagonal entries so that augmentation can be later canceled
+        }
 
         // Compute ||J^T e||_inf
         double g_inf = g.lpNorm<Eigen::Infinity>();
-        diag_A = A.diagonal();  // save diagonal entries so that augmentation can be later canceled
 
         // check for convergence
         if (g_inf <= eps1) {
@@ -2247,14 +2370,25 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
         // determine increment using adaptive damping
         int k = 0;
         while (k < 50) {
-            // augment normal equations A = A+uI
-            for (int i = 0; i < xsize; ++i) {
-                A(i, i) += mu;
+            double rel_error {};
+            if (sparse) {
+                // augment normal equations A = A+uI, which is positive definite for u > 0
+                SA.diagonal() = diag_A.array() + mu;
+                Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> ldlt(SA);
+                h = ldlt.solve(g);
+                rel_error = ldlt.info() == Eigen::Success ? (SA * h - g).norm() / g.norm()
+                                                          : std::numeric_limits<double>::infinity();
             }
+            else {
+                // augment normal equations A = A+uI
+                for (int i = 0; i < xsize; ++i) {
+                    A(i, i) += mu;
+                }
 
-            // solve augmented functions A*h=-g
-            h = A.fullPivLu().solve(g);
-            double rel_error = (A * h - g).norm() / g.norm();
+                // solve augmented functions A*h=-g
+                h = A.fullPivLu().solve(g);
+                rel_error = (A * h - g).norm() / g.norm();
+            }
 
             // check if solving works
             if (rel_error < 1e-5) {
@@ -2304,8 +2438,13 @@ int System::solve_LM(SubSystem* subsys, bool isRedundantsolving)
 
             mu *= nu;
             nu *= 2.0;
-            for (int i = 0; i < xsize; ++i) {  // restore diagonal J^T J entries
-                A(i, i) = diag_A(i);
+            if (sparse) {
+                SA.diagonal() = diag_A;  // restore diagonal J^T J entries
+            }
+            else {
+                for (int i = 0; i < xsize; ++i) {  // restore diagonal J^T J entries
+                    A(i, i) = diag_A(i);
+                }
             }
 
             k++;
@@ -2378,19 +2517,47 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         Base::Console().log(tmp.c_str());
     }
 
+    // Each constraint only depends on a few parameters, so for large systems the dense
+    // Jacobian would mostly hold zeros
+    bool sparse = xsize >= sparseJacobianThreshold;
+
     Eigen::VectorXd x(xsize), x_new(xsize);
     Eigen::VectorXd fx(csize), fx_new(csize);
-    Eigen::MatrixXd Jx(csize, xsize), Jx_new(csize, xsize);
+    Eigen::MatrixXd Jx, Jx_new;
+    Eigen::SparseMatrix<double> SJx, SJx_new;
     Eigen::VectorXd g(xsize), h_sd(xsize), h_gn(xsize), h_dl(xsize);
 
+    auto calcJacobi = [&](Eigen::MatrixXd& J, Eigen::SparseMatrix<double>& SJ) {
+        if (sparse) {
+            subsys->calcJacobi(SJ);
+        }
+        else {
+            subsys->calcJacobi(J);
+        }
+    };
+    // Jx * v
+    auto multJx = [&](const Eigen::VectorXd& v) -> Eigen::VectorXd {
+        if (sparse) {
+            return SJx * v;
+        }
+        return Jx * v;
+    };
+    // Jx^T * v
+    auto multJxT = [&](const Eigen::VectorXd& v) -> Eigen::VectorXd {
+        if (sparse) {
+            return SJx.transpose() * v;
+        }
+        return Jx.transpose() * v;
+    };
+
     subsys->redirectParams();
 
     double err;
     subsys->getParams(x);
     subsys->calcResidual(fx, err);
-    subsys->calcJacobi(Jx);
+    calcJacobi(Jx, SJx);
 
-    g = Jx.transpose() * (-fx);
+    g = multJxT(-fx);
 
     // get the infinity norm fx_inf and g_inf
     double g_inf = g.lpNorm<Eigen::Infinity>();
@@ -2403,6 +2570,7 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
     double nu = 2.;
     int iter = 0, stop = 0, reduce = 0;
     while (!stop) {
+        ++iterationCount;
         // check if finished
         if (fx_inf <= tolf) {
             // Success
@@ -2428,25 +2596,19 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         }
 
         // get the steepest descent direction
-        alpha = g.squaredNorm() / (Jx * g).squaredNorm();
+        alpha = g.squaredNorm() / multJx(g).squaredNorm();
         h_sd = alpha * g;
 
-        // get the gauss-newton step
-        // https://forum.freecad.org/viewtopic.php?f=10&t=12769&start=50#p106220
-        // https://forum.kde.org/viewtopic.php?f=74&t=129439#p346104
-        switch (dogLegGaussStep) {
-            case FullPivLU:
-                h_gn = Jx.fullPivLu().solve(-fx);
-                break;
-            case LeastNormFullPivLU:
-                h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).fullPivLu().solve(-fx);
-                break;
-            case LeastNormLdlt:
-                h_gn = Jx.adjoint() * (Jx * Jx.adjoint()).ldlt().solve(-fx);
-                break;
+        // get the gauss-newton step, a sparse system falls back to the dense decomposition
+        // if its least norm step can't be determined
+        if (!sparse) {
+            h_gn = denseGaussStep(Jx, fx, dogLegGaussStep);
+        }
+        else if (!sparseGaussStep(SJx, fx, h_gn)) {
+            h_gn = denseGaussStep(Eigen::MatrixXd(SJx), fx, dogLegGaussStep);
         }
 
-        double rel_error = (Jx * h_gn + fx).norm() / fx.norm();
+        double rel_error = (multJx(h_gn) + fx).norm() / fx.norm();
         if (rel_error > 1e15) {
             break;
         }
@@ -2486,20 +2648,21 @@ int System::solve_DL(SubSystem* subsys, bool isRedundantsolving)
         x_new = x + h_dl;
         subsys->setParams(x_new);
         subsys->calcResidual(fx_new, err_new);
-        subsys->calcJacobi(Jx_new);
+        calcJacobi(Jx_new, SJx_new);
 
         // calculate the linear model and the update ratio
-        double dL = err - 0.5 * (fx + Jx * h_dl).squaredNorm();
+        double dL = err - 0.5 * (fx + multJx(h_dl)).squaredNorm();
         double dF = err - err_new;
         double rho = dL / dF;
 
         if (dF > 0 && dL > 0) {
             x = x_new;
-            Jx = Jx_new;
+            Jx.swap(Jx_new);
+            SJx.swap(SJx_new);
             fx = fx_new;
             err = err_new;
 
-            g = Jx.transpose() * (-fx);
+            g = multJxT(-fx);
 
             // get infinity norms
             g_inf = g.lpNorm<Eigen::Infinity>();
@@ -4666,6 +4829,7 @@ int System::solve(SubSystem* subsysA, SubSystem* subsysB, bool /*isFine*/, bool
     double mu = 0;
     lambda.setZero();
     for (int iter = 1; iter < maxIterNumber; iter++) {
+        ++iterationCount;
         int status = qp_eq(B, grad, JA, resA, xdir, Y, Z);
         if (status) {
             break;
@@ -4804,10 +4968,11 @@ void System::makeReducedJacobian(Eigen::MatrixXd& J,
                                  std::map<int, int>& tagmultiplicity)
 {
     // construct specific parameter list for diagonose ignoring driven constraint parameters
+    SET_pD drivenparams(pdrivenlist.begin(), pdrivenlist.end());
+    MAP_pD_I pdiagnoseindex;
     for (int j = 0; j < int(plist.size()); j++) {
-        auto result1 = std::ranges::find(pdrivenlist, plist[j]);
-
-        if (result1 == std::end(pdrivenlist)) {
+        if (drivenparams.count(plist[j]) == 0) {
+            pdiagnoseindex[plist[j]] = pdiagnoselist.size();
             pdiagnoselist.push_back(plist[j]);
         }
     }
@@ -4822,8 +4987,12 @@ void System::makeReducedJacobian(Eigen::MatrixXd& J,
         ++allcount;
         if (constr->getTag() >= 0 && constr->isDriving()) {
             jacobianconstraintcount++;
-            for (int j = 0; j < int(pdiagnoselist.size()); j++) {
-                J(jacobianconstraintcount - 1, j) = constr->grad(pdiagnoselist[j]);
+            // the gradient is zero for the parameters the constraint does not depend on
+            for (const auto& param : constr->params()) {
+                auto it = pdiagnoseindex.find(param);
+                if (it != pdiagnoseindex.end()) {
+                    J(jacobianconstraintcount - 1, it->second) = constr->grad(param);
+                }
             }
 
             // parallel processing: create tag multiplicity map
@@ -4856,6 +5025,7 @@ int System::diagnose(Algorithm alg)
     //         two high priority constraints. For this reason, tagging
     //         constraints with 0 should be used carefully.
     hasDiagnosis = false;
+    diagnosisReused = false;
     if (!hasUnknowns) {
         dofs = -1;
         return dofs;
@@ -4977,6 +5147,17 @@ int System::diagnose(Algorithm alg)
     // From here on, presuming `J.rows() > 0`.
     emptyDiagnoseMatrix = false;
 
+    std::vector<int> keyStructure;
+    VEC_D keyValues;
+    if (cacheDiagnosis) {
+        makeDiagnosisKey(alg, pdiagnoselist, keyStructure, keyValues);
+        if (diagnosisCache.valid && diagnosisCache.structure == keyStructure
+            && diagnosisCache.values == keyValues) {
+            restoreDiagnosis();
+            return dofs;
+        }
+    }
+
     if (qrAlgorithm == EigenDenseQR) {
 #ifdef PROFILE_DIAGNOSE
         Base::TimeElapsed DenseQR_start_time;
@@ -5122,9 +5303,120 @@ int System::diagnose(Algorithm alg)
     }
 #endif
 
+    if (cacheDiagnosis) {
+        storeDiagnosis(std::move(keyStructure), std::move(keyValues));
+    }
+
     return dofs;
 }
 
+void System::makeDiagnosisKey(Algorithm alg,
+                              const GCS::VEC_pD& pdiagnoselist,
+                              std::vector<int>& structure,
+                              VEC_D& values)
+{
+    // The diagnosis is a function of the constraints, of the current values of their parameters
+    // and of the settings of the redundant solve. The constraint errors catch the constraints
+    // whose equation depends on more than their parameters, e.g. the ratio of a proportional
+    // constraint.
+    structure = {static_cast<int>(alg),
+                 static_cast<int>(qrAlgorithm),
+                 static_cast<int>(dogLegGaussStep),
+                 maxIterRedundant,
+                 sketchSizeMultiplierRedundant ? 1 : 0,
+                 sparseJacobianThreshold,
+                 static_cast<int>(plist.size()),
+                 static_cast<int>(pdiagnoselist.size()),
+                 static_cast<int>(clist.size())};
+    values = {convergenceRedundant,
+              qrpivotThreshold,
+              LM_epsRedundant,
+              LM_eps1Redundant,
+              LM_tauRedundant,
+              DL_tolgRedundant,
+              DL_tolxRedundant,
+              DL_tolfRedundant};
+
+    for (const auto& param : pdiagnoselist) {
+        structure.push_back(pIndex.at(param));
+    }
+
+    for (const auto& constr : clist) {
+        VEC_pD params = constr->params();
+        structure.push_back(static_cast<int>(constr->getTypeId()));
+        structure.push_back(constr->getTag());
+        structure.push_back(constr->isDriving() ? 1 : 0);
+        structure.push_back(static_cast<int>(constr->isInternalAlignment()));
+        structure.push_back(static_cast<int>(params.size()));
+        for (const auto& param : params) {
+            auto it = pIndex.find(param);
+            structure.push_back(it != pIndex.end() ? it->second : -1);
+            values.push_back(*param);
+        }
+        values.push_back(constr->error());
+    }
+}
+
+void System::storeDiagnosis(std::vector<int>&& structure, VEC_D&& values)
+{
+    std::map<Constraint*, int> constrIndex;
+    for (int i = 0; i < int(clist.size()); i++) {
+        constrIndex[clist[i]] = i;
+    }
+
+    diagnosisCache.valid = true;
+    diagnosisCache.structure = std::move(structure);
+    diagnosisCache.values = std::move(values);
+    diagnosisCache.dofs = dofs;
+    diagnosisCache.conflictingTags = conflictingTags;
+    diagnosisCache.redundantTags = redundantTags;
+    diagnosisCache.partiallyRedundantTags = partiallyRedundantTags;
+
+    diagnosisCache.redundant.clear();
+    for (const auto& constr : redundant) {
+        diagnosisCache.redundant.push_back(constrIndex.at(constr));
+    }
+
+    diagnosisCache.dependentParameters.clear();
+    for (const auto& param : pDependentParameters) {
+        diagnosisCache.dependentParameters.push_back(pIndex.at(param));
+    }
+
+    diagnosisCache.dependentParametersGroups.clear();
+    for (const auto& group : pDependentParametersGroups) {
+        VEC_I& indices = diagnosisCache.dependentParametersGroups.emplace_back();
+        for (const auto& param : group) {
+            indices.push_back(pIndex.at(param));
+        }
+    }
+}
+
+void System::restoreDiagnosis()
+{
+    diagnosisReused = true;
+    dofs = diagnosisCache.dofs;
+    conflictingTags = diagnosisCache.conflictingTags;
+    redundantTags = diagnosisCache.redundantTags;
+    partiallyRedundantTags = diagnosisCache.partiallyRedundantTags;
+
+    for (int index : diagnosisCache.redundant) {
+        redundant.insert(clist[index]);
+    }
+
+    pDependentParameters.clear();
+    for (int index : diagnosisCache.dependentParameters) {
+        pDependentParameters.push_back(plist[index]);
+    }
+
+    pDependentParametersGroups.clear();
+    for (const auto& group : diagnosisCache.dependentParametersGroups) {
+        VEC_pD& params = pDependentParametersGroups.emplace_back();
+        for (int index : group) {
+            params.push_back(plist[index]);
+        }
+    }
+}
+
 void System::makeDenseQRDecomposition(const Eigen::MatrixXd& J,
                                       const std::map<int, int>& jacobianconstraintmap,
                                       Eigen::FullPivHouseholderQR<Eigen::MatrixXd>& qrJT,
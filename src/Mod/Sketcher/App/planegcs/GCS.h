@@ -23,6 +23,8 @@
 #ifndef PLANEGCS_GCS_H
 #define PLANEGCS_GCS_H
 
+#include <atomic>
+
 #include <Eigen/QR>
 
 #include "../../SketcherGlobal.h"
@@ -143,6 +145,43 @@ private:
 
     bool emptyDiagnoseMatrix;  // false only if there is at least one driving constraint.
 
+    // The result of the last diagnosis expressed with indices into plist and clist. It survives
+    // clear(), so that setting up the same system again, e.g. on a recompute of a sketch that
+    // did not change, does not repeat the QR decompositions.
+    //
+    // The result is only reused for identical parameter values. The rank of the Jacobian, and
+    // with it the redundant and conflicting constraints and the DoFs, depends on the values and
+    // not only on its sparsity pattern: two point on line constraints of the same point are
+    // independent while the lines cross and redundant once the lines coincide. A key made of the
+    // constraints and the sparsity pattern would return a stale diagnosis whenever a sketch is
+    // moved into or out of such a configuration. The steps of a drag do not diagnose at all;
+    // initMove() diagnoses once, but with temporary constraints that are never cached.
+    struct DiagnosisCache
+    {
+        bool valid = false;
+        std::vector<int> structure;  // algorithms, constraint types, tags and parameter indices
+        VEC_D values;                // parameter values, constraint errors and tolerances
+        int dofs = 0;
+        VEC_I conflictingTags, redundantTags, partiallyRedundantTags;
+        VEC_I redundant;
+        VEC_I dependentParameters;
+        std::vector<VEC_I> dependentParametersGroups;
+    };
+    DiagnosisCache diagnosisCache;
+    bool diagnosisReused;  // if the last diagnosis was taken from diagnosisCache
+
+    // statistics for benchmarks. The clusters may be solved concurrently, so the iterations are
+    // counted atomically.
+    std::atomic<int> iterationCount;
+    double diagnoseTime;  // seconds
+
+    void makeDiagnosisKey(Algorithm alg,
+                          const GCS::VEC_pD& pdiagnoselist,
+                          std::vector<int>& structure,
+                          VEC_D& values);
+    void storeDiagnosis(std::vector<int>&& structure, VEC_D&& values);
+    void restoreDiagnosis();
+
     int solve_BFGS(SubSystem* subsys, bool isFine = true, bool isRedundantsolving = false);
     int solve_LM(SubSystem* subsys, bool isRedundantsolving = false);
     int solve_DL(SubSystem* subsys, bool isRedundantsolving = false);
@@ -224,6 +263,14 @@ public:
     double convergenceRedundant;
     QRAlgorithm qrAlgorithm;
     DogLegGaussStep dogLegGaussStep;
+    // minimum number of unknowns of a subsystem from which LM and DogLeg work with a sparse
+    // Jacobian, below it the dense algorithms are used
+    int sparseJacobianThreshold;
+    // solve the independent clusters of the system concurrently
+    bool solveClustersConcurrently;
+    // reuse the previous diagnosis if the system is set up again with the same constraints,
+    // parameters and values
+    bool cacheDiagnosis;
     double qrpivotThreshold;
     DebugMode debugMode;
     double LM_eps;
@@ -615,6 +662,22 @@ public:
 
     void invalidatedDiagnosis();
 
+    /// number of iterations of all solver runs since the last call of resetIterationCount(),
+    /// every solver counts each pass of its loop including the one that detects convergence
+    int getIterationCount() const
+    {
+        return iterationCount;
+    }
+    void resetIterationCount()
+    {
+        iterationCount = 0;
+    }
+    /// time in seconds of the last diagnosis done by initSolution()
+    double getDiagnoseTime() const
+    {
+        return diagnoseTime;
+    }
+
     // Unit testing interface - not intended for use by production code
 protected:
     size_t _getNumberOfConstraints(int tagID = -1)
@@ -626,6 +689,10 @@ protected:
             return constraint->getTag() == tagID;
         });
     }
+    bool _isDiagnosisReused() const
+    {
+        return diagnosisReused;
+    }
 };
 
 
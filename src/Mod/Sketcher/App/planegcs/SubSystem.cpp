@@ -118,10 +118,28 @@ void SubSystem::initialize(VEC_pD& params, MAP_pD_pD& reductionmap)
 
     c2p.clear();
     p2c.clear();
+    c2col.clear();
+    c2col.reserve(csize);
+    batch.clear();
+    unbatched.clear();
     for (std::vector<Constraint*>::iterator constr = clist.begin(); constr != clist.end();
          ++constr) {
         (*constr)->revertParams();  // ensure that the constraint points to the original parameters
         VEC_pD constr_params_orig = (*constr)->params();
+        int row = static_cast<int>(constr - clist.begin());
+        if (ConstraintBatch::isBatched(*constr)) {
+            std::vector<int> columns;
+            for (const auto& param : constr_params_orig) {
+                MAP_pD_pD::const_iterator pmapfind = pmap.find(param);
+                columns.push_back(pmapfind != pmap.end()
+                                      ? static_cast<int>(pmapfind->second - pvals.data())
+                                      : -1);
+            }
+            batch.add(row, *constr, columns);
+        }
+        else {
+            unbatched.push_back(row);
+        }
         SET_pD constr_params;
         for (VEC_pD::const_iterator p = constr_params_orig.begin(); p != constr_params_orig.end();
              ++p) {
@@ -130,10 +148,12 @@ void SubSystem::initialize(VEC_pD& params, MAP_pD_pD& reductionmap)
                 constr_params.insert(pmapfind->second);
             }
         }
+        c2col.emplace_back();
         for (SET_pD::const_iterator p = constr_params.begin(); p != constr_params.end(); ++p) {
             //            jacobi.set(*constr, *p, 0.);
             c2p[*constr].push_back(*p);
             p2c[*p].push_back(*constr);
+            c2col.back().push_back(static_cast<int>(*p - pvals.data()));
         }
         //        (*constr)->redirectParams(pmap); // redirect parameters to pvec
     }
@@ -152,6 +172,9 @@ void SubSystem::redirectParams()
         (*constr)->revertParams();  // this line will normally not be necessary
         (*constr)->redirectParams(pmap);
     }
+
+    // the fixed parameters and the scales may have changed since the last solve
+    batch.update();
 }
 
 void SubSystem::revertParams()
@@ -223,13 +246,9 @@ void SubSystem::getConstraintList(std::vector<Constraint*>& clist_)
 
 double SubSystem::error()
 {
-    double err = 0.;
-    for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
-         ++constr) {
-        double tmp = (*constr)->error();
-        err += tmp * tmp;
-    }
-    err *= 0.5;
+    Eigen::VectorXd r(csize);
+    double err;
+    calcResidual(r, err);
     return err;
 }
 
@@ -237,25 +256,16 @@ void SubSystem::calcResidual(Eigen::VectorXd& r)
 {
     assert(r.size() == csize);
 
-    int i = 0;
-    for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
-         ++constr, i++) {
-        r[i] = (*constr)->error();
+    batch.calcResidual(pvals.data(), r.data());
+    for (int i : unbatched) {
+        r[i] = clist[i]->error();
     }
 }
 
 void SubSystem::calcResidual(Eigen::VectorXd& r, double& err)
 {
-    assert(r.size() == csize);
-
-    int i = 0;
-    err = 0.;
-    for (std::vector<Constraint*>::const_iterator constr = clist.begin(); constr != clist.end();
-         ++constr, i++) {
-        r[i] = (*constr)->error();
-        err += r[i] * r[i];
-    }
-    err *= 0.5;
+    calcResidual(r);
+    err = 0.5 * r.squaredNorm();
 }
 
 void SubSystem::calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi)
@@ -273,7 +283,32 @@ void SubSystem::calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi)
 
 void SubSystem::calcJacobi(Eigen::MatrixXd& jacobi)
 {
-    calcJacobi(plist, jacobi);
+    jacobi.setZero(csize, psize);
+    // a parameter may appear in several slots of a constraint, so the derivatives are summed
+    batch.forEachDerivative(pvals.data(), [&jacobi](int i, int j, double, double deriv) {
+        jacobi(i, j) += deriv;
+    });
+    for (int i : unbatched) {
+        for (int j : c2col[i]) {
+            jacobi(i, j) = clist[i]->grad(&pvals[j]);
+        }
+    }
+}
+
+void SubSystem::calcJacobi(Eigen::SparseMatrix<double>& jacobi)
+{
+    // setFromTriplets() sums the duplicated entries
+    std::vector<Eigen::Triplet<double>> entries;
+    batch.forEachDerivative(pvals.data(), [&entries](int i, int j, double, double deriv) {
+        entries.emplace_back(i, j, deriv);
+    });
+    for (int i : unbatched) {
+        for (int j : c2col[i]) {
+            entries.emplace_back(i, j, clist[i]->grad(&pvals[j]));
+        }
+    }
+    jacobi.resize(csize, psize);
+    jacobi.setFromTriplets(entries.begin(), entries.end());
 }
 
 void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
@@ -296,7 +331,22 @@ void SubSystem::calcGrad(VEC_pD& params, Eigen::VectorXd& grad)
 
 void SubSystem::calcGrad(Eigen::VectorXd& grad)
 {
-    calcGrad(plist, grad);
+    assert(grad.size() == psize);
+
+    // evaluate the error of each constraint only once
+    grad.setZero();
+    batch.forEachDerivative(pvals.data(), [&grad](int, int j, double err, double deriv) {
+        grad[j] += err * deriv;
+    });
+    for (int i : unbatched) {
+        if (c2col[i].empty()) {
+            continue;
+        }
+        double err = clist[i]->error();
+        for (int j : c2col[i]) {
+            grad[j] += err * clist[i]->grad(&pvals[j]);
+        }
+    }
 }
 
 double SubSystem::maxStep(VEC_pD& params, Eigen::VectorXd& xdir)
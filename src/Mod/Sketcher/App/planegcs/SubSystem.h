@@ -27,7 +27,9 @@
 #undef max
 
 #include <Eigen/Core>
+#include <Eigen/SparseCore>
 
+#include "ConstraintBatch.h"
 #include "Constraints.h"
 
 
@@ -45,6 +47,9 @@ private:
                      //        JacobianMatrix jacobi;  // jacobi matrix of the residuals
     std::map<Constraint*, VEC_pD> c2p;                // constraint to parameter adjacency list
     std::map<double*, std::vector<Constraint*>> p2c;  // parameter to constraint adjacency list
+    std::vector<std::vector<int>> c2col;  // constraint index to the indices of its parameters
+    ConstraintBatch batch;                // the constraints of the types evaluated in batches
+    std::vector<int> unbatched;           // indices of the other constraints
     void initialize(VEC_pD& params, MAP_pD_pD& reductionmap);  // called by the constructors
 public:
     SubSystem(std::vector<Constraint*>& clist_, VEC_pD& params);
@@ -78,6 +83,8 @@ public:
     void calcResidual(Eigen::VectorXd& r, double& err);
     void calcJacobi(VEC_pD& params, Eigen::MatrixXd& jacobi);
     void calcJacobi(Eigen::MatrixXd& jacobi);
+    // Each constraint depends on a few parameters only, this only stores the non-zero entries
+    void calcJacobi(Eigen::SparseMatrix<double>& jacobi);
     void calcGrad(VEC_pD& params, Eigen::VectorXd& grad);
     void calcGrad(Eigen::VectorXd& grad);
 
@@ -26,6 +26,7 @@
 #include <QRegularExpression>
 #include <limits>
 #include <memory>
+#include <set>
 
 #include <Inventor/SbImage.h>
 #include <Inventor/SbVec3f.h>
@@ -41,6 +42,9 @@
 #include <Inventor/nodes/SoSeparator.h>
 #include <Inventor/nodes/SoTranslation.h>
 
+#include <boost/geometry.hpp>
+#include <boost/geometry/index/rtree.hpp>
+
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Tools.h>
@@ -69,6 +73,9 @@ using namespace Gui;
 using namespace SketcherGui;
 using namespace Sketcher;
 
+namespace bg = boost::geometry;
+namespace bgi = boost::geometry::index;
+
 //**************************** EditModeConstraintCoinManager class ******************************
 
 EditModeConstraintCoinManager::EditModeConstraintCoinManager(
@@ -2486,56 +2493,82 @@ void EditModeConstraintCoinManager::combineConstraintIcons(IconQueue iconQueue)
     // There's room for optimisation here; we could reuse the combined icons...
     combinedConstrBoxes.clear();
 
-    while (!iconQueue.empty()) {
+    auto isClose = [maxDistSquared](const constrIconQueueItem& a, const constrIconQueueItem& b) {
+        float distSquared =
+            pow(a.position[0] - b.position[0], 2) + pow(a.position[1] - b.position[1], 2);
+        return distSquared <= maxDistSquared;
+    };
+
+    // we group only icons not being Symmetry icons, because we want those on the line
+    // and only icons that are visible
+    auto isGroupable = [](const constrIconQueueItem& item) {
+        return item.visible && item.type != QStringLiteral("Constraint_Symmetric");
+    };
+
+    // Spatial index of the icons that can still be added to a group, so that looking for the
+    // icons close to a group does not compare all pairs of icons
+    using IconPoint = bg::model::point<float, 2, bg::cs::cartesian>;
+    using IconValue = std::pair<IconPoint, std::size_t>;
+    bgi::rtree<IconValue, bgi::quadratic<16>> index;
+    auto indexValue = [&iconQueue](std::size_t i) {
+        return IconValue(IconPoint(iconQueue[i].position[0], iconQueue[i].position[1]), i);
+    };
+    std::vector<IconValue> values;
+    for (std::size_t i = 0; i < iconQueue.size(); ++i) {
+        if (isGroupable(iconQueue[i])) {
+            values.push_back(indexValue(i));
+        }
+    }
+    index.insert(values.begin(), values.end());
+
+    // a slightly larger box than the distance, the exact test is done by isClose
+    float searchDist = std::sqrt(maxDistSquared) * 1.001f + 1e-6f;
+    auto addNeighbours = [&](std::size_t i, std::set<std::size_t>& candidates) {
+        const SbVec3f& pos = iconQueue[i].position;
+        bg::model::box<IconPoint> box(IconPoint(pos[0] - searchDist, pos[1] - searchDist),
+                                      IconPoint(pos[0] + searchDist, pos[1] + searchDist));
+        std::vector<IconValue> found;
+        index.query(bgi::intersects(box), std::back_inserter(found));
+        for (const auto& value : found) {
+            if (isClose(iconQueue[value.second], iconQueue[i])) {
+                candidates.insert(value.second);
+            }
+        }
+    };
+
+    // the icons of the queue that are not in a group yet, in queue order
+    std::set<std::size_t> remaining;
+    for (std::size_t i = 0; i < iconQueue.size(); ++i) {
+        remaining.insert(remaining.end(), i);
+    }
+
+    while (!remaining.empty()) {
         // A group starts with an item popped off the back of our initial queue
+        std::size_t init = *remaining.rbegin();
+        remaining.erase(init);
         IconQueue thisGroup;
-        thisGroup.push_back(iconQueue.back());
-        constrIconQueueItem init = iconQueue.back();
-        iconQueue.pop_back();
-
-        // we group only icons not being Symmetry icons, because we want those on the line
-        // and only icons that are visible
-        if (init.type != QStringLiteral("Constraint_Symmetric") && init.visible) {
-
-            IconQueue::iterator i = iconQueue.begin();
-
-
-            while (i != iconQueue.end()) {
-                if ((*i).visible) {
-                    bool addedToGroup = false;
-
-                    for (IconQueue::iterator j = thisGroup.begin(); j != thisGroup.end(); ++j) {
-                        float distSquared = pow(i->position[0] - j->position[0], 2)
-                            + pow(i->position[1] - j->position[1], 2);
-                        if (distSquared <= maxDistSquared
-                            && (*i).type != QStringLiteral("Constraint_Symmetric")) {
-                            // Found an icon in iconQueue that's close enough to
-                            // a member of thisGroup, so move it into thisGroup
-                            thisGroup.push_back(*i);
-                            i = iconQueue.erase(i);
-                            addedToGroup = true;
-                            break;
-                        }
-                    }
-
-                    if (addedToGroup) {
-                        if (i == iconQueue.end()) {
-                            // We just got the last icon out of iconQueue
-                            break;
-                        }
-                        else {
-                            // Start looking through the iconQueue again, in case
-                            // we have an icon that's now close enough to thisGroup
-                            i = iconQueue.begin();
-                        }
-                    }
-                    else {
-                        ++i;
-                    }
-                }
-                else {  // if !visible we skip it
-                    i++;
+        thisGroup.push_back(iconQueue[init]);
+
+        if (isGroupable(iconQueue[init])) {
+            index.remove(indexValue(init));
+
+            // Repeatedly move the first icon of the queue that's close enough to a member of
+            // thisGroup into thisGroup. If that icon was the last one of the queue, the group
+            // is complete.
+            std::set<std::size_t> candidates;
+            addNeighbours(init, candidates);
+            while (!candidates.empty()) {
+                std::size_t next = *candidates.begin();
+                candidates.erase(candidates.begin());
+                bool last = next == *remaining.rbegin();
+
+                remaining.erase(next);
+                index.remove(indexValue(next));
+                thisGroup.push_back(iconQueue[next]);
+                if (last) {
+                    break;
                 }
+                addNeighbours(next, candidates);
             }
         }
 
@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include <App/Application.h>
@@ -239,6 +241,129 @@ TEST_F(ElementMapTest, eraseIndexedName)
     EXPECT_EQ(findAllAfterRepeat.size(), 0);
 }
 
+TEST_F(ElementMapTest, eraseAndFindManyNames)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    const int count = 1000;
+    for (int i = 1; i <= count; ++i) {
+        Data::IndexedName element("Edge", i);
+        elementMap.setElementName(element, Data::MappedName("E" + std::to_string(i)), 0);
+    }
+
+    // Act
+    for (int i = 1; i <= count; i += 2) {
+        elementMap.erase(Data::MappedName("E" + std::to_string(i)));
+    }
+
+    // Assert
+    EXPECT_EQ(elementMap.size(), count / 2);
+    for (int i = 1; i <= count; ++i) {
+        auto found = elementMap.find(Data::MappedName("E" + std::to_string(i)));
+        if (i % 2 != 0) {
+            EXPECT_FALSE(found) << i;
+        }
+        else {
+            EXPECT_EQ(found, Data::IndexedName("Edge", i));
+        }
+    }
+    auto all = elementMap.getAll();
+    ASSERT_EQ(all.size(), count / 2);
+    EXPECT_TRUE(std::is_sorted(all.begin(), all.end(), [](const auto& a, const auto& b) {
+        return a.name < b.name;
+    }));
+}
+
+TEST_F(ElementMapTest, getAllAfterChange)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    elementMap.setElementName(Data::IndexedName("Edge", 1), Data::MappedName("B"), 0);
+    elementMap.setElementName(Data::IndexedName("Edge", 2), Data::MappedName("C"), 0);
+    auto before = elementMap.getAll();
+
+    // Act
+    elementMap.setElementName(Data::IndexedName("Edge", 3), Data::MappedName("A"), 0);
+    auto afterInsert = elementMap.getAll();
+    elementMap.erase(Data::MappedName("B"));
+    auto afterErase = elementMap.getAll();
+
+    // Assert
+    ASSERT_EQ(before.size(), 2);
+    EXPECT_EQ(before[0].name, Data::MappedName("B"));
+    ASSERT_EQ(afterInsert.size(), 3);
+    EXPECT_EQ(afterInsert[0].name, Data::MappedName("A"));
+    EXPECT_EQ(afterInsert[0].index, Data::IndexedName("Edge", 3));
+    EXPECT_EQ(afterInsert[1].name, Data::MappedName("B"));
+    ASSERT_EQ(afterErase.size(), 2);
+    EXPECT_EQ(afterErase[0].name, Data::MappedName("A"));
+    EXPECT_EQ(afterErase[1].name, Data::MappedName("C"));
+}
+
+TEST_F(ElementMapTest, reserveKeepsNames)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    elementMap.setElementName(Data::IndexedName("Edge", 1), Data::MappedName("A"), 0);
+
+    // Act
+    elementMap.reserve(100);
+    for (int i = 2; i <= 100; ++i) {
+        elementMap.setElementName(Data::IndexedName("Edge", i),
+                                  Data::MappedName("A" + std::to_string(i)),
+                                  0);
+    }
+
+    // Assert
+    EXPECT_EQ(elementMap.size(), 100);
+    EXPECT_EQ(elementMap.find(Data::MappedName("A")), Data::IndexedName("Edge", 1));
+    for (int i = 2; i <= 100; ++i) {
+        EXPECT_EQ(elementMap.find(Data::MappedName("A" + std::to_string(i))),
+                  Data::IndexedName("Edge", i));
+    }
+}
+
+TEST_F(ElementMapTest, copyIsIndependent)
+{
+    // Arrange
+    LessComplexPart cube(1L, "Box", _hasher);
+    Data::ElementMap::MappedChildElements child =
+        {Data::IndexedName("Pong", 2), 2, 7, 4L, Data::ElementMapPtr(), QByteArray("abc"), _sid};
+    cube.elementMapPtr->addChildElements(cube.Tag, {child});
+    Data::IndexedName face1("Face", 1);
+    Data::IndexedName face2("Face", 2);
+    auto original = cube.elementMapPtr->getAll();
+
+    // Act
+    auto copy = cube.elementMapPtr->copy();
+    copy->setElementName(face1, Data::MappedName("Copied"), cube.Tag, nullptr, true);
+
+    // Assert
+    EXPECT_EQ(copy->size(), original.size());
+    EXPECT_EQ(copy->getChildElements().size(), 1);
+    EXPECT_EQ(copy->find(Data::MappedName("Copied")), face1);
+    EXPECT_EQ(copy->find(Data::MappedName(face2)), face2);
+    EXPECT_FALSE(cube.elementMapPtr->find(Data::MappedName("Copied")));
+    EXPECT_EQ(cube.elementMapPtr->find(Data::MappedName(face1)), face1);
+    EXPECT_EQ(cube.elementMapPtr->getAll().size(), original.size());
+}
+
+TEST_F(ElementMapTest, findMappedNameWithDifferentPostfixSplit)
+{
+    // Arrange
+    Data::ElementMap elementMap;
+    Data::IndexedName element("Edge", 1);
+    Data::MappedName mappedName("Edge1");
+    mappedName += ";:H1,E";
+    elementMap.setElementName(element, mappedName, 0);
+
+    // Act
+    auto found = elementMap.find(Data::MappedName("Edge1;:H1,E"));
+
+    // Assert
+    EXPECT_EQ(found, element);
+}
+
 TEST_F(ElementMapTest, findMappedName)
 {
     // Arrange
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <BRep_Builder.hxx>
+#include <TopoDS_Compound.hxx>
+#include <gp_Pnt.hxx>
+
+#include <Mod/Mesh/App/Core/Grid.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/MeshPart/App/CurveProjector.h>
+
+#include <src/App/InitApplication.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class CurveProjectorTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        // a planar mesh in z=0 covering [0,10]x[0,10] with two triangles per unit square
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        for (int i = 0; i < 10; i++) {
+            for (int j = 0; j < 10; j++) {
+                Base::Vector3f p1(float(i), float(j), 0.0F);
+                Base::Vector3f p2(float(i + 1), float(j), 0.0F);
+                Base::Vector3f p3(float(i + 1), float(j + 1), 0.0F);
+                Base::Vector3f p4(float(i), float(j + 1), 0.0F);
+                facets.emplace_back(p1, p2, p3);
+                facets.emplace_back(p1, p3, p4);
+            }
+        }
+        _kernel = facets;
+    }
+
+    static TopoDS_Edge makeLine(double height)
+    {
+        return BRepBuilderAPI_MakeEdge(gp_Pnt(0.3, 5.25, height), gp_Pnt(9.3, 5.25, height));
+    }
+
+    const MeshCore::MeshKernel& kernel() const
+    {
+        return _kernel;
+    }
+
+private:
+    MeshCore::MeshKernel _kernel;
+};
+
+TEST_F(CurveProjectorTest, projectToMesh)
+{
+    // Arrange
+    TopoDS_Edge edge = makeLine(0.1);
+    MeshPart::MeshProjection projection(kernel());
+    std::vector<MeshPart::MeshProjection::PolyLine> polylines;
+
+    // Act
+    projection.projectToMesh(edge, 0.5F, polylines);
+
+    // Assert
+    ASSERT_EQ(polylines.size(), 1);
+    const auto& points = polylines.front().points;
+    // the line crosses the edges along y and the diagonals of the cells it passes over
+    EXPECT_GE(points.size(), 18);
+    for (const auto& pnt : points) {
+        EXPECT_FLOAT_EQ(pnt.z, 0.0F);
+        EXPECT_NEAR(pnt.y, 5.25F, 1e-5F);
+        EXPECT_GE(pnt.x, 0.0F);
+        EXPECT_LE(pnt.x, 10.0F);
+    }
+}
+
+TEST_F(CurveProjectorTest, projectParallelToMesh)
+{
+    // Arrange
+    TopoDS_Edge edge = makeLine(2.0);
+    MeshPart::MeshProjection projection(kernel());
+    std::vector<MeshPart::MeshProjection::PolyLine> polylines;
+
+    // Act
+    projection.projectParallelToMesh(edge, Base::Vector3f(0.0F, 0.0F, -1.0F), polylines);
+
+    // Assert
+    ASSERT_EQ(polylines.size(), 1);
+    const auto& points = polylines.front().points;
+    ASSERT_GE(points.size(), 2);
+    for (const auto& pnt : points) {
+        EXPECT_NEAR(pnt.z, 0.0F, 1e-5F);
+        EXPECT_NEAR(pnt.y, 5.25F, 1e-5F);
+        EXPECT_GE(pnt.x, 0.3F - 1e-4F);
+        EXPECT_LE(pnt.x, 9.3F + 1e-4F);
+    }
+    EXPECT_NEAR(points.front().x, 0.3F, 1e-4F);
+    EXPECT_NEAR(points.back().x, 9.3F, 1e-4F);
+}
+
+TEST_F(CurveProjectorTest, findStartPointWithGrid)
+{
+    // Arrange
+    TopoDS_Compound comp;
+    BRep_Builder builder;
+    builder.MakeCompound(comp);
+    MeshPart::CurveProjectorShape projector(comp, kernel());
+    MeshCore::MeshFacetGrid grid(kernel(), 2.0F);
+    std::vector<Base::Vector3f> points = {Base::Vector3f(0.1F, 0.2F, 1.0F),
+                                          Base::Vector3f(5.3F, 4.6F, -0.5F),
+                                          Base::Vector3f(9.9F, 9.8F, 3.0F)};
+
+    for (const auto& pnt : points) {
+        Base::Vector3f linear;
+        Base::Vector3f gridded;
+        MeshCore::FacetIndex linearIndex {};
+        MeshCore::FacetIndex griddedIndex {};
+
+        // Act
+        bool foundLinear = projector.findStartPoint(kernel(), pnt, linear, linearIndex);
+        bool foundGridded = projector.findStartPoint(kernel(), grid, pnt, gridded, griddedIndex);
+
+        // Assert
+        ASSERT_TRUE(foundLinear);
+        ASSERT_TRUE(foundGridded);
+        EXPECT_FLOAT_EQ(gridded.x, pnt.x);
+        EXPECT_FLOAT_EQ(gridded.y, pnt.y);
+        EXPECT_FLOAT_EQ(gridded.z, 0.0F);
+        EXPECT_EQ(griddedIndex, linearIndex);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <BRep_Builder.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <BRepTools.hxx>
+#include <Precision.hxx>
+#include <TopoDS_Compound.hxx>
+#include <gp_Ax1.hxx>
+#include <gp_Trsf.hxx>
+
+#include <Base/Interpreter.h>
+#include <Mod/Mesh/App/Mesh.h>
+#include <Mod/MeshPart/App/Mesher.h>
+#include <Mod/Part/App/TopoShape.h>
+#include <Mod/Part/App/TopoShapePy.h>
+
+#include <src/App/InitApplication.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class MesherTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    static std::unique_ptr<Mesh::MeshObject>
+    createMesh(const TopoDS_Shape& shape, double deflection, bool reuse = false)
+    {
+        MeshPart::Mesher mesher(shape);
+        mesher.setMethod(MeshPart::Mesher::Standard);
+        mesher.setDeflection(deflection);
+        mesher.setAngularDeflection(0.5);
+        mesher.setReuseTriangulation(reuse);
+        return std::unique_ptr<Mesh::MeshObject>(mesher.createMesh());
+    }
+
+    static TopoDS_Shape makeLocatedBox()
+    {
+        gp_Trsf rotation;
+        rotation.SetRotation(gp_Ax1(gp_Pnt(1.0, 2.0, 3.0), gp_Dir(1.0, 1.0, 1.0)), 0.3);
+        gp_Trsf translation;
+        translation.SetTranslation(gp_Vec(5.0, -7.0, 11.0));
+        TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+        return box.Located(TopLoc_Location(translation * rotation));
+    }
+};
+
+TEST_F(MesherTest, locatedShapeIsClosed)
+{
+    // Act
+    auto mesh = createMesh(makeLocatedBox(), 0.1);
+
+    // Assert
+    EXPECT_EQ(mesh->countPoints(), 8);
+    EXPECT_EQ(mesh->countFacets(), 12);
+    EXPECT_TRUE(mesh->isSolid());
+    EXPECT_FALSE(mesh->hasNonManifolds());
+}
+
+TEST_F(MesherTest, compoundIsClosed)
+{
+    // Arrange
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(20.0, 0.0, 0.0));
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(10.0, 10.0, 10.0).Shape();
+
+    TopoDS_Compound comp;
+    BRep_Builder builder;
+    builder.MakeCompound(comp);
+    builder.Add(comp, box);
+    builder.Add(comp, box.Located(TopLoc_Location(trsf)));
+    builder.Add(comp, makeLocatedBox());
+
+    // Act
+    auto mesh = createMesh(comp, 0.1);
+
+    // Assert
+    EXPECT_EQ(mesh->countPoints(), 24);
+    EXPECT_EQ(mesh->countFacets(), 36);
+    EXPECT_EQ(mesh->countComponents(), 3);
+    EXPECT_TRUE(mesh->isSolid());
+    EXPECT_FALSE(mesh->hasNonManifolds());
+}
+
+TEST_F(MesherTest, weldPointsAcrossCellBoundary)
+{
+    // Arrange
+    // The welding sorts the points into a grid with the tolerance as spacing. Let the
+    // touching faces of the two boxes lie just on either side of a grid plane.
+    const double tolerance = Precision::Confusion();
+    const double boundary = 100.0 * tolerance;
+    TopoDS_Shape box1 =
+        BRepPrimAPI_MakeBox(gp_Pnt(-1.0, 0.0, 0.0), gp_Pnt(boundary - 0.3 * tolerance, 1.0, 1.0))
+            .Shape();
+    TopoDS_Shape box2 =
+        BRepPrimAPI_MakeBox(gp_Pnt(boundary + 0.3 * tolerance, 0.0, 0.0), gp_Pnt(1.0, 1.0, 1.0))
+            .Shape();
+
+    TopoDS_Compound comp;
+    BRep_Builder builder;
+    builder.MakeCompound(comp);
+    builder.Add(comp, box1);
+    builder.Add(comp, box2);
+
+    // Act
+    auto mesh = createMesh(comp, 0.1);
+
+    // Assert
+    EXPECT_EQ(mesh->countPoints(), 12);
+    EXPECT_EQ(mesh->countFacets(), 24);
+}
+
+TEST_F(MesherTest, reuseTriangulation)
+{
+    // Arrange
+    TopoDS_Shape sphere = BRepPrimAPI_MakeSphere(10.0).Shape();
+    auto coarse = createMesh(sphere, 1.0);
+    BRepTools::Clean(sphere);
+    BRepMesh_IncrementalMesh(sphere, 0.05);
+
+    // Act
+    auto reused = createMesh(sphere, 1.0, true);
+    auto remeshed = createMesh(sphere, 1.0, false);
+
+    // Assert
+    EXPECT_GT(reused->countPoints(), coarse->countPoints());
+    EXPECT_EQ(remeshed->countPoints(), coarse->countPoints());
+    EXPECT_TRUE(reused->isSolid());
+}
+
+TEST_F(MesherTest, reuseCoarserTriangulation)
+{
+    // Arrange
+    TopoDS_Shape sphere = BRepPrimAPI_MakeSphere(10.0).Shape();
+    auto fine = createMesh(sphere, 0.05);
+    BRepTools::Clean(sphere);
+    BRepMesh_IncrementalMesh(sphere, 1.0);
+
+    // Act
+    auto reused = createMesh(sphere, 0.05, true);
+
+    // Assert
+    EXPECT_EQ(reused->countPoints(), fine->countPoints());
+}
+
+TEST_F(MesherTest, meshFromShapeReuseTriangulation)
+{
+    // Arrange
+    TopoDS_Shape sphere = BRepPrimAPI_MakeSphere(10.0).Shape();
+    BRepMesh_IncrementalMesh(sphere, 0.05);
+    Base::PyGILStateLocker lock;
+    Py::Module module(PyImport_ImportModule("MeshPart"), true);
+    Py::Callable meshFromShape(module.getAttr("meshFromShape"));
+    Py::Tuple args(1);
+    args.setItem(0, Py::asObject(new Part::TopoShapePy(new Part::TopoShape(sphere))));
+
+    auto countPoints = [&](bool reuse) {
+        Py::Dict kwds;
+        kwds.setItem("LinearDeflection", Py::Float(1.0));
+        kwds.setItem("ReuseTriangulation", Py::Boolean(reuse));
+        Py::Object mesh = meshFromShape.apply(args, kwds);
+        return static_cast<long>(Py::Long(mesh.getAttr("CountPoints")));
+    };
+
+    // Act
+    long reused = countPoints(true);
+    long remeshed = countPoints(false);
+
+    // Assert
+    EXPECT_GT(reused, remeshed);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Part/App/BOPCheck.h>
+#include <Mod/Part/App/TopoShape.h>
+#include "src/App/InitApplication.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include <BOPAlgo_CheckResult.hxx>
+#include <BRep_Builder.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <gp_Pnt.hxx>
+#include <gp_Trsf.hxx>
+#include <gp_Vec.hxx>
+#include <TopExp.hxx>
+#include <TopLoc_Location.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
+
+// NOLINTBEGIN
+class BOPCheckTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    static TopoDS_Shape makeBox(double x, double y, double z)
+    {
+        return BRepPrimAPI_MakeBox(gp_Pnt(x, y, z), 10.0, 10.0, 10.0).Shape();
+    }
+
+    static TopoDS_Compound makeCompound(const std::vector<TopoDS_Shape>& shapes)
+    {
+        BRep_Builder builder;
+        TopoDS_Compound comp;
+        builder.MakeCompound(comp);
+        for (const auto& shape : shapes) {
+            builder.Add(comp, shape);
+        }
+        return comp;
+    }
+};
+
+TEST_F(BOPCheckTest, componentsOfSeparatedShapes)
+{
+    // Arrange
+    auto comp = makeCompound({makeBox(0, 0, 0), makeBox(20, 0, 0), makeBox(40, 0, 0)});
+    // Act
+    Part::BOPCheck check(comp);
+    // Assert
+    EXPECT_EQ(check.components().size(), 3UL);
+}
+
+TEST_F(BOPCheckTest, componentsOfInstances)
+{
+    // Arrange
+    auto box = makeBox(0, 0, 0);
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(20, 0, 0));
+    auto comp = makeCompound({box, box.Moved(TopLoc_Location(trsf))});
+    // Act
+    Part::BOPCheck check(comp);
+    // Assert: the instances are separate components that don't share their TShapes
+    ASSERT_EQ(check.components().size(), 2UL);
+    EXPECT_FALSE(check.components()[0].TShape() == check.components()[1].TShape());
+}
+
+TEST_F(BOPCheckTest, overlappingInstancesInterfere)
+{
+    // Arrange
+    auto box = makeBox(0, 0, 0);
+    gp_Trsf trsf;
+    trsf.SetTranslation(gp_Vec(5, 5, 5));
+    auto comp = makeCompound({box, box.Moved(TopLoc_Location(trsf))});
+    Part::BOPCheck check(comp);
+    // Act
+    check.perform();
+    // Assert
+    ASSERT_EQ(check.components().size(), 2UL);
+    ASSERT_TRUE(check.hasFaulty());
+    TopTools_IndexedMapOfShape subShapes;
+    TopExp::MapShapes(check.shape(), subShapes);
+    TopTools_IndexedMapOfShape firstShapes;
+    TopExp::MapShapes(check.components()[0], firstShapes);
+    for (BOPAlgo_ListIteratorOfListOfCheckResult it(check.results()); it.More(); it.Next()) {
+        EXPECT_EQ(it.Value().GetCheckStatus(), BOPAlgo_SelfIntersect);
+        int inFirst = 0;
+        for (TopTools_ListIteratorOfListOfShape jt(it.Value().GetFaultyShapes1()); jt.More();
+             jt.Next()) {
+            EXPECT_TRUE(subShapes.Contains(jt.Value()));
+            inFirst += firstShapes.Contains(jt.Value()) ? 1 : 0;
+        }
+        // the interference is between the instances
+        EXPECT_EQ(inFirst, 1);
+    }
+}
+
+TEST_F(BOPCheckTest, separatedShapesAreValid)
+{
+    // Arrange
+    auto comp = makeCompound({makeBox(0, 0, 0), makeBox(20, 0, 0), makeBox(40, 0, 0)});
+    Part::BOPCheck check(comp);
+    int blocks = 0;
+    // Act
+    bool done = check.perform([&blocks](const BOPAlgo_ListOfCheckResult&) {
+        ++blocks;
+        return true;
+    });
+    // Assert
+    EXPECT_TRUE(done);
+    EXPECT_GE(blocks, 1);
+    EXPECT_FALSE(check.hasFaulty());
+}
+
+TEST_F(BOPCheckTest, overlappingShapesInterfere)
+{
+    // Arrange
+    auto comp = makeCompound({makeBox(0, 0, 0), makeBox(40, 0, 0), makeBox(5, 5, 5)});
+    Part::BOPCheck check(comp);
+    // Act
+    check.perform();
+    // Assert
+    ASSERT_TRUE(check.hasFaulty());
+    TopTools_IndexedMapOfShape subShapes;
+    TopExp::MapShapes(check.shape(), subShapes);
+    for (BOPAlgo_ListIteratorOfListOfCheckResult it(check.results()); it.More(); it.Next()) {
+        EXPECT_EQ(it.Value().GetCheckStatus(), BOPAlgo_SelfIntersect);
+        for (TopTools_ListIteratorOfListOfShape jt(it.Value().GetFaultyShapes1()); jt.More();
+             jt.Next()) {
+            EXPECT_TRUE(subShapes.Contains(jt.Value()));
+        }
+    }
+}
+
+TEST_F(BOPCheckTest, chainOfOverlappingShapesInterferes)
+{
+    // Arrange
+    // the first box overlaps the second one, the second one the third one
+    auto comp = makeCompound({makeBox(0, 0, 0), makeBox(6, 0, 0), makeBox(12, 0, 0)});
+    Part::BOPCheck check(comp);
+    // Act
+    check.perform();
+    // Assert
+    ASSERT_EQ(check.components().size(), 3UL);
+    ASSERT_TRUE(check.hasFaulty());
+    std::vector<TopTools_IndexedMapOfShape> subShapes(check.components().size());
+    for (std::size_t i = 0; i < subShapes.size(); ++i) {
+        TopExp::MapShapes(check.components()[i], subShapes[i]);
+    }
+    auto owner = [&subShapes](const TopoDS_Shape& shape) {
+        for (std::size_t i = 0; i < subShapes.size(); ++i) {
+            if (subShapes[i].Contains(shape)) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    };
+    bool firstAndSecond = false;
+    bool secondAndThird = false;
+    for (BOPAlgo_ListIteratorOfListOfCheckResult it(check.results()); it.More(); it.Next()) {
+        const TopTools_ListOfShape& faultyShapes = it.Value().GetFaultyShapes1();
+        ASSERT_EQ(faultyShapes.Extent(), 2);
+        int owner1 = std::min(owner(faultyShapes.First()), owner(faultyShapes.Last()));
+        int owner2 = std::max(owner(faultyShapes.First()), owner(faultyShapes.Last()));
+        // the interferences inside of a box aren't reported and the outer boxes are apart
+        EXPECT_NE(owner1, owner2);
+        EXPECT_FALSE(owner1 == 0 && owner2 == 2);
+        firstAndSecond |= owner1 == 0 && owner2 == 1;
+        secondAndThird |= owner1 == 1 && owner2 == 2;
+    }
+    EXPECT_TRUE(firstAndSecond);
+    EXPECT_TRUE(secondAndThird);
+}
+
+TEST_F(BOPCheckTest, stopCheck)
+{
+    // Arrange
+    auto comp = makeCompound({makeBox(0, 0, 0), makeBox(5, 5, 5)});
+    Part::BOPCheck check(comp);
+    // Act
+    bool done = check.perform([](const BOPAlgo_ListOfCheckResult&) {
+        return false;
+    });
+    // Assert
+    EXPECT_FALSE(done);
+    EXPECT_FALSE(check.hasFaulty());
+}
+
+TEST_F(BOPCheckTest, analyzeReportsInterference)
+{
+    // Arrange
+    Part::TopoShape shape(makeCompound({makeBox(0, 0, 0), makeBox(5, 5, 5)}));
+    std::stringstream str;
+    // Act
+    bool valid = shape.analyze(true, str);
+    // Assert
+    EXPECT_FALSE(valid);
+    EXPECT_NE(str.str().find("BOP check found the following errors"), std::string::npos);
+}
+// NOLINTEND
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/Part/App/Tools.h>
+
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeSphere.hxx>
+#include <BRepTools.hxx>
+
+// NOLINTBEGIN
+class ToolsTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        _sphere = BRepPrimAPI_MakeSphere(10.0).Shape();
+    }
+
+    TopoDS_Shape _sphere;
+};
+
+TEST_F(ToolsTest, hasTriangulationWithoutMesh)
+{
+    EXPECT_FALSE(Part::Tools::hasTriangulation(_sphere, 0.1, false));
+    EXPECT_FALSE(Part::Tools::hasTriangulation(_sphere, 0.1, true));
+}
+
+TEST_F(ToolsTest, hasTriangulationWithSameDeflection)
+{
+    // Arrange
+    BRepMesh_IncrementalMesh(_sphere, 0.1);
+
+    // Act, Assert
+    EXPECT_TRUE(Part::Tools::hasTriangulation(_sphere, 0.1, false));
+    EXPECT_TRUE(Part::Tools::hasTriangulation(_sphere, 0.1, true));
+}
+
+TEST_F(ToolsTest, hasTriangulationWithCoarserMesh)
+{
+    // Arrange
+    BRepMesh_IncrementalMesh(_sphere, 1.0);
+
+    // Act, Assert
+    EXPECT_FALSE(Part::Tools::hasTriangulation(_sphere, 0.1, false));
+    EXPECT_FALSE(Part::Tools::hasTriangulation(_sphere, 0.1, true));
+}
+
+TEST_F(ToolsTest, hasTriangulationWithFinerMesh)
+{
+    // Arrange
+    BRepMesh_IncrementalMesh(_sphere, 0.01);
+
+    // Act, Assert
+    // a finer triangulation is only kept if the quality mustn't decrease
+    EXPECT_TRUE(Part::Tools::hasTriangulation(_sphere, 0.1, false));
+    EXPECT_FALSE(Part::Tools::hasTriangulation(_sphere, 0.1, true));
+}
+
+TEST_F(ToolsTest, hasTriangulationAfterClean)
+{
+    // Arrange
+    BRepMesh_IncrementalMesh(_sphere, 0.1);
+    BRepTools::Clean(_sphere);
+
+    // Act, Assert
+    EXPECT_FALSE(Part::Tools::hasTriangulation(_sphere, 0.1, false));
+}
+// NOLINTEND
@@ -5,6 +5,12 @@
 #include <Mod/Part/App/TopoShape.h>
 #include "src/App/InitApplication.h"
 
+#include <sstream>
+
+#include <BRepMesh_IncrementalMesh.hxx>
+#include <BRepPrimAPI_MakeBox.hxx>
+#include <BRepTools.hxx>
+
 
 class TopoShapeTest: public ::testing::Test
 {
@@ -136,4 +142,54 @@ TEST_F(TopoShapeTest, TestGetSubshape)
     EXPECT_THROW(cube1.getSubShape("WOOHOO", false), Base::ValueError);  // Invalid
 }
 
+TEST_F(TopoShapeTest, TestExportBrepWithTriangulation)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    BRepMesh_IncrementalMesh(box, 0.1);
+    Part::TopoShape shape(box);
+    std::stringstream withTriangles;
+    std::stringstream withoutTriangles;
+    // Act
+    shape.exportBrep(withTriangles, true);
+    shape.exportBrep(withoutTriangles);
+    Part::TopoShape restored1;
+    restored1.importBrep(withTriangles);
+    Part::TopoShape restored2;
+    restored2.importBrep(withoutTriangles);
+    // Assert
+    EXPECT_TRUE(BRepTools::Triangulation(restored1.getShape(), 0.1));
+    EXPECT_FALSE(BRepTools::Triangulation(restored2.getShape(), 0.1));
+}
+
+TEST_F(TopoShapeTest, TestExportBinaryWithTriangulation)
+{
+    // Arrange
+    TopoDS_Shape box = BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape();
+    BRepMesh_IncrementalMesh(box, 0.1);
+    Part::TopoShape shape(box);
+    std::stringstream withTriangles;
+    std::stringstream withoutTriangles;
+    // Act
+    shape.exportBinary(withTriangles, true);
+    shape.exportBinary(withoutTriangles);
+    Part::TopoShape restored1;
+    restored1.importBinary(withTriangles);
+    Part::TopoShape restored2;
+    restored2.importBinary(withoutTriangles);
+    // Assert
+    EXPECT_TRUE(BRepTools::Triangulation(restored1.getShape(), 0.1));
+    EXPECT_FALSE(BRepTools::Triangulation(restored2.getShape(), 0.1));
+}
+
+TEST_F(TopoShapeTest, TestSlices)
+{
+    // Arrange
+    Part::TopoShape box(BRepPrimAPI_MakeBox(1.0, 2.0, 3.0).Shape());
+    // Act
+    TopoDS_Compound comp = box.slices(Base::Vector3d(0, 0, 1), {-1.0, 1.0, 2.0, 4.0});
+    // Assert
+    EXPECT_EQ(Part::TopoShape(comp).countSubShapes(TopAbs_WIRE), 2UL);
+}
+
 // clang-format on
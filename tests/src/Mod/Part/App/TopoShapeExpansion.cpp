@@ -4,6 +4,7 @@
 #include "src/App/InitApplication.h"
 #include <Mod/Part/App/TopoShape.h>
 #include "Mod/Part/App/TopoShapeMapper.h"
+#include <Mod/Part/App/TopoShapeOpCache.h>
 #include <Mod/Part/App/TopoShapeOpCode.h>
 
 #include "PartTestHelpers.h"
@@ -20,6 +21,7 @@
 #include <BRepOffsetAPI_MakeEvolved.hxx>
 #include <BRepPrimAPI_MakeBox.hxx>
 #include <BRepAlgoAPI_Fuse.hxx>
+#include <GProp_GProps.hxx>
 #include <GeomAPI_PointsToBSpline.hxx>
 #include <Geom_BezierCurve.hxx>
 #include <Geom_BezierSurface.hxx>
@@ -1465,6 +1467,143 @@ TEST_F(TopoShapeExpansionTest, makeElementBooleanCut)
                                  }));
 }
 
+TEST_F(TopoShapeExpansionTest, makeElementBooleanToolGroups)
+{
+    // Arrange
+    auto plate = BRepPrimAPI_MakeBox(gp_Pnt(0, 0, 0), 6.0, 1.0, 1.0).Shape();
+    auto tool1 = BRepPrimAPI_MakeBox(gp_Pnt(0.5, 0, 0.5), 1.0, 1.0, 1.0).Shape();
+    auto tool2 = BRepPrimAPI_MakeBox(gp_Pnt(2.5, 0, 0.5), 1.0, 1.0, 1.0).Shape();
+    auto tool3 = BRepPrimAPI_MakeBox(gp_Pnt(4.5, 0, 0.5), 1.0, 1.0, 1.0).Shape();
+    TopoShape topoShape1 {plate, 1L};
+    TopoShape topoTool1 {tool1, 2L};
+    TopoShape topoTool2 {tool2, 3L};
+    TopoShape topoTool3 {tool3, 4L};
+    auto mappedNames = [](const TopoShape& shape) {
+        std::vector<std::string> names;
+        for (const auto& element : shape.getElementMap()) {
+            names.push_back(element.name.toString());
+        }
+        std::sort(names.begin(), names.end());
+        return names;
+    };
+    for (const char* maker : {Part::OpCodes::Fuse, Part::OpCodes::Cut}) {
+        // Act
+        TopoShape grouped {5L};
+        grouped.makeElementBoolean(maker, topoShape1, {{topoTool1, topoTool3}, {topoTool2}});
+        TopoShape separate {5L};
+        separate.makeElementBoolean(maker, {topoShape1, topoTool1, topoTool3, topoTool2});
+        // Assert
+        EXPECT_FLOAT_EQ(getVolume(grouped.getShape()), getVolume(separate.getShape())) << maker;
+        EXPECT_EQ(grouped.countSubShapes(TopAbs_SOLID), 1) << maker;
+        EXPECT_EQ(grouped.countSubShapes(TopAbs_FACE), separate.countSubShapes(TopAbs_FACE))
+            << maker;
+        EXPECT_GT(grouped.getElementMapSize(), 0) << maker;
+        EXPECT_EQ(mappedNames(grouped), mappedNames(separate)) << maker;
+    }
+}
+
+TEST_F(TopoShapeExpansionTest, makeElementBooleanOpCache)
+{
+    // Arrange
+    auto& opCache = Part::TopoShapeOpCache::instance();
+    bool wasEnabled = opCache.isEnabled();
+    opCache.setEnabled(true);
+    opCache.clear();
+    auto [cube1, cube2] = CreateTwoCubes();
+    auto tr {gp_Trsf()};
+    tr.SetTranslation(gp_Vec(gp_XYZ(-0.5, -0.5, 0)));
+    cube2.Move(TopLoc_Location(tr));
+    TopoShape topoShape1 {cube1, 1L};
+    TopoShape topoShape2 {cube2, 2L};
+    TopoShape result1 {3L};
+    TopoShape result2 {3L};
+    TopoShape result3 {3L};
+    // Act
+    result1.makeElementBoolean(Part::OpCodes::Cut, {topoShape1, topoShape2});
+    result2.makeElementBoolean(Part::OpCodes::Cut, {topoShape1, topoShape2});
+    result3.makeElementBoolean(Part::OpCodes::Cut, {topoShape1, topoShape2}, nullptr, 1e-5);
+    auto cacheSize = opCache.size();
+    opCache.setEnabled(wasEnabled);
+    // Assert the second call returns the remembered result and a different tolerance doesn't
+    EXPECT_EQ(cacheSize, 2);
+    EXPECT_TRUE(result2.getShape().IsSame(result1.getShape()));
+    EXPECT_FALSE(result3.getShape().IsSame(result1.getShape()));
+    EXPECT_FLOAT_EQ(getVolume(result2.getShape()), 0.75);
+    EXPECT_EQ(elementMap(result2), elementMap(result1));
+}
+
+TEST_F(TopoShapeExpansionTest, makeElementBooleanOpCacheCopiesElementMap)
+{
+    // Arrange
+    auto& opCache = Part::TopoShapeOpCache::instance();
+    bool wasEnabled = opCache.isEnabled();
+    opCache.setEnabled(true);
+    opCache.clear();
+    auto [cube1, cube2] = CreateTwoCubes();
+    auto tr {gp_Trsf()};
+    tr.SetTranslation(gp_Vec(gp_XYZ(-0.5, -0.5, 0)));
+    cube2.Move(TopLoc_Location(tr));
+    TopoShape topoShape1 {cube1, 1L};
+    TopoShape topoShape2 {cube2, 2L};
+    TopoShape renamed {cube2, 2L};
+    renamed.resetElementMap(std::make_shared<Data::ElementMap>());
+    renamed.setElementName(IndexedName("Face", 1), MappedName("Renamed"), renamed.Tag);
+    TopoShape result1 {3L};
+    TopoShape result2 {3L};
+    TopoShape result3 {3L};
+    // Act
+    result1.makeElementBoolean(Part::OpCodes::Cut, {topoShape1, topoShape2});
+    auto names = elementMap(result1);
+    result1.setElementName(IndexedName("Face", 1),
+                           MappedName("Changed"),
+                           result1.Tag,
+                           nullptr,
+                           true);
+    result2.makeElementBoolean(Part::OpCodes::Cut, {topoShape1, topoShape2});
+    result2.setElementName(IndexedName("Face", 2),
+                           MappedName("Changed"),
+                           result2.Tag,
+                           nullptr,
+                           true);
+    result3.makeElementBoolean(Part::OpCodes::Cut, {topoShape1, renamed});
+    auto cacheSize = opCache.size();
+    opCache.setEnabled(wasEnabled);
+    // Assert changing a result doesn't change the cache, and other input names aren't a hit
+    EXPECT_EQ(cacheSize, 2);
+    EXPECT_TRUE(result2.getShape().IsSame(result1.getShape()));
+    EXPECT_EQ(elementMap(result2)[IndexedName("Face", 1)], names[IndexedName("Face", 1)]);
+    EXPECT_FALSE(result3.getShape().IsSame(result1.getShape()));
+}
+
+TEST_F(TopoShapeExpansionTest, makeElementBooleanOpCacheDocumentClosed)
+{
+    // Arrange
+    auto& opCache = Part::TopoShapeOpCache::instance();
+    bool wasEnabled = opCache.isEnabled();
+    opCache.setEnabled(true);
+    opCache.clear();
+    auto docName = App::GetApplication().getUniqueDocumentName("opcache");
+    auto doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    auto [cube1, cube2] = CreateTwoCubes();
+    auto tr {gp_Trsf()};
+    tr.SetTranslation(gp_Vec(gp_XYZ(-0.5, -0.5, 0)));
+    cube2.Move(TopLoc_Location(tr));
+    TopoShape topoShape1 {cube1, 1L, doc->getStringHasher()};
+    TopoShape topoShape2 {cube2, 2L, doc->getStringHasher()};
+    TopoShape result1 {3L, doc->getStringHasher()};
+    TopoShape result2 {3L};
+    result1.makeElementBoolean(Part::OpCodes::Cut, {topoShape1, topoShape2});
+    result2.makeElementBoolean(Part::OpCodes::Cut, {TopoShape(cube1, 1L), TopoShape(cube2, 2L)});
+    auto cacheSize = opCache.size();
+    // Act
+    App::GetApplication().closeDocument(docName.c_str());
+    auto cacheSizeAfterClose = opCache.size();
+    opCache.setEnabled(wasEnabled);
+    // Assert only the operation using the hasher of the closed document is forgotten
+    EXPECT_EQ(cacheSize, 2);
+    EXPECT_EQ(cacheSizeAfterClose, 1);
+}
+
 TEST_F(TopoShapeExpansionTest, makeElementBooleanFuse)
 {
     // Arrange
@@ -2329,6 +2468,108 @@ TEST_F(TopoShapeExpansionTest, makeElementFillet)
                               }));
 }
 
+TEST_F(TopoShapeExpansionTest, makeElementFilletWithRadii)
+{
+    // Arrange
+    auto [cube1, cube2] = CreateTwoCubes();
+    TopoShape cube1TS {cube1, 1L};
+    auto edges = cube1TS.getSubTopoShapes(TopAbs_EDGE);
+    std::vector<std::pair<double, double>> radii(edges.size(), {.05, .05});
+    // Act
+    cube1TS.makeElementFillet({cube1TS}, edges, radii);
+    // Assert
+    EXPECT_EQ(cube1TS.countSubElements("Wire"), 26);
+    EXPECT_NEAR(getArea(cube1TS.getShape()), 5.739646, 1e-6);
+    EXPECT_THROW(cube1TS.makeElementFillet({cube1TS}, edges, {{.05, .05}}), Base::ValueError);
+}
+
+TEST_F(TopoShapeExpansionTest, makeElementFilletReportsFailingEdges)
+{
+    // Arrange
+    TopoShape box1 {BRepPrimAPI_MakeBox(gp_Pnt(0, 0, 0), 1, 1, 1).Shape(), 1L};
+    TopoShape box2 {BRepPrimAPI_MakeBox(gp_Pnt(10, 0, 0), 1, 1, 1).Shape(), 2L};
+    TopoShape comp {3L};
+    comp.makeElementCompound({box1, box2});
+    auto edges = comp.getSubTopoShapes(TopAbs_EDGE);
+    ASSERT_EQ(edges.size(), 24UL);
+    // Act and assert: the second edge can't be filleted with the given radius, the fillets of
+    // both edges are independent of each other, so the failing edge is reported
+    EXPECT_THROW(TopoShape(4L).makeElementFillet(comp,
+                                                 {edges[0], edges[12]},
+                                                 {{.1, .1}, {10.0, 10.0}}),
+                 Base::CADKernelError);
+}
+
+TEST_F(TopoShapeExpansionTest, makeElementChamferReportsFailingEdges)
+{
+    // Arrange
+    TopoShape box1 {BRepPrimAPI_MakeBox(gp_Pnt(0, 0, 0), 1, 1, 1).Shape(), 1L};
+    TopoShape box2 {BRepPrimAPI_MakeBox(gp_Pnt(10, 0, 0), 0.2, 0.2, 0.2).Shape(), 2L};
+    TopoShape comp {3L};
+    comp.makeElementCompound({box1, box2});
+    auto edges = comp.getSubTopoShapes(TopAbs_EDGE);
+    ASSERT_EQ(edges.size(), 24UL);
+    std::string message;
+    // Act: the chamfer doesn't fit on the edge of the small box
+    try {
+        TopoShape(4L).makeElementChamfer(comp,
+                                         {edges[0], edges[12]},
+                                         Part::ChamferType::equalDistance,
+                                         .3,
+                                         .3);
+    }
+    catch (const Base::CADKernelError& e) {
+        message = e.what();
+    }
+    // Assert
+    EXPECT_NE(message.find("on Edge13"), std::string::npos) << message;
+}
+
+TEST_F(TopoShapeExpansionTest, makeElementChamferSeparateEdges)
+{
+    // Arrange: two edges of a box that don't share a face, chamfered with two distances so that
+    // the result depends on the reference face of each edge
+    TopoShape box {BRepPrimAPI_MakeBox(gp_Pnt(0, 0, 0), 1, 1, 1).Shape(), 1L};
+    auto edges = box.getSubTopoShapes(TopAbs_EDGE);
+    TopoShape first = edges[0];
+    TopoShape second;
+    auto firstFaces = box.findAncestorsShapes(first.getShape(), TopAbs_FACE);
+    for (const auto& edge : edges) {
+        auto faces = box.findAncestorsShapes(edge.getShape(), TopAbs_FACE);
+        if (std::none_of(faces.begin(), faces.end(), [&](const TopoDS_Shape& face) {
+                return std::find(firstFaces.begin(), firstFaces.end(), face) != firstFaces.end();
+            })) {
+            second = edge;
+            break;
+        }
+    }
+    ASSERT_FALSE(second.isNull());
+    auto properties = [](const TopoShape& shape) {
+        GProp_GProps props;
+        BRepGProp::VolumeProperties(shape.getShape(), props);
+        return std::make_pair(props.Mass(), gp_Vec(props.CentreOfMass().XYZ()));
+    };
+    // The removed parts don't touch, so the chamfers can be added up edge by edge
+    auto [boxVolume, boxCenter] = properties(box);
+    double volume = boxVolume;
+    gp_Vec moment = boxCenter * boxVolume;
+    for (const auto& edge : {first, second}) {
+        auto [v, c] = properties(TopoShape(2L).makeElementChamfer(box,
+                                                                  {edge},
+                                                                  Part::ChamferType::twoDistances,
+                                                                  .1,
+                                                                  .2));
+        volume -= boxVolume - v;
+        moment -= boxCenter * boxVolume - c * v;
+    }
+    // Act
+    auto [resultVolume, resultCenter] = properties(
+        TopoShape(3L).makeElementChamfer(box, {first, second}, Part::ChamferType::twoDistances, .1, .2));
+    // Assert
+    EXPECT_NEAR(resultVolume, volume, 1e-6);
+    EXPECT_TRUE(resultCenter.IsEqual(moment / volume, 1e-6, 1e-6));
+}
+
 TEST_F(TopoShapeExpansionTest, makeElementSlice)
 {
     // Arrange
@@ -2410,6 +2651,21 @@ TEST_F(TopoShapeExpansionTest, makeElementSlices)
                                                     // again after importing other TopoNaming logics
 }
 
+TEST_F(TopoShapeExpansionTest, makeElementSlicesOutsideShape)
+{
+    // Arrange
+    auto [cube1, cube2] = CreateTwoCubes();
+    TopoShape cube1TS {cube1, 1L};
+    auto faces = cube1TS.getSubShapes(TopAbs_FACE);
+    TopoShape slicer {faces[0]};
+    Base::Vector3d direction {1.0, 0.0, 0.0};
+    // Act
+    auto& result = slicer.makeElementSlices(cube1TS, direction, {-1.0, 0.5, 2.0});
+    // Assert only the distance within the cube gives a wire
+    EXPECT_EQ(result.getShape().ShapeType(), TopAbs_WIRE);
+    EXPECT_FLOAT_EQ(getLength(result.getShape()), 4);
+}
+
 TEST_F(TopoShapeExpansionTest, makeElementMirror)
 {
     // Arrange
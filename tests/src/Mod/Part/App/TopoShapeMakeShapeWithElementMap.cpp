@@ -3,12 +3,16 @@
 // Tests for the makeShapeWithElementMap method, extracted from the main set of tests for TopoShape
 // due to length and complexity.
 
+#include <set>
+
 #include <gtest/gtest.h>
 #include "src/App/InitApplication.h"
 #include "PartTestHelpers.h"
 #include <Mod/Part/App/TopoShape.h>
 #include <Mod/Part/App/TopoShapeOpCode.h>
+#include <Mod/Part/App/FCBRepAlgoAPI_Cut.h>
 
+#include <BRepPrimAPI_MakeBox.hxx>
 #include <TopoDS_Vertex.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Wire.hxx>
@@ -17,6 +21,8 @@
 #include <TopoDS_Solid.hxx>
 #include <TopoDS_CompSolid.hxx>
 #include <TopoDS_Compound.hxx>
+#include <TopLoc_Location.hxx>
+#include <gp_Trsf.hxx>
 
 using namespace Part;
 using namespace Data;
@@ -334,3 +340,103 @@ std::string composeTagInfo(const MappedElement& element, const TopoShape& shape)
 
     return tagInfo;
 }
+
+TEST_F(TopoShapeMakeShapeWithElementMapTests, namesAllElementsOfManyToolBoolean)
+{
+    // Arrange: a plate with a grid of pockets. Most elements of the plate are left
+    // untouched by the cut and are named from the unmodified source elements.
+    constexpr int gridSize = 6;
+    TopoShape plate {BRepPrimAPI_MakeBox(gp_Pnt(0, 0, 0), 2.0 * gridSize, 2.0 * gridSize, 1.0)
+                         .Shape(),
+                     1L};
+    std::vector<TopoShape> shapes {plate};
+    long tag = 2;
+    for (int i = 0; i < gridSize; ++i) {
+        for (int j = 0; j < gridSize; ++j) {
+            shapes.emplace_back(
+                BRepPrimAPI_MakeBox(gp_Pnt(2.0 * i + 0.5, 2.0 * j + 0.5, 0.5), 1.0, 1.0, 1.0)
+                    .Shape(),
+                tag++);
+        }
+    }
+    TopoShape result {100L};
+
+    // Act
+    result.makeElementBoolean(Part::OpCodes::Cut, shapes);
+
+    // Assert: every element got a unique name
+    EXPECT_EQ(result.countSubShapes(TopAbs_FACE), 6 + 5 * gridSize * gridSize);
+    std::set<MappedName> names;
+    std::size_t count = 0;
+    for (const auto& shapeType : result.getElementTypes()) {
+        for (unsigned long i = 1; i <= result.countSubElements(shapeType); ++i, ++count) {
+            auto name = result.getMappedName(IndexedName(shapeType, (int)i));
+            EXPECT_TRUE(name) << shapeType << i;
+            names.insert(name);
+        }
+    }
+    EXPECT_EQ(names.size(), count);
+}
+
+TEST_F(TopoShapeMakeShapeWithElementMapTests, namesOfModifiedAndGeneratedElements)
+{
+    // Arrange: the expected names are those of the makeElementBooleanCut test, they were
+    // recorded before the history pass only looked up the names of the elements it uses
+    auto [cube1, cube2] = PartTestHelpers::CreateTwoCubes();
+    auto tr {gp_Trsf()};
+    tr.SetTranslation(gp_Vec(gp_XYZ(-0.5, -0.5, 0)));
+    cube2.Move(TopLoc_Location(tr));
+    std::vector<TopoShape> sources {TopoShape {cube1, 1L}, TopoShape {cube2, 2L}};
+    FCBRepAlgoAPI_Cut mkCut(cube1, cube2);
+    ASSERT_TRUE(mkCut.IsDone());
+    TopoShape result {1L};
+
+    // Act
+    result.makeShapeWithElementMap(mkCut.Shape(),
+                                   MapperMaker(mkCut),
+                                   sources,
+                                   Part::OpCodes::Cut);
+
+    // Assert
+    EXPECT_TRUE(PartTestHelpers::allElementsMatch(result,
+                                                  {
+                                                      "Edge1",
+                                                      "Edge10;:G(Edge2;K-1;:H2:4,E);CUT;:H1:1a,V",
+                                                      "Edge10;:M;CUT;:H1:7,E",
+                                                      "Edge11",
+                                                      "Edge11;:M;CUT;:H2:7,E",
+                                                      "Edge12",
+                                                      "Edge12;:M;CUT;:H2:7,E",
+                                                      "Edge2",
+                                                      "Edge2;:M;CUT;:H2:7,E",
+                                                      "Edge3",
+                                                      "Edge3;:M;CUT;:H2:7,E",
+                                                      "Edge4",
+                                                      "Edge4;:M;CUT;:H2:7,E",
+                                                      "Edge6;:G(Edge12;K-1;:H2:4,E);CUT;:H1:1b,V",
+                                                      "Edge6;:M;CUT;:H1:7,E",
+                                                      "Edge7",
+                                                      "Edge8;:G(Edge11;K-1;:H2:4,E);CUT;:H1:1b,V",
+                                                      "Edge8;:M;CUT;:H1:7,E",
+                                                      "Edge9;:G(Edge4;K-1;:H2:4,E);CUT;:H1:1a,V",
+                                                      "Edge9;:M;CUT;:H1:7,E",
+                                                      "Face1",
+                                                      "Face1;:M;CUT;:H2:7,F",
+                                                      "Face2;:G(Face4;K-1;:H2:4,F);CUT;:H1:1a,E",
+                                                      "Face2;:M;CUT;:H1:7,F",
+                                                      "Face3;:G(Face1;K-1;:H2:4,F);CUT;:H1:1a,E",
+                                                      "Face3;:M;CUT;:H1:7,F",
+                                                      "Face4",
+                                                      "Face4;:M;CUT;:H2:7,F",
+                                                      "Face5;:M;CUT;:H1:7,F",
+                                                      "Face6;:M;CUT;:H1:7,F",
+                                                      "Vertex1",
+                                                      "Vertex2",
+                                                      "Vertex3",
+                                                      "Vertex3;:M;CUT;:H2:7,V",
+                                                      "Vertex4",
+                                                      "Vertex4;:M;CUT;:H2:7,V",
+                                                      "Vertex7",
+                                                      "Vertex8",
+                                                  }));
+}
@@ -382,6 +382,37 @@ TEST_F(WireJoinerTest, setSplitEdges)
     EXPECT_EQ(wireSplitEdges.getSubTopoShapes(TopAbs_EDGE).size(), 4);
 }
 
+TEST_F(WireJoinerTest, setSplitEdgesManyEdges)
+{
+    // Arrange
+
+    // Create more crossing edges than checked for intersection in one go
+    std::vector<TopoDS_Shape> edges;
+    const int numCrosses {150};
+    for (int i = 0; i < numCrosses; ++i) {
+        double x = 2.0 * i;
+        edges.push_back(
+            BRepBuilderAPI_MakeEdge(gp_Pnt(x + 1.0, 1.0, 0.0), gp_Pnt(x, 0.0, 0.0)).Edge());
+        edges.push_back(
+            BRepBuilderAPI_MakeEdge(gp_Pnt(x, 1.0, 0.0), gp_Pnt(x + 1.0, 0.0, 0.0)).Edge());
+    }
+
+    auto wjSplitEdges {WireJoiner()};
+    wjSplitEdges.setTightBound(false);
+    auto wireSplitEdges {TopoShape(1)};
+
+    // Act
+    wjSplitEdges.addShape(edges);
+    wjSplitEdges.setSplitEdges();
+    wjSplitEdges.Build();
+    wjSplitEdges.getOpenWires(wireSplitEdges, nullptr, false);
+
+    // Assert
+
+    // Each of the edges has been split at the intersection with its partner
+    EXPECT_EQ(wireSplitEdges.getSubTopoShapes(TopAbs_EDGE).size(), std::size_t(4 * numCrosses));
+}
+
 TEST_F(WireJoinerTest, setMergeEdges)
 {
     // Arrange
@@ -0,0 +1,102 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <Mod/ReverseEngineering/App/ApproxSurface.h>
+
+#include <GeomAPI_ProjectPointOnSurf.hxx>
+#include <Geom_BSplineSurface.hxx>
+#include <TColgp_Array1OfPnt.hxx>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class ApproxSurfaceTest: public ::testing::Test
+{
+protected:
+    // samples of the saddle z = x^2 - y^2, which a bicubic surface represents exactly if the
+    // points are parametrized by x and y
+    static TColgp_Array1OfPnt makeSaddle(int count)
+    {
+        TColgp_Array1OfPnt points(0, count * count - 1);
+        int index = 0;
+        for (int i = 0; i < count; i++) {
+            for (int j = 0; j < count; j++) {
+                double x = double(i) / (count - 1);
+                double y = double(j) / (count - 1);
+                points(index++) = gp_Pnt(x, y, x * x - y * y);
+            }
+        }
+        return points;
+    }
+
+    static double maxDistance(const Handle(Geom_BSplineSurface) & surface,
+                              const TColgp_Array1OfPnt& points)
+    {
+        double dist = 0.0;
+        for (int i = points.Lower(); i <= points.Upper(); i++) {
+            GeomAPI_ProjectPointOnSurf proj(points(i), surface);
+            EXPECT_GT(proj.NbPoints(), 0);
+            if (proj.NbPoints() > 0) {
+                dist = std::max(dist, proj.LowerDistance());
+            }
+        }
+        return dist;
+    }
+};
+
+TEST_F(ApproxSurfaceTest, fitWithoutSmoothing)
+{
+    // Arrange
+    TColgp_Array1OfPnt points = makeSaddle(20);
+    Reen::BSplineParameterCorrection pc(4, 4, 6, 6);
+    pc.SetUV(Base::Vector3d(1, 0, 0), Base::Vector3d(0, 1, 0));
+    pc.EnableSmoothing(false);
+
+    // Act
+    Handle(Geom_BSplineSurface) surface = pc.CreateSurface(points, 5, true, 1.0);
+
+    // Assert
+    ASSERT_FALSE(surface.IsNull());
+    EXPECT_EQ(surface->NbUPoles(), 6);
+    EXPECT_EQ(surface->NbVPoles(), 6);
+    EXPECT_LT(maxDistance(surface, points), 1e-6);
+}
+
+TEST_F(ApproxSurfaceTest, fitWithSmoothing)
+{
+    // Arrange
+    TColgp_Array1OfPnt points = makeSaddle(20);
+    Reen::BSplineParameterCorrection pc(4, 4, 8, 8);
+    pc.SetUV(Base::Vector3d(1, 0, 0), Base::Vector3d(0, 1, 0));
+    pc.EnableSmoothing(true, 0.1, 1.0, 0.0, 0.0);
+
+    // Act
+    Handle(Geom_BSplineSurface) surface = pc.CreateSurface(points, 5, true, 1.0);
+
+    // Assert
+    ASSERT_FALSE(surface.IsNull());
+    EXPECT_LT(maxDistance(surface, points), 1e-2);
+    EXPECT_FALSE(pc.GetFirstSmoothMatrix().nonZeros() == 0);
+}
+
+TEST_F(ApproxSurfaceTest, smoothMatricesAreSymmetric)
+{
+    // Arrange
+    TColgp_Array1OfPnt points = makeSaddle(10);
+    Reen::BSplineParameterCorrection pc(4, 4, 6, 6);
+    pc.EnableSmoothing(true, 0.5, 1.0, 1.0, 1.0);
+
+    // Act
+    Handle(Geom_BSplineSurface) surface = pc.CreateSurface(points, 1, false, 1.0);
+
+    // Assert
+    ASSERT_FALSE(surface.IsNull());
+    for (const auto* mat :
+         {&pc.GetFirstSmoothMatrix(), &pc.GetSecondSmoothMatrix(), &pc.GetThirdSmoothMatrix()}) {
+        ASSERT_EQ(mat->rows(), 36);
+        ASSERT_EQ(mat->cols(), 36);
+        Reen::BSplineParameterCorrection::SparseMatrix diff = *mat - mat->transpose();
+        EXPECT_LT(diff.norm(), 1e-9 * std::max(1.0, mat->norm()));
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
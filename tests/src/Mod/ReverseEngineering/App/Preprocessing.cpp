@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <Mod/Points/App/Points.h>
+#include <Mod/ReverseEngineering/App/PointKDTree.h>
+#include <Mod/ReverseEngineering/App/Preprocessing.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+TEST(PointKDTree, kNearest)
+{
+    std::vector<Base::Vector3d> points;
+    for (int i = 0; i < 20; i++) {
+        for (int j = 0; j < 20; j++) {
+            for (int k = 0; k < 20; k++) {
+                points.emplace_back(i, j, k);
+            }
+        }
+    }
+
+    Reen::PointKDTree tree(points);
+    EXPECT_EQ(tree.size(), points.size());
+
+    Base::Vector3d pnt(5.1, 5.2, 5.3);
+    std::vector<int> indices;
+    tree.kNearest(pnt, 7, indices);
+    ASSERT_EQ(indices.size(), 7);
+
+    // compare with brute force
+    std::vector<double> dist;
+    for (const auto& it : points) {
+        dist.push_back(Base::DistanceP2(it, pnt));
+    }
+    std::sort(dist.begin(), dist.end());
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        EXPECT_DOUBLE_EQ(Base::DistanceP2(points[indices[i]], pnt), dist[i]);
+    }
+
+    tree.inRange(Base::Vector3d(5, 5, 5), 1.01, indices);
+    EXPECT_EQ(indices.size(), 7);
+    EXPECT_EQ(points[indices.front()], Base::Vector3d(5, 5, 5));
+}
+
+TEST(VoxelGridFilter, downsample)
+{
+    Points::PointKernel kernel;
+    for (int i = 0; i < 10; i++) {
+        for (int j = 0; j < 10; j++) {
+            kernel.push_back(Base::Vector3d(i * 0.1 + 0.05, j * 0.1 + 0.05, 0.0));
+        }
+    }
+
+    Reen::VoxelGridFilter filter(kernel);
+    filter.setLeafSize(0.5, 0.5, 0.5);
+    std::vector<Base::Vector3d> points;
+    filter.perform(points);
+    ASSERT_EQ(points.size(), 4);
+    EXPECT_NEAR(points[0].x, 0.25, 1e-6);
+    EXPECT_NEAR(points[0].y, 0.25, 1e-6);
+    EXPECT_NEAR(points[3].x, 0.75, 1e-6);
+    EXPECT_NEAR(points[3].y, 0.75, 1e-6);
+}
+
+TEST(PCANormalEstimation, orientedSphereNormals)
+{
+    const double pi = std::numbers::pi;
+    Points::PointKernel kernel;
+    for (int i = 0; i < 40; i++) {
+        for (int j = 0; j < 20; j++) {
+            double phi = 2.0 * pi * i / 40.0;
+            double theta = 0.1 + (pi - 0.2) * j / 20.0;
+            kernel.push_back(Base::Vector3d(std::sin(theta) * std::cos(phi),
+                                            std::sin(theta) * std::sin(phi),
+                                            std::cos(theta)));
+        }
+    }
+
+    Reen::PCANormalEstimation estimate(kernel);
+    estimate.setKSearch(8);
+    std::vector<Base::Vector3f> normals;
+    estimate.perform(normals);
+    ASSERT_EQ(normals.size(), kernel.size());
+
+    // all normals point outside or all inside
+    int outside = 0;
+    for (std::size_t i = 0; i < normals.size(); i++) {
+        Base::Vector3d pnt = kernel.getPoint(static_cast<int>(i));
+        Base::Vector3d nor(normals[i].x, normals[i].y, normals[i].z);
+        EXPECT_GT(std::fabs(nor * pnt), 0.95);
+        if (nor * pnt > 0.0) {
+            outside++;
+        }
+    }
+    EXPECT_EQ(outside, static_cast<int>(normals.size()));
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <numbers>
+#include <Mod/Points/App/Points.h>
+#include <Mod/ReverseEngineering/App/PrimitiveDetection.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PrimitiveDetectionTest: public ::testing::Test
+{
+protected:
+    void addPlane()
+    {
+        for (int i = 0; i < 30; i++) {
+            for (int j = 0; j < 30; j++) {
+                kernel.push_back(Base::Vector3d(i * 0.1, j * 0.1, 0.0));
+                normals.emplace_back(0.0, 0.0, 1.0);
+            }
+        }
+    }
+    void addSphere()
+    {
+        const double pi = std::numbers::pi;
+        for (int i = 0; i < 30; i++) {
+            for (int j = 0; j < 30; j++) {
+                double phi = 2.0 * pi * i / 30.0;
+                double theta = 0.1 + (pi - 0.2) * j / 30.0;
+                Base::Vector3d dir(std::sin(theta) * std::cos(phi),
+                                   std::sin(theta) * std::sin(phi),
+                                   std::cos(theta));
+                kernel.push_back(Base::Vector3d(10.0, 10.0, 10.0) + 2.0 * dir);
+                normals.push_back(dir);
+            }
+        }
+    }
+    void addCylinder()
+    {
+        const double pi = std::numbers::pi;
+        for (int i = 0; i < 30; i++) {
+            for (int j = 0; j < 30; j++) {
+                double phi = 2.0 * pi * i / 30.0;
+                Base::Vector3d dir(std::cos(phi), std::sin(phi), 0.0);
+                kernel.push_back(Base::Vector3d(-10.0, 0.0, j * 0.1) + 1.5 * dir);
+                normals.push_back(dir);
+            }
+        }
+    }
+
+    Points::PointKernel kernel;
+    std::vector<Base::Vector3d> normals;
+};
+
+TEST_F(PrimitiveDetectionTest, detectPlaneWithoutNormals)
+{
+    addPlane();
+    std::vector<Base::Vector3d> none;
+    Reen::PrimitiveDetection detect(kernel, none);
+    auto primitives = detect.perform();
+    ASSERT_EQ(primitives.size(), 1);
+    EXPECT_EQ(primitives[0].type, Reen::PrimitiveDetection::Type::Plane);
+    EXPECT_EQ(primitives[0].inliers.size(), 900);
+    EXPECT_NEAR(std::fabs(primitives[0].parameters[5]), 1.0, 1e-6);
+}
+
+TEST_F(PrimitiveDetectionTest, cylinderNeedsNormals)
+{
+    addCylinder();
+    std::vector<Base::Vector3d> none;
+    Reen::PrimitiveDetection detect(kernel, none);
+    Reen::PrimitiveDetection::Parameters param;
+    param.types = {Reen::PrimitiveDetection::Type::Cylinder};
+    detect.setParameters(param);
+    EXPECT_TRUE(detect.perform().empty());
+}
+
+TEST_F(PrimitiveDetectionTest, detectSeveralPrimitives)
+{
+    addPlane();
+    addSphere();
+    addCylinder();
+    Reen::PrimitiveDetection detect(kernel, normals);
+    auto primitives = detect.perform();
+    ASSERT_EQ(primitives.size(), 3);
+
+    int planes = 0;
+    for (const auto& it : primitives) {
+        EXPECT_EQ(it.inliers.size(), 900);
+        switch (it.type) {
+            case Reen::PrimitiveDetection::Type::Plane:
+                planes++;
+                break;
+            case Reen::PrimitiveDetection::Type::Sphere:
+                EXPECT_NEAR(it.parameters[3], 2.0, 1e-3);
+                break;
+            case Reen::PrimitiveDetection::Type::Cylinder:
+                EXPECT_NEAR(it.parameters[6], 1.5, 1e-3);
+                break;
+            default:
+                ADD_FAILURE() << "Unexpected primitive type";
+                break;
+        }
+    }
+    EXPECT_EQ(planes, 1);
+}
+
+TEST_F(PrimitiveDetectionTest, maxPrimitives)
+{
+    addPlane();
+    addSphere();
+    Reen::PrimitiveDetection detect(kernel, normals);
+    Reen::PrimitiveDetection::Parameters param;
+    param.maxPrimitives = 1;
+    param.samplingRadius = 1.0;
+    detect.setParameters(param);
+    EXPECT_EQ(detect.perform().size(), 1);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -2,11 +2,16 @@
 
 #include <FCConfig.h>
 
+#include <BRepBuilderAPI_MakeEdge.hxx>
+#include <gp_Pnt.hxx>
+
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/Expression.h>
 #include <App/ObjectIdentifier.h>
+#include <Mod/Part/App/PartFeature.h>
 #include <Mod/Sketcher/App/GeoEnum.h>
+#include <Mod/Sketcher/App/Sketch.h>
 #include <Mod/Sketcher/App/SketchObject.h>
 #include "SketcherTestHelpers.h"
 
@@ -821,6 +826,63 @@ TEST_F(SketchObjectTest, testReverseAngleConstraintToSupplementaryExpressionAppl
     EXPECT_EQ(std::string("32 °"), getObject()->getConstraintExpression(id));
 }
 
+TEST_F(SketchObjectTest, testSetDatumUpdatesSolverInPlace)
+{
+    // Arrange
+    Part::GeomLineSegment lineSeg;
+    lineSeg.setPoints(Base::Vector3d(0.0, 0.0, 0.0), Base::Vector3d(3.0, 1.0, 0.0));
+    int geoId = getObject()->addGeometry(&lineSeg);
+    auto constraint = new Sketcher::Constraint();  // Ownership will be transferred to the sketch
+    constraint->Type = Sketcher::ConstraintType::Distance;
+    constraint->First = geoId;
+    constraint->FirstPos = Sketcher::PointPos::none;
+    constraint->setValue(4.0);
+    int constrId = getObject()->addConstraint(constraint);
+    ASSERT_EQ(getObject()->solve(), 0);
+
+    // Act
+    int err = getObject()->setDatum(constrId, 5.0);
+
+    // Assert
+    EXPECT_EQ(err, 0);
+    auto line = getObject()->getGeometry<Part::GeomLineSegment>(geoId);
+    EXPECT_NEAR((line->getEndPoint() - line->getStartPoint()).Length(), 5.0, 1e-8);
+    // The solved sketch matches the sketch object, so it can be updated without a new set up
+    auto& sketch = const_cast<Sketcher::Sketch&>(getObject()->getSolvedSketch());
+    EXPECT_TRUE(sketch.updateSketch(getObject()->getCompleteGeometry(),
+                                    getObject()->Constraints.getValues(),
+                                    getObject()->getExternalGeometryCount()));
+}
+
+TEST_F(SketchObjectTest, testUpdateSketchRejectsNewConstraints)
+{
+    // Arrange
+    Part::GeomLineSegment lineSeg;
+    lineSeg.setPoints(Base::Vector3d(0.0, 0.0, 0.0), Base::Vector3d(3.0, 1.0, 0.0));
+    int geoId = getObject()->addGeometry(&lineSeg);
+    auto constraint = new Sketcher::Constraint();  // Ownership will be transferred to the sketch
+    constraint->Type = Sketcher::ConstraintType::Distance;
+    constraint->First = geoId;
+    constraint->FirstPos = Sketcher::PointPos::none;
+    constraint->setValue(4.0);
+    getObject()->addConstraint(constraint);
+    ASSERT_EQ(getObject()->solve(), 0);
+    auto& sketch = const_cast<Sketcher::Sketch&>(getObject()->getSolvedSketch());
+    Sketcher::Constraint horizontal;
+    horizontal.Type = Sketcher::ConstraintType::Horizontal;
+    horizontal.First = geoId;
+    std::vector<Sketcher::Constraint*> constraints = getObject()->Constraints.getValues();
+    constraints.push_back(&horizontal);
+
+    // Act
+    bool updated = sketch.updateSketch(getObject()->getCompleteGeometry(),
+                                       constraints,
+                                       getObject()->getExternalGeometryCount());
+
+    // Assert
+    EXPECT_FALSE(updated);
+}
+
 TEST_F(SketchObjectTest, testGetElementName)
 {
     // Arrange
@@ -860,3 +922,29 @@ TEST_F(SketchObjectTest, testGetElementName)
     EXPECT_STREQ(reverse_export_name.newName.c_str(), (";" + tagName + "v1;SKT.Vertex1").c_str());
     EXPECT_STREQ(reverse_export_name.oldName.c_str(), "Vertex1");
 }
+
+TEST_F(SketchObjectTest, testRebuildExternalGeometryFollowsChangedShape)
+{
+    // Arrange
+    auto feature = static_cast<Part::Feature*>(
+        getObject()->getDocument()->addObject("Part::Feature", "Edge"));
+    feature->Shape.setValue(BRepBuilderAPI_MakeEdge(gp_Pnt(0, 0, 1), gp_Pnt(10, 0, 1)).Edge());
+    getObject()->addExternal(feature, "Edge1");
+    getObject()->rebuildExternalGeometry();
+    int count = getObject()->getExternalGeometryCount();
+    // Act
+    getObject()->rebuildExternalGeometry();
+    int countUnchanged = getObject()->getExternalGeometryCount();
+    auto lineUnchanged = getObject()->getGeometry<Part::GeomLineSegment>(GeoEnum::RefExt);
+    ASSERT_NE(lineUnchanged, nullptr);
+    auto startUnchanged = lineUnchanged->getStartPoint();
+    feature->Shape.setValue(BRepBuilderAPI_MakeEdge(gp_Pnt(0, 5, 1), gp_Pnt(10, 5, 1)).Edge());
+    getObject()->rebuildExternalGeometry();
+    auto lineChanged = getObject()->getGeometry<Part::GeomLineSegment>(GeoEnum::RefExt);
+    ASSERT_NE(lineChanged, nullptr);
+    // Assert
+    EXPECT_EQ(countUnchanged, count);
+    EXPECT_EQ(getObject()->getExternalGeometryCount(), count);
+    EXPECT_DOUBLE_EQ(startUnchanged.y, 0.0);
+    EXPECT_DOUBLE_EQ(lineChanged->getStartPoint().y, 5.0);
+}
@@ -1,5 +1,9 @@
 // SPDX-License-Identifier: LGPL-2.1-or-later
 
+#include <cmath>
+#include <limits>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "Mod/Sketcher/App/planegcs/GCS.h"
@@ -11,6 +15,10 @@ public:
     {
         return _getNumberOfConstraints(tagID);
     }
+    bool isDiagnosisReused() const
+    {
+        return _isDiagnosisReused();
+    }
 };
 
 class GCSTest: public ::testing::Test
@@ -50,3 +58,274 @@ TEST_F(GCSTest, clearConstraints)  // NOLINT
     // Assert
     EXPECT_EQ(0, System()->getNumberOfConstraints());
 }
+
+namespace
+{
+
+// Solve a chain of points with distance constraints starting at a fixed point and check the
+// solution
+void solveChain(int sparseJacobianThreshold, GCS::Algorithm alg)
+{
+    const int numPoints {60};
+    std::vector<double> params(2 * numPoints);
+    std::vector<double> distances(numPoints - 1, 2.0);
+    for (int i = 0; i < numPoints; ++i) {
+        params[2 * i] = 1.1 * i;
+        params[2 * i + 1] = 0.1 * (i % 3);
+    }
+    std::vector<GCS::Point> points(numPoints);
+    GCS::VEC_pD unknowns;
+    for (int i = 0; i < numPoints; ++i) {
+        points[i].x = &params[2 * i];
+        points[i].y = &params[2 * i + 1];
+        if (i > 0) {
+            unknowns.push_back(points[i].x);
+            unknowns.push_back(points[i].y);
+        }
+    }
+
+    GCS::System system;
+    system.sparseJacobianThreshold = sparseJacobianThreshold;
+    for (int i = 1; i < numPoints; ++i) {
+        system.addConstraintP2PDistance(points[i - 1], points[i], &distances[i - 1]);
+    }
+    system.declareUnknowns(unknowns);
+    system.initSolution(alg);
+    EXPECT_EQ(system.solve(true, alg), GCS::Success);
+    system.applySolution();
+
+    for (int i = 1; i < numPoints; ++i) {
+        EXPECT_NEAR(std::hypot(params[2 * i] - params[2 * i - 2],
+                               params[2 * i + 1] - params[2 * i - 1]),
+                    2.0,
+                    1e-8);
+    }
+}
+
+}  // namespace
+
+TEST_F(GCSTest, sparseDogLegSolvesChain)  // NOLINT
+{
+    // Arrange, Act and Assert
+    solveChain(0, GCS::DogLeg);
+    solveChain(std::numeric_limits<int>::max(), GCS::DogLeg);
+}
+
+TEST_F(GCSTest, sparseLevenbergMarquardtSolvesChain)  // NOLINT
+{
+    // Arrange, Act and Assert
+    solveChain(0, GCS::LevenbergMarquardt);
+    solveChain(std::numeric_limits<int>::max(), GCS::LevenbergMarquardt);
+}
+
+namespace
+{
+
+// Solve many disconnected pairs of points with a distance constraint and return the solution
+std::vector<double> solveIslands(bool concurrently)
+{
+    const int numIslands {16};
+    std::vector<double> params(4 * numIslands);
+    std::vector<double> distances(numIslands);
+    for (int i = 0; i < numIslands; ++i) {
+        params[4 * i] = 10.0 * i;
+        params[4 * i + 1] = 0.0;
+        params[4 * i + 2] = 10.0 * i + 1.0;
+        params[4 * i + 3] = 0.5;
+        distances[i] = 1.0 + 0.1 * i;
+    }
+    std::vector<GCS::Point> points(2 * numIslands);
+    for (int i = 0; i < 2 * numIslands; ++i) {
+        points[i].x = &params[2 * i];
+        points[i].y = &params[2 * i + 1];
+    }
+    GCS::VEC_pD unknowns;
+    for (auto& param : params) {
+        unknowns.push_back(&param);
+    }
+
+    GCS::System system;
+    system.solveClustersConcurrently = concurrently;
+    for (int i = 0; i < numIslands; ++i) {
+        system.addConstraintP2PDistance(points[2 * i], points[2 * i + 1], &distances[i]);
+    }
+    system.declareUnknowns(unknowns);
+    system.initSolution();
+    EXPECT_EQ(system.solve(), GCS::Success);
+    system.applySolution();
+
+    for (int i = 0; i < numIslands; ++i) {
+        EXPECT_NEAR(std::hypot(params[4 * i + 2] - params[4 * i],
+                               params[4 * i + 3] - params[4 * i + 1]),
+                    distances[i],
+                    1e-8);
+    }
+    return params;
+}
+
+}  // namespace
+
+TEST_F(GCSTest, solveClustersConcurrently)  // NOLINT
+{
+    // Arrange
+    std::vector<double> sequential = solveIslands(false);
+
+    // Act
+    std::vector<double> concurrent = solveIslands(true);
+
+    // Assert
+    ASSERT_EQ(sequential.size(), concurrent.size());
+    for (size_t i = 0; i < sequential.size(); ++i) {
+        EXPECT_DOUBLE_EQ(sequential[i], concurrent[i]);
+    }
+}
+
+TEST_F(GCSTest, diagnosisIsReusedForSameSystem)  // NOLINT
+{
+    // Arrange
+    std::vector<double> params {0.0, 0.0, 3.0, 4.0};
+    double distance1 {5.0};
+    double distance2 {5.0};
+    GCS::Point p1;
+    GCS::Point p2;
+    p1.x = &params[0];
+    p1.y = &params[1];
+    p2.x = &params[2];
+    p2.y = &params[3];
+    GCS::VEC_pD unknowns {&params[0], &params[1], &params[2], &params[3]};
+    auto setUpSystem = [&]() {
+        System()->clear();
+        System()->addConstraintP2PDistance(p1, p2, &distance1, 1);
+        System()->addConstraintP2PDistance(p1, p2, &distance2, 2);
+        System()->declareUnknowns(unknowns);
+        return System()->diagnose();
+    };
+    int dofs = setUpSystem();
+    GCS::VEC_I redundant;
+    GCS::VEC_pD dependent;
+    System()->getRedundant(redundant);
+    System()->getDependentParams(dependent);
+    ASSERT_FALSE(System()->isDiagnosisReused());
+    ASSERT_EQ(redundant, GCS::VEC_I {2});
+
+    // Act
+    int dofsAgain = setUpSystem();
+
+    // Assert
+    GCS::VEC_I redundantAgain;
+    GCS::VEC_pD dependentAgain;
+    System()->getRedundant(redundantAgain);
+    System()->getDependentParams(dependentAgain);
+    EXPECT_TRUE(System()->isDiagnosisReused());
+    EXPECT_EQ(dofsAgain, dofs);
+    EXPECT_EQ(redundantAgain, redundant);
+    EXPECT_EQ(dependentAgain, dependent);
+}
+
+TEST_F(GCSTest, diagnosisIsRepeatedForChangedValue)  // NOLINT
+{
+    // Arrange
+    std::vector<double> params {0.0, 0.0, 3.0, 4.0};
+    double distance1 {5.0};
+    double distance2 {5.0};
+    GCS::Point p1;
+    GCS::Point p2;
+    p1.x = &params[0];
+    p1.y = &params[1];
+    p2.x = &params[2];
+    p2.y = &params[3];
+    GCS::VEC_pD unknowns {&params[0], &params[1], &params[2], &params[3]};
+    auto setUpSystem = [&]() {
+        System()->clear();
+        System()->addConstraintP2PDistance(p1, p2, &distance1, 1);
+        System()->addConstraintP2PDistance(p1, p2, &distance2, 2);
+        System()->declareUnknowns(unknowns);
+        return System()->diagnose();
+    };
+    setUpSystem();
+
+    // Act
+    distance2 = 6.0;
+    setUpSystem();
+
+    // Assert
+    GCS::VEC_I conflicting;
+    GCS::VEC_I redundant;
+    System()->getConflicting(conflicting);
+    System()->getRedundant(redundant);
+    EXPECT_FALSE(System()->isDiagnosisReused());
+    EXPECT_EQ(conflicting, (GCS::VEC_I {1, 2}));
+    EXPECT_TRUE(redundant.empty());
+}
+
+TEST_F(GCSTest, diagnosisIsRepeatedForSameSparsityPattern)  // NOLINT
+{
+    // Arrange
+    // the point is unknown, the two lines are fixed and cross at (1, 1)
+    std::vector<double> params {1.0, 1.0, 0.0, 0.0, 2.0, 2.0, 0.0, 2.0, 2.0, 0.0};
+    GCS::Point p;
+    p.x = &params[0];
+    p.y = &params[1];
+    GCS::Line line1;
+    line1.p1.x = &params[2];
+    line1.p1.y = &params[3];
+    line1.p2.x = &params[4];
+    line1.p2.y = &params[5];
+    GCS::Line line2;
+    line2.p1.x = &params[6];
+    line2.p1.y = &params[7];
+    line2.p2.x = &params[8];
+    line2.p2.y = &params[9];
+    GCS::VEC_pD unknowns {&params[0], &params[1]};
+    auto setUpSystem = [&]() {
+        System()->clear();
+        System()->addConstraintPointOnLine(p, line1, 1);
+        System()->addConstraintPointOnLine(p, line2, 2);
+        System()->declareUnknowns(unknowns);
+        return System()->diagnose();
+    };
+    ASSERT_EQ(setUpSystem(), 0);
+
+    // Act
+    // let the second line coincide with the first one, the Jacobian keeps its sparsity pattern
+    params[6] = 0.0;
+    params[7] = 0.0;
+    params[8] = 2.0;
+    params[9] = 2.0;
+    int dofs = setUpSystem();
+
+    // Assert
+    GCS::VEC_I redundant;
+    System()->getRedundant(redundant);
+    EXPECT_FALSE(System()->isDiagnosisReused());
+    EXPECT_EQ(dofs, 1);
+    EXPECT_EQ(redundant.size(), 1);
+}
+
+TEST_F(GCSTest, iterationsAreCounted)  // NOLINT
+{
+    // Arrange
+    std::vector<double> params {0.0, 0.0, 3.0, 4.0};
+    double distance {6.0};
+    GCS::Point p1;
+    GCS::Point p2;
+    p1.x = &params[0];
+    p1.y = &params[1];
+    p2.x = &params[2];
+    p2.y = &params[3];
+    GCS::VEC_pD unknowns {&params[2], &params[3]};
+    System()->addConstraintP2PDistance(p1, p2, &distance);
+    System()->declareUnknowns(unknowns);
+    System()->initSolution();
+    ASSERT_EQ(System()->getIterationCount(), 0);
+
+    // Act
+    int result = System()->solve();
+    int iterations = System()->getIterationCount();
+    System()->resetIterationCount();
+
+    // Assert
+    EXPECT_EQ(result, GCS::Success);
+    EXPECT_GT(iterations, 0);
+    EXPECT_EQ(System()->getIterationCount(), 0);
+}
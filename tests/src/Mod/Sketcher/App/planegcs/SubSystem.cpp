@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Mod/Sketcher/App/planegcs/SubSystem.h"
+
+class SubSystemTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // two lines, a free point and a few values that are not variables
+        params = {0.1, 0.2, 3.1, 0.4, 0.3, -0.2, 0.5, 2.7, 1.4, 0.9};
+        fixed = {2.0, 0.5, 1.5};
+        for (int i = 0; i < 5; i++) {
+            points[i].x = &params[2 * i];
+            points[i].y = &params[2 * i + 1];
+        }
+        line1.p1 = points[0];
+        line1.p2 = points[1];
+        line2.p1 = points[2];
+        line2.p2 = points[3];
+
+        add(new GCS::ConstraintEqual(&params[0], &params[2], 0.5));
+        add(new GCS::ConstraintDifference(&params[1], &params[3], &fixed[1]));
+        add(new GCS::ConstraintP2PDistance(points[0], points[4], &fixed[0]));
+        add(new GCS::ConstraintPointOnLine(points[4], line2));
+        add(new GCS::ConstraintParallel(line1, line2));
+        add(new GCS::ConstraintPerpendicular(line1, line2));
+        // not evaluated in a batch
+        add(new GCS::ConstraintP2LDistance(points[4], line1, &fixed[2]));
+        // a fixed point
+        GCS::Point fixedPoint;
+        fixedPoint.x = &fixed[0];
+        fixedPoint.y = &fixed[1];
+        add(new GCS::ConstraintP2PDistance(fixedPoint, points[3], &fixed[2]));
+
+        for (auto& param : params) {
+            unknowns.push_back(&param);
+        }
+    }
+
+    void add(GCS::Constraint* constr)
+    {
+        owner.emplace_back(constr);
+        constraints.push_back(constr);
+    }
+
+    std::vector<double> params;
+    std::vector<double> fixed;
+    GCS::Point points[5];
+    GCS::Line line1;
+    GCS::Line line2;
+    GCS::VEC_pD unknowns;
+    std::vector<GCS::Constraint*> constraints;
+    std::vector<std::unique_ptr<GCS::Constraint>> owner;
+};
+
+TEST_F(SubSystemTest, batchedEvaluationMatchesConstraints)  // NOLINT
+{
+    // Arrange
+    GCS::SubSystem subsys(constraints, unknowns);
+    subsys.redirectParams();
+    GCS::VEC_pD plist;
+    GCS::MAP_pD_pD pmap;
+    subsys.getParamList(plist);
+    subsys.getParamMap(pmap);
+    int csize = subsys.cSize();
+    int psize = subsys.pSize();
+
+    // Act
+    Eigen::VectorXd r(csize);
+    double err = 0.;
+    subsys.calcResidual(r, err);
+    Eigen::MatrixXd J;
+    subsys.calcJacobi(J);
+    Eigen::SparseMatrix<double> SJ;
+    subsys.calcJacobi(SJ);
+    Eigen::VectorXd grad(psize);
+    subsys.calcGrad(grad);
+
+    // Assert
+    Eigen::MatrixXd dense(SJ);
+    Eigen::VectorXd expectedGrad = Eigen::VectorXd::Zero(psize);
+    for (int i = 0; i < csize; i++) {
+        double expectedErr = constraints[i]->error();
+        EXPECT_NEAR(r[i], expectedErr, 1e-14);
+        for (int j = 0; j < psize; j++) {
+            double expectedDeriv = constraints[i]->grad(pmap[plist[j]]);
+            EXPECT_NEAR(J(i, j), expectedDeriv, 1e-14);
+            EXPECT_NEAR(dense(i, j), expectedDeriv, 1e-14);
+            expectedGrad[j] += expectedErr * expectedDeriv;
+        }
+    }
+    EXPECT_NEAR(err, 0.5 * r.squaredNorm(), 1e-14);
+    for (int j = 0; j < psize; j++) {
+        EXPECT_NEAR(grad[j], expectedGrad[j], 1e-14);
+    }
+    subsys.revertParams();
+}
+
+TEST_F(SubSystemTest, batchedEvaluationFollowsFixedValues)  // NOLINT
+{
+    // Arrange
+    GCS::SubSystem subsys(constraints, unknowns);
+    subsys.redirectParams();
+    Eigen::VectorXd before(subsys.cSize());
+    subsys.calcResidual(before);
+    subsys.revertParams();
+
+    // Act
+    fixed[0] += 1.0;
+    subsys.redirectParams();
+    Eigen::VectorXd after(subsys.cSize());
+    subsys.calcResidual(after);
+
+    // Assert
+    // the distance of the third constraint is one larger
+    EXPECT_NEAR(after[2], before[2] - constraints[2]->getScale(), 1e-14);
+    EXPECT_NEAR(after[7], constraints[7]->error(), 1e-14);
+    subsys.revertParams();
+}
@@ -0,0 +1,322 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+/* Headless benchmark of the sketch solver
+ *
+ * Sets up, solves, diagnoses and drags every sketch of a corpus and prints the timings and
+ * solver iterations as a table, or as CSV with --csv for comparing releases. The corpus is made
+ * of the sketches of the FreeCAD documents given on the command line, a directory stands for
+ * all the documents it contains. Without arguments the documents of the SketcherCorpus
+ * directory next to the benchmark are used: rectangles, tangent line/arc chains and touching
+ * circles with 10 and 100 elements. Further sketches are added to the corpus by saving them
+ * there.
+ *
+ * Usage: Sketcher_benchmark [options] [document.FCStd | directory]...
+ *   --repeat N        run every measurement N times and report the median (default 3)
+ *   --steps N         number of steps of a drag (default 20)
+ *   --csv             print comma separated values
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Exception.h>
+#include <Mod/Part/App/Geometry.h>
+#include <Mod/Sketcher/App/Constraint.h>
+#include <Mod/Sketcher/App/Sketch.h>
+#include <Mod/Sketcher/App/SketchObject.h>
+#include "src/App/InitApplication.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+struct Options
+{
+    int repeat {3};
+    int steps {20};
+    bool csv {false};
+    std::vector<std::string> files;
+};
+
+struct Measurement
+{
+    double time {0.0};  // milliseconds
+    int iterations {-1};
+    int result {0};
+};
+
+struct SketchData
+{
+    std::string name;
+    std::vector<Part::Geometry*> geometry;
+    std::vector<Sketcher::Constraint*> constraints;
+    int extGeoCount {0};
+};
+
+// ----------------------------------------------------------------------------
+// Measurements
+
+double elapsed(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+// Run a measurement several times and keep the run of median time
+Measurement median(int repeat, const std::function<Measurement()>& measure)
+{
+    std::vector<Measurement> runs;
+    for (int i = 0; i < std::max(1, repeat); ++i) {
+        runs.push_back(measure());
+    }
+    std::sort(runs.begin(), runs.end(), [](const Measurement& a, const Measurement& b) {
+        return a.time < b.time;
+    });
+    return runs[runs.size() / 2];
+}
+
+// Pick an element to drag, the first end point of a curve or the first point
+bool findDragPoint(const SketchData& data, int& geoId, Sketcher::PointPos& pos)
+{
+    int count = static_cast<int>(data.geometry.size()) - data.extGeoCount;
+    for (int i = 0; i < count; ++i) {
+        const Part::Geometry* geo = data.geometry[i];
+        if (geo->is<Part::GeomPoint>()) {
+            pos = Sketcher::PointPos::start;
+        }
+        else if (geo->isDerivedFrom<Part::GeomBoundedCurve>()) {
+            pos = Sketcher::PointPos::end;
+        }
+        else if (geo->isDerivedFrom<Part::GeomConic>()) {
+            pos = Sketcher::PointPos::mid;
+        }
+        else {
+            continue;
+        }
+        geoId = i;
+        return true;
+    }
+    return false;
+}
+
+class Report
+{
+public:
+    explicit Report(bool csv)
+        : csv(csv)
+    {
+        if (csv) {
+            std::cout << "sketch,geometries,constraints,dofs,phase,time_ms,iterations,result\n";
+        }
+        else {
+            std::cout << std::left << std::setw(28) << "sketch" << std::right << std::setw(8)
+                      << "geos" << std::setw(8) << "cstrs" << std::setw(6) << "dofs" << "  "
+                      << std::left << std::setw(10) << "phase" << std::right << std::setw(12)
+                      << "time [ms]" << std::setw(8) << "iters" << std::setw(8) << "result"
+                      << '\n';
+        }
+    }
+
+    void add(const SketchData& data, int dofs, const char* phase, const Measurement& m)
+    {
+        int geos = static_cast<int>(data.geometry.size()) - data.extGeoCount;
+        int cstrs = static_cast<int>(data.constraints.size());
+        std::string iterations = m.iterations < 0 ? "-" : std::to_string(m.iterations);
+        if (csv) {
+            std::cout << data.name << ',' << geos << ',' << cstrs << ',' << dofs << ',' << phase
+                      << ',' << m.time << ',' << iterations << ',' << m.result << '\n';
+        }
+        else {
+            std::cout << std::left << std::setw(28) << data.name << std::right << std::setw(8)
+                      << geos << std::setw(8) << cstrs << std::setw(6) << dofs << "  "
+                      << std::left << std::setw(10) << phase << std::right << std::setw(12)
+                      << std::fixed << std::setprecision(3) << m.time << std::setw(8)
+                      << iterations << std::setw(8) << m.result << '\n';
+        }
+    }
+
+private:
+    bool csv;
+};
+
+void benchmark(const SketchData& data, const Options& options, Report& report)
+{
+    auto setUp = [&data](Sketcher::Sketch& sketch) {
+        // no timing output of the solver
+        sketch.setDebugMode(GCS::NoDebug);
+        return sketch.setUpSketch(data.geometry, data.constraints, data.extGeoCount);
+    };
+
+    int dofs = 0;
+    double diagnoseTime = 0.0;
+    Measurement setup = median(options.repeat, [&]() {
+        Sketcher::Sketch sketch;
+        auto start = std::chrono::steady_clock::now();
+        dofs = setUp(sketch);
+        Measurement m;
+        m.time = elapsed(start);
+        diagnoseTime = sketch.getDiagnoseTime() * 1000.0;
+        return m;
+    });
+    report.add(data, dofs, "setup", setup);
+    Measurement diagnose;
+    diagnose.time = diagnoseTime;
+    report.add(data, dofs, "diagnose", diagnose);
+
+    const std::vector<std::pair<const char*, GCS::Algorithm>> algorithms {
+        {"DogLeg", GCS::DogLeg},
+        {"LM", GCS::LevenbergMarquardt},
+        {"BFGS", GCS::BFGS},
+    };
+    for (const auto& [name, alg] : algorithms) {
+        Measurement solve = median(options.repeat, [&, alg = alg]() {
+            Sketcher::Sketch sketch;
+            sketch.defaultSolver = alg;
+            setUp(sketch);
+            auto start = std::chrono::steady_clock::now();
+            Measurement m;
+            m.result = sketch.solve();
+            m.time = elapsed(start);
+            m.iterations = sketch.getSolveIterations();
+            return m;
+        });
+        report.add(data, dofs, name, solve);
+    }
+
+    // Drag a point in small steps like the mouse does, the time and iterations are per step
+    int geoId = 0;
+    Sketcher::PointPos pos = Sketcher::PointPos::none;
+    if (!findDragPoint(data, geoId, pos) || options.steps <= 0) {
+        return;
+    }
+    Measurement drag = median(options.repeat, [&]() {
+        Sketcher::Sketch sketch;
+        setUp(sketch);
+        sketch.solve();
+        Measurement m;
+        auto start = std::chrono::steady_clock::now();
+        m.result = sketch.initMove(geoId, pos);
+        Base::Vector3d from = sketch.getPoint(geoId, pos);
+        int iterations = 0;
+        for (int step = 1; step <= options.steps; ++step) {
+            Base::Vector3d to = from + Base::Vector3d(0.2 * step, 0.1 * step, 0.0);
+            m.result = std::max(m.result, sketch.moveGeometry(geoId, pos, to));
+            iterations += sketch.getSolveIterations();
+        }
+        sketch.resetInitMove();
+        m.time = elapsed(start) / options.steps;
+        m.iterations = iterations / options.steps;
+        return m;
+    });
+    report.add(data, dofs, "drag", drag);
+}
+
+void benchmark(Sketcher::SketchObject* sketch, const Options& options, Report& report)
+{
+    SketchData data;
+    data.name = std::string(sketch->getDocument()->getName()) + "#" + sketch->getNameInDocument();
+    data.geometry = sketch->getCompleteGeometry();
+    data.constraints = sketch->Constraints.getValues();
+    data.extGeoCount = sketch->getExternalGeometryCount();
+    benchmark(data, options, report);
+}
+
+// Add a document or all the documents of a directory
+void addDocuments(const fs::path& path, std::vector<std::string>& files)
+{
+    if (fs::is_directory(path)) {
+        std::vector<std::string> entries;
+        for (const auto& entry : fs::directory_iterator(path)) {
+            if (entry.path().extension() == ".FCStd") {
+                entries.push_back(entry.path().string());
+            }
+        }
+        std::sort(entries.begin(), entries.end());
+        files.insert(files.end(), entries.begin(), entries.end());
+    }
+    else {
+        files.push_back(path.string());
+    }
+}
+
+bool parseArguments(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> const char* {
+            return i + 1 < argc ? argv[++i] : nullptr;
+        };
+        if (arg == "--csv") {
+            options.csv = true;
+        }
+        else if (arg == "--repeat" || arg == "--steps") {
+            const char* val = value();
+            if (!val) {
+                std::cerr << "Missing value of " << arg << '\n';
+                return false;
+            }
+            if (arg == "--repeat") {
+                options.repeat = std::atoi(val);
+            }
+            else {
+                options.steps = std::atoi(val);
+            }
+        }
+        else if (arg.starts_with("--")) {
+            std::cerr << "Unknown option " << arg << '\n';
+            return false;
+        }
+        else {
+            addDocuments(arg, options.files);
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        return 2;
+    }
+
+    try {
+        tests::initApplication();
+        Report report(options.csv);
+
+        if (options.files.empty()) {
+            addDocuments(fs::path(App::Application::getHomePath()) / "tests" / "SketcherCorpus",
+                         options.files);
+        }
+
+        for (const auto& file : options.files) {
+            auto doc = App::GetApplication().openDocument(file.c_str());
+            if (!doc) {
+                std::cerr << "Failed to open " << file << '\n';
+                continue;
+            }
+            for (auto sketch : doc->getObjectsOfType<Sketcher::SketchObject>()) {
+                benchmark(sketch, options, report);
+            }
+            App::GetApplication().closeDocument(doc->getName());
+        }
+    }
+    catch (const Base::Exception& e) {
+        std::cerr << e.what() << '\n';
+        return 1;
+    }
+
+    return 0;
+}